@@ -0,0 +1,200 @@
+//
+//  NeighborSearchBenchmark.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "coordinate_system/grid.h"
+#include "configuration/Part.h"
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace rbs;
+using namespace rbs::configuration;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using CS = coordinate_system::CoordinateSystem;
+
+/**
+ * @brief The Case denotes a single measurement of the benchmark.
+ */
+struct Case {
+    CS::Type type;          // The type of the local coordinate system of the Parts.
+    size_t pointsSize;      // The requested number of points of each Part.
+    double horizonRatio;    // The search radius over the grid spacing.
+};
+
+/**
+ * @brief Gives the name of a coordinate system type.
+ */
+std::string nameOf(const CS::Type type) {
+    switch (type) {
+    case CS::Cartesian: return "Cartesian";
+    case CS::Cylindrical: return "cylindrical";
+    case CS::Spherical: return "spherical";
+    default: return "custom";
+    }
+}
+
+/**
+ * @brief Gives the peak resident set size of the process in megabytes.
+ */
+double peakMemory() {
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return double(usage.ru_maxrss) / (1024 * 1024);
+#else
+    return double(usage.ru_maxrss) / 1024;
+#endif
+}
+
+/**
+ * @brief Gives the number of seconds passed since a time point.
+ */
+double secondsSince(const Clock::time_point& start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * @brief Meshes the local coordinate system of a Part with a uniform grid in its own coordinates.
+ * @details The Cartesian Parts are cubes, the cylindrical ones are cylinders and the spherical ones are balls. The
+ *          neighbor Part is the same grid placed next to the first one: on top of the cube and the cylinder, and as a
+ *          shell around the ball.
+ * @param part The Part to mesh.
+ * @param pointsSize The approximate number of grid points.
+ * @param isNeighbor Whether the Part is the neighbor Part of the connection search.
+ * @return The grid spacing.
+ */
+double mesh(Part& part, const CS::Type type, const size_t pointsSize, const bool isNeighbor) {
+    using coordinate_system::grid::generators::meshByNumber;
+    auto* axes = part.local().axes();
+    if (type == CS::Spherical) { // {r, azimuthal, polar}; the azimuthal axis has twice the grids.
+        const auto n = std::max(size_t(1), size_t(std::round(std::cbrt(pointsSize / 2.))));
+        const auto spacing = M_PI / n;
+        axes[0] = meshByNumber((isNeighbor) ? (n + 1) * spacing : spacing, spacing, n);
+        axes[1] = meshByNumber(0, spacing, 2 * n);
+        axes[2] = meshByNumber(spacing / 2, spacing, n);
+        return spacing;
+    }
+
+    const auto n = std::max(size_t(1), size_t(std::round(std::cbrt(pointsSize))));
+    if (type == CS::Cylindrical) { // {r, azimuthal, z}
+        const auto spacing = 2 * M_PI / n;
+        axes[0] = meshByNumber(spacing, spacing, n);
+        axes[1] = meshByNumber(0, spacing, n);
+        axes[2] = meshByNumber((isNeighbor) ? n * spacing : 0, spacing, n);
+        return spacing;
+    }
+
+    const auto spacing = 1. / n;
+    axes[0] = meshByNumber(0, spacing, n);
+    axes[1] = meshByNumber(0, spacing, n);
+    axes[2] = meshByNumber((isNeighbor) ? n * spacing : 0, spacing, n);
+    return spacing;
+}
+
+/**
+ * @brief Runs a case and prints its row.
+ */
+void run(const Case& c, const size_t threadsSize) {
+    auto part = Part("Part", CS::Global().appendLocal(c.type));
+    auto neighborPart = Part("Neighbor", CS::Global().appendLocal(c.type));
+    const auto spacing = mesh(part, c.type, c.pointsSize, false);
+    mesh(neighborPart, c.type, c.pointsSize, true);
+    const auto includeAll = [](const auto&) { return true; };
+    part.local().include(includeAll);
+    neighborPart.local().include(includeAll);
+    part.setSearchThreadsSize(threadsSize);
+
+    auto start = Clock::now();
+    const auto pointsSize = part.initiateNeighborhoods();
+    const auto initiateTime = secondsSince(start);
+    neighborPart.initiateNeighborhoods();
+
+    const auto searchRadius = c.horizonRatio * spacing;
+    start = Clock::now();
+    const auto innerBondsSize = part.searchInnerNeighbors(searchRadius);
+    const auto innerTime = secondsSince(start);
+
+    start = Clock::now();
+    const auto connectionBondsSize = part.searchNeighborsWith(neighborPart, searchRadius);
+    const auto connectionTime = secondsSince(start);
+
+    const auto rate = [](const double size, const double time) {
+        return (time > 0) ? size / time : 0.;
+    };
+    std::cout << std::left << std::setw(12) << nameOf(c.type) << std::right
+              << std::setw(10) << pointsSize
+              << std::setw(8) << std::fixed << std::setprecision(3) << c.horizonRatio
+              << std::scientific << std::setprecision(3)
+              << std::setw(12) << rate(pointsSize, initiateTime)
+              << std::setw(12) << rate(pointsSize, innerTime)
+              << std::setw(12) << rate(innerBondsSize, innerTime)
+              << std::setw(12) << rate(pointsSize, connectionTime)
+              << std::setw(12) << rate(connectionBondsSize, connectionTime)
+              << std::fixed << std::setprecision(1) << std::setw(12) << peakMemory() << std::endl;
+}
+
+} // namespace
+
+/**
+ * @brief Measures the setup phase (i.e., Part::initiateNeighborhoods(), Part::searchInnerNeighbors() and
+ *        Part::searchNeighborsWith()) on Cartesian, cylindrical and spherical Parts.
+ * @details Usage: NeighborSearchBenchmark [maximum number of points = 1e6] [number of search threads = 1]
+ *          The number of points goes from 1e4 up to the maximum by factors of ten; each case runs in its own process so
+ *          the peak resident set size is that of the case alone.
+ * @note The curvilinear Parts are meshed uniformly in their own coordinates and searched with the same radius on all
+ *          their axes, as Part::searchInnerNeighbors() does.
+ * @return EXIT_SUCCESS if all cases are done, EXIT_FAILURE otherwise.
+ */
+int main(int argc, char* argv[]) {
+    const auto maxPointsSize = (argc > 1) ? size_t(std::stod(argv[1])) : size_t(1e6);
+    const auto threadsSize = (argc > 2) ? size_t(std::stoul(argv[2])) : size_t(1);
+    report::Logger::centre().setCommandLineLevel(report::Logger::Off);
+
+    std::cout << std::left << std::setw(12) << "system" << std::right
+              << std::setw(10) << "points"
+              << std::setw(8) << "ratio"
+              << std::setw(12) << "init pts/s"
+              << std::setw(12) << "inner pts/s"
+              << std::setw(12) << "inner bnd/s"
+              << std::setw(12) << "conn pts/s"
+              << std::setw(12) << "conn bnd/s"
+              << std::setw(12) << "peak MB" << std::endl;
+
+    auto isSuccessful = true;
+    for (const auto type : {CS::Cartesian, CS::Cylindrical, CS::Spherical}) {
+        for (size_t pointsSize = 10000; pointsSize <= maxPointsSize; pointsSize *= 10) {
+            for (const auto horizonRatio : {3.015, 4.015}) {
+                const auto child = fork();
+                if (child == 0) {
+                    try {
+                        run(Case{type, pointsSize, horizonRatio}, threadsSize);
+                    } catch (const std::exception& exception) {
+                        std::cerr << nameOf(type) << " " << pointsSize << " " << horizonRatio << " failed: " << exception.what() << std::endl;
+                        _exit(EXIT_FAILURE);
+                    }
+                    _exit(EXIT_SUCCESS);
+                }
+
+                int status = 0;
+                if (child < 0 || waitpid(child, &status, 0) < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != EXIT_SUCCESS) {
+                    std::cerr << nameOf(type) << " " << pointsSize << " " << horizonRatio << " did not finish." << std::endl;
+                    isSuccessful = false;
+                }
+            }
+        }
+    }
+    return (isSuccessful) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -1,5 +1,5 @@
 TEMPLATE = app
-CONFIG += console c++17
+CONFIG += console c++17 thread
 CONFIG -= app_bundle
 CONFIG -= qt
 
@@ -13,14 +13,23 @@ CONFIG(debug, debug|release) {
 
 QMAKE_MACOSX_DEPLOYMENT_TARGET = 10.16
 
+# Opt-in (qmake CONFIG+=native): enables the SIMD instruction sets of the build machine (e.g., AVX2 and FMA used by
+# space::VectorBatch); the binary may then not run on other machines.
+native:!win32: QMAKE_CXXFLAGS_RELEASE += -march=native
+
 SOURCES += \
     Analyse.cpp \
     WaveDispersionAndPropagation.cpp \
+    configuration/BondGraph.cpp \
+    configuration/BondStatuses.cpp \
     configuration/Neighborhood.cpp \
     configuration/Node.cpp \
     configuration/Part.cpp \
+    configuration/PropertyTable.cpp \
     coordinate_system/Axis.cpp \
     coordinate_system/CoordinateSystem.cpp \
+    coordinate_system/Occupancy.cpp \
+    coordinate_system/Stencil.cpp \
     coordinate_system/convertors.cpp \
     coordinate_system/grid.cpp \
     exporting/CSVFile.cpp \
@@ -40,10 +49,19 @@ SOURCES += \
     geometry/PointStatus.cpp \
     geometry/Primary.cpp \
     geometry/SetOperation.cpp \
+    parallel/threads.cpp \
     relations/peridynamic/BondBased.cpp \
+    relations/peridynamic/BondGeometry.cpp \
+    relations/peridynamic/BondLanes.cpp \
+    relations/peridynamic/BondPairs.cpp \
     relations/peridynamic/BoundaryDomain.cpp \
+    relations/peridynamic/DamageCounters.cpp \
     relations/peridynamic/Exporter.cpp \
+    relations/peridynamic/FractureEvents.cpp \
+    relations/peridynamic/HorizonBlocks.cpp \
     relations/peridynamic/OrdinaryStateBased.cpp \
+    relations/peridynamic/OrdinaryStateBasedKernel.cpp \
+    relations/peridynamic/ShortRangeContact.cpp \
     relations/peridynamic/time_integrations/PDEuler.cpp \
     relations/peridynamic/time_integrations/PDVelocityVerletAlgorithm.cpp \
     relations/solid/Rotation.cpp \
@@ -52,15 +70,27 @@ SOURCES += \
     report/date_time.cpp \
     report/logging/templates/Standard.cpp \
     report/text_editing.cpp \
+    space/CellList.cpp \
+    space/KDTree.cpp \
+    space/SpaceFillingCurve.cpp \
+    space/VectorBatch.cpp \
+    variables/SimVariant.cpp \
     variables/Variant.cpp
 
 HEADERS += \
     Analyse.h \
+    configuration/BondGraph.h \
+    configuration/BondStatuses.h \
     configuration/Neighborhood.h \
     configuration/Node.h \
     configuration/Part.h \
+    configuration/Pool.h \
+    configuration/PropertyKey.h \
+    configuration/PropertyTable.h \
     coordinate_system/Axis.h \
     coordinate_system/CoordinateSystem.h \
+    coordinate_system/Occupancy.h \
+    coordinate_system/Stencil.h \
     coordinate_system/convertors.h \
     coordinate_system/grid.h \
     exporting/CSV.h \
@@ -87,13 +117,26 @@ HEADERS += \
     geometry/PointStatus.h \
     geometry/Primary.h \
     geometry/SetOperation.h \
+    parallel/threads.h \
     relations/Applicable.h \
     relations/peridynamic.h \
     relations/peridynamic/BondBased.h \
+    relations/peridynamic/BondBasedKernel.h \
+    relations/peridynamic/BondBasedKernelImp.h \
+    relations/peridynamic/BondBasedLaws.h \
+    relations/peridynamic/BondGeometry.h \
+    relations/peridynamic/BondLanes.h \
+    relations/peridynamic/BondPairs.h \
     relations/peridynamic/BoundaryDomain.h \
+    relations/peridynamic/DamageCounters.h \
     relations/peridynamic/Exporter.h \
+    relations/peridynamic/FractureEvents.h \
+    relations/peridynamic/HorizonBlocks.h \
     relations/peridynamic/OrdinaryStateBased.h \
+    relations/peridynamic/OrdinaryStateBasedKernel.h \
     relations/peridynamic/Property.h \
+    relations/peridynamic/PropertyKeys.h \
+    relations/peridynamic/ShortRangeContact.h \
     relations/Relation.h \
     relations/RelationImp.h \
     relations/peridynamic/time_integrations/PDEuler.h \
@@ -106,12 +149,17 @@ HEADERS += \
     report/logging/templates/Interface.h \
     report/logging/templates/Standard.h \
     report/text_editing.h \
+    space/CellList.h \
     space/Index.h \
     space/IndexImp.h \
+    space/KDTree.h \
     space/Point.h \
     space/PointImp.h \
     space/Space.h \
+    space/SpaceFillingCurve.h \
     space/SpaceImp.h \
     space/Vector.h \
+    space/VectorBatch.h \
     space/VectorImp.h \
+    variables/SimVariant.h \
     variables/Variant.h
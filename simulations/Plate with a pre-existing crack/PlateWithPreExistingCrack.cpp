@@ -103,7 +103,7 @@ int main() {
             if (-preCrackLength / 2 < centerPosVec[0] && centerPosVec[0] < preCrackLength / 2
                 && -horizonRadius * 2 < centerPosVec[1] && centerPosVec[1] < horizonRadius * 2) {
                 const auto centerStatus = halfSpace.pointStatus(centerPos);
-                auto& neighbors = neighborhood->neighbors();
+                const auto neighbors = neighborhood->neighbors();
                 std::for_each(neighbors.begin(), neighbors.end(), [&halfSpace, &removedBonds, &neighborhood, centerStatus](const Part::NeighborhoodPtr& neighbor) {
                     using Property = relations::peridynamic::Property;
                     const auto neighborStatus = halfSpace.pointStatus(neighbor->centre()->initialPosition().value<space::Point<3> >());
@@ -117,15 +117,17 @@ int main() {
                 /**
                  * - Alternatively, we can remove the bonds.
                  * - This will be faster, but the pre-crack will not be seen as a damaged area in the exported VTK files.
+                 * - Edit the neighbors through Neighborhood::editNeighbors() and call platePart.updateBonds() afterwards.
                  */
-//                neighbors.erase(
-//                    std::remove_if(neighbors.begin(), neighbors.end(), [&halfSpace, &removedBonds, centerStatus](const Part::NeighborhoodPtr& neighbor) -> bool{
+//                auto& editedNeighbors = neighborhood->editNeighbors();
+//                editedNeighbors.erase(
+//                    std::remove_if(editedNeighbors.begin(), editedNeighbors.end(), [&halfSpace, &removedBonds, centerStatus](const Part::NeighborhoodPtr& neighbor) -> bool{
 //                        const auto neighborStatus = halfSpace.pointStatus(neighbor->centre()->initialPosition().value<space::Point<3> >());
 //                        const bool shouldRemove = neighborStatus != centerStatus || (neighborStatus == centerStatus && neighborStatus == geometry::On);
 //                        if (shouldRemove) { removedBonds++; }
 //                        return shouldRemove;
 //                    }),
-//                    neighbors.end());
+//                    editedNeighbors.end());
             }
         });
 
@@ -169,6 +171,9 @@ int main() {
         return - plateDimension / 4 < posVec[1] && posVec[1] < plateDimension / 4;
     });
 
+    /** - Uncomment the code below to log the broken bonds of each time step to a CSV file. - */
+//    platePDRelation.setFractureEvents(std::make_shared<relations::peridynamic::FractureEvents>(path, "FractureEvents"));
+
     auto timeIntegration = relations::peridynamic::time_integration::Euler(platePart);
 
     using P = relations::peridynamic::Property;
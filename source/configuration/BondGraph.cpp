@@ -0,0 +1,209 @@
+//
+//  BondGraph.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "BondGraph.h"
+#include <atomic>
+#include <numeric>
+
+namespace rbs::configuration {
+
+namespace {
+
+/**
+ * @brief Gives a new graph topology revision.
+ */
+BondGraph::Revision nextRevision() {
+    static std::atomic<BondGraph::Revision> lastRevision{0};
+    return ++lastRevision;
+}
+
+/**
+ * @brief Gives the property table of the neighbors of the neighborhoods or nullptr if there is no neighbor.
+ */
+const PropertyTable* neighborsTable(const BondGraph::Horizons& horizons) {
+    for (const auto& horizon : horizons) {
+        if (!horizon->neighbors().empty())
+            return &horizon->neighbors().front()->centre()->table();
+    }
+    return nullptr;
+}
+
+} // namespace
+
+BondGraph::BondGraph()
+    : p_centres{}
+    , p_neighbors{std::make_shared<Ids>()}
+    , p_neighborsRevision{0}
+    , p_offsets{0}
+    , p_revision{nextRevision()}
+    , p_statuses{std::make_shared<BondStatuses>()}
+    , p_storesNeighbors{false}
+{
+}
+
+BondGraph::BondGraph(const BondGraph::Horizons &horizons)
+    : BondGraph()
+{
+    assign(horizons);
+}
+
+BondGraph::BondIndex BondGraph::begin(const size_t row) const {
+    return p_offsets[row];
+}
+
+size_t BondGraph::bondsSize() const {
+    return p_neighbors->size();
+}
+
+BondGraph::Id BondGraph::centre(const size_t row) const {
+    return p_centres[row];
+}
+
+const BondGraph::Ids &BondGraph::centres() const {
+    return p_centres;
+}
+
+BondGraph::BondIndex BondGraph::end(const size_t row) const {
+    return p_offsets[row + 1];
+}
+
+bool BondGraph::matches(const BondGraph::Horizons &horizons) const {
+    if (horizons.size() != size())
+        return false;
+    for (size_t row = 0; row < horizons.size(); row++) {
+        const auto& horizon = *horizons[row];
+        if (horizon.centre()->id() != centre(row))
+            return false;
+        if (p_storesNeighbors) {
+            if (horizon.neighborIds() != p_neighbors || horizon.firstBond() != begin(row) || horizon.bondsSize() != end(row) - begin(row))
+                return false;
+        } else if (horizon.neighbors().size() != end(row) - begin(row)) {
+            return false;
+        }
+    }
+    const auto table = neighborsTable(horizons);
+    return !table || table->revision() == p_neighborsRevision;
+}
+
+BondGraph::Id BondGraph::neighbor(const BondGraph::BondIndex bond) const {
+    return (*p_neighbors)[bond];
+}
+
+const BondGraph::Ids &BondGraph::neighbors() const {
+    return *p_neighbors;
+}
+
+const BondGraph::Offsets &BondGraph::offsets() const {
+    return p_offsets;
+}
+
+BondGraph::Revision BondGraph::revision() const {
+    return p_revision;
+}
+
+size_t BondGraph::size() const {
+    return p_centres.size();
+}
+
+const BondStatuses &BondGraph::statuses() const {
+    return *p_statuses;
+}
+
+bool BondGraph::storesNeighbors() const {
+    return p_storesNeighbors;
+}
+
+void BondGraph::assign(const BondGraph::Horizons &horizons, const BondGraph::NeighborTablePtr &neighborTable) {
+    const auto oldStatuses = p_statuses;
+    const auto oldNeighborsRevision = p_neighborsRevision;
+    const auto oldNeighborsPtr = p_neighbors; // still presented by the neighborhoods stored on it, until they are attached again.
+    const auto& oldNeighbors = *oldNeighborsPtr;
+    clear();
+
+    const auto table = neighborsTable(horizons);
+    p_neighborsRevision = (table) ? table->revision() : 0;
+    const auto renumbered = table && oldNeighborsRevision && p_neighborsRevision != oldNeighborsRevision;
+
+    p_centres.reserve(horizons.size());
+    p_offsets.reserve(horizons.size() + 1);
+    const auto bondsSize = std::accumulate(horizons.begin(), horizons.end(), size_t(0), [](const size_t sum, const auto& horizon) {
+        return sum + horizon->size();
+    });
+    auto& neighbors = *p_neighbors;
+    neighbors.reserve(bondsSize);
+
+    auto storesNeighbors = neighborTable != nullptr;
+    std::for_each(horizons.begin(), horizons.end(), [&](const auto& horizon) {
+        p_centres.emplace_back(horizon->centre()->id());
+        for (const auto& neighbor : horizon->neighbors()) {
+            const auto id = neighbor->centre()->id();
+            storesNeighbors = storesNeighbors && id < neighborTable->size() && (*neighborTable)[id] == neighbor;
+            neighbors.emplace_back(id);
+        }
+        p_offsets.emplace_back(neighbors.size());
+    });
+    p_storesNeighbors = storesNeighbors;
+
+    p_statuses = std::make_shared<BondStatuses>(neighbors.size());
+    for (size_t row = 0; row < horizons.size(); row++) {
+        const auto& horizon = horizons[row];
+        const auto& previous = horizon->bondStatuses();
+        const auto oldBegin = horizon->firstBond();
+        const auto oldEnd = oldBegin + horizon->bondsSize();
+        if (previous == oldStatuses && !renumbered) { // matching the bonds by their neighbor id (the order of the kept bonds does not change).
+            auto cursor = oldBegin;
+            for (auto bond = begin(row); bond < end(row) && oldBegin < oldEnd; bond++) {
+                auto search = cursor;
+                while (search < oldEnd && oldNeighbors[search] != neighbors[bond])
+                    search++;
+                if (search == oldEnd) {
+                    search = oldBegin;
+                    while (search < cursor && oldNeighbors[search] != neighbors[bond])
+                        search++;
+                    if (search == cursor)
+                        continue;
+                }
+                p_statuses->copy(*previous, search, bond);
+                cursor = search + 1;
+            }
+        } else if (previous) { // matching the bonds by their position (the old neighbor ids are stale if renumbered).
+            for (auto bond = begin(row); bond < end(row) && oldBegin + bond - begin(row) < oldEnd; bond++)
+                p_statuses->copy(*previous, oldBegin + bond - begin(row), bond);
+        }
+        if (p_storesNeighbors)
+            horizon->attach(p_statuses, begin(row), p_neighbors, neighborTable);
+        else
+            horizon->attach(p_statuses, begin(row));
+    }
+}
+
+void BondGraph::clear() {
+    p_centres.clear();
+    p_neighbors = std::make_shared<Ids>();
+    p_neighborsRevision = 0;
+    p_offsets.assign(1, 0);
+    p_revision = nextRevision();
+    p_statuses = std::make_shared<BondStatuses>();
+    p_storesNeighbors = false;
+}
+
+void BondGraph::renumber(const BondGraph::Ids &ids, const PropertyTable &table) {
+    const auto replace = [&ids](Id& id) {
+        id = ids.at(id);
+    };
+    std::for_each(p_centres.begin(), p_centres.end(), replace);
+    std::for_each(p_neighbors->begin(), p_neighbors->end(), replace); // also renumbers the neighbors presented by the neighborhoods.
+    p_neighborsRevision = table.revision();
+    p_revision = nextRevision();
+}
+
+BondStatuses &BondGraph::statuses() {
+    return *p_statuses;
+}
+
+} // namespace rbs::configuration
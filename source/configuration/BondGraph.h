@@ -0,0 +1,173 @@
+//
+//  BondGraph.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDGRAPH_H
+#define BONDGRAPH_H
+
+#include "Neighborhood.h"
+#include <vector>
+
+/**
+ * The configuration namespace provides the means to create configurations and use them.
+ */
+namespace rbs::configuration {
+
+/**
+ * @brief The BondGraph stores the bonds of a set of neighborhoods in compressed sparse row (CSR) format.
+ * @details Each row of the graph belongs to a neighborhood (in the same order as the neighborhoods it is built from)
+ *          and stores the id of the neighborhood centre. The bonds of a row are the range [begin(row), end(row)) of the
+ *          neighbors array, each holding the id of the neighbor centre (i.e., its row on the neighbor Part property table).
+ * @note The bonds of each row are in the same order as the neighbors of its neighborhood.
+ * @note The graph also owns the statuses of its bonds, and attaches the neighborhoods to it; thus, the bond statuses
+ *          can be accessed both through the neighborhoods and through the bond indices.
+ * @note Given the neighbor table (i.e., the neighborhoods by their centre id, see assign()), the graph is the storage of
+ *          the bonds: the neighborhoods release their neighbor pointers and present the neighbor ids of the graph
+ *          through the table (see Neighborhood::neighbors()). Thus, a bond costs a single id instead of a shared
+ *          pointer. Otherwise (e.g., for the connections with other Parts, which may renumber their nodes on their own),
+ *          the graph is only an index next to the neighbors of the neighborhoods.
+ */
+class BondGraph
+{
+public:
+    using BondIndex = size_t;
+    using Id = Node::Id;
+    using Ids = std::vector<Id>;
+    using Horizons = std::vector<std::shared_ptr<Neighborhood> >;
+    using IdsPtr = std::shared_ptr<Ids>;
+    using NeighborTablePtr = Neighborhood::NeighborTablePtr;
+    using Offsets = std::vector<BondIndex>;
+    using Revision = size_t;
+    using StatusesPtr = std::shared_ptr<BondStatuses>;
+
+    /**
+     * @brief The constructor.
+     */
+    BondGraph();
+
+    /**
+     * @brief The constructor.
+     * @param horizons The neighborhoods to build the graph from.
+     */
+    explicit BondGraph(const Horizons& horizons);
+
+    /**
+     * @brief Gives the index of the first bond of a row.
+     */
+    BondIndex begin(const size_t row) const;
+
+    /**
+     * @brief Gives the number of bonds.
+     */
+    size_t bondsSize() const;
+
+    /**
+     * @brief Gives the id of the centre of a row.
+     */
+    Id centre(const size_t row) const;
+
+    /**
+     * @brief Gives the id of the centres of all the rows.
+     */
+    const Ids& centres() const;
+
+    /**
+     * @brief Gives the index after the last bond of a row.
+     */
+    BondIndex end(const size_t row) const;
+
+    /**
+     * @brief Whether the graph still presents the given neighborhoods.
+     * @note Only the number of rows, the centre id and the number of bonds of each row, and the revision of the neighbors
+     *       property table (see PropertyTable::revision()) are compared; thus, reordering the neighborhoods or the rows of
+     *       the neighbor Part is detected, while replacing a neighbor with another one is not, unless the graph stores
+     *       the neighbors (see storesNeighbors()); then, every neighborhood must still present the neighbors of its row.
+     */
+    bool matches(const Horizons& horizons) const;
+
+    /**
+     * @brief Gives the id of the neighbor centre of a bond.
+     */
+    Id neighbor(const BondIndex bond) const;
+
+    /**
+     * @brief Gives the id of the neighbor centres of all the bonds.
+     */
+    const Ids& neighbors() const;
+
+    /**
+     * @brief Gives the row offsets (i.e., the index of the first bond of each row plus the number of bonds at the end).
+     */
+    const Offsets& offsets() const;
+
+    /**
+     * @brief Gives the revision of the graph topology.
+     * @details Each time a graph is built or cleared it gets a new revision, unique among all the graphs; thus, the
+     *          data computed per bond can be kept as long as the revision of its graph does not change.
+     */
+    Revision revision() const;
+
+    /**
+     * @brief Gives the number of rows.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gives the statuses of the bonds.
+     */
+    const BondStatuses& statuses() const;
+
+    /**
+     * @brief Whether the neighborhoods present the neighbors stored on the graph (see assign()).
+     */
+    bool storesNeighbors() const;
+
+    /**
+     * @brief Builds the graph from the neighborhoods and attaches them to the new bond statuses.
+     * @note The existing bond statuses of the neighborhoods will be kept. If the neighborhood was attached to this graph
+     *          and the rows of the neighbors property table are not permuted since, the bonds will be matched by their
+     *          neighbor id; otherwise, by their position.
+     * @note If the neighbor table is given and holds every neighbor at its centre id, the graph stores the neighbors
+     *          (see Neighborhood::attach()); otherwise, the neighborhoods keep them.
+     * @param horizons The neighborhoods to build the graph from.
+     * @param neighborTable The neighborhoods by their centre id (or nullptr).
+     */
+    void assign(const Horizons& horizons, const NeighborTablePtr& neighborTable = nullptr);
+
+    /**
+     * @brief Removes all the rows.
+     * @note The neighborhoods storing their neighbors on the graph keep them.
+     */
+    void clear();
+
+    /**
+     * @brief Replaces the centre and neighbor ids of the bonds (e.g., after the rows of the property table are permuted).
+     * @note The statuses are kept; thus, the next assign() can still match the bonds by their neighbor id.
+     * @param ids The new id of each old id.
+     * @param table The property table of the neighbors, after its rows are permuted.
+     * @throws If any of the ids is not inside the given ids.
+     */
+    void renumber(const Ids& ids, const PropertyTable& table);
+
+    /**
+     * @brief Gives direct access to the statuses of the bonds.
+     */
+    BondStatuses& statuses();
+
+private:
+    Ids p_centres;                                  // The centre id of each row.
+    IdsPtr p_neighbors;                             // The neighbor centre id of each bond (shared with the neighborhoods it stores).
+    PropertyTable::Revision p_neighborsRevision;    // The revision of the neighbors property table the ids are taken at.
+    Offsets p_offsets;                              // The index of the first bond of each row.
+    Revision p_revision;                            // The revision of the topology.
+    StatusesPtr p_statuses;                         // The statuses of the bonds.
+    bool p_storesNeighbors;                         // Whether the neighborhoods present the neighbor ids.
+};
+
+} // namespace rbs::configuration
+
+#endif // BONDGRAPH_H
@@ -0,0 +1,210 @@
+//
+//  BondStatuses.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "BondStatuses.h"
+#include <bitset>
+
+namespace rbs::configuration {
+
+BondStatuses::Flags::Flags(const size_t size)
+    : p_revision{0}
+    , p_size{size}
+    , p_words((size + WordSize - 1) / WordSize, 0)
+{
+}
+
+BondStatuses::Flags::Flags(const BondStatuses::Flags &other)
+    : p_revision{other.revision()}
+    , p_size{other.p_size}
+    , p_words{other.p_words}
+{
+}
+
+BondStatuses::Flags &BondStatuses::Flags::operator=(const BondStatuses::Flags &other) {
+    p_revision = other.revision();
+    p_size = other.p_size;
+    p_words = other.p_words;
+    return *this;
+}
+
+
+size_t BondStatuses::Flags::count(const BondStatuses::BondIndex begin, const BondStatuses::BondIndex end) const {
+    if (end <= begin)
+        return 0;
+
+    const auto firstWord = begin / WordSize;
+    const auto lastWord = (end - 1) / WordSize;
+    const auto mask = [](const size_t from, const size_t to) -> Word { // bits [from, to) of a word
+        const auto upper = (to == WordSize) ? ~Word(0) : (Word(1) << to) - 1;
+        return upper & ~((Word(1) << from) - 1);
+    };
+
+    if (firstWord == lastWord)
+        return std::bitset<WordSize>(p_words[firstWord] & mask(begin % WordSize, (end - 1) % WordSize + 1)).count();
+
+    size_t ans = std::bitset<WordSize>(p_words[firstWord] & mask(begin % WordSize, WordSize)).count();
+    for (auto word = firstWord + 1; word < lastWord; word++)
+        ans += std::bitset<WordSize>(p_words[word]).count();
+    return ans + std::bitset<WordSize>(p_words[lastWord] & mask(0, (end - 1) % WordSize + 1)).count();
+}
+
+size_t BondStatuses::Flags::revision() const {
+    return p_revision.load(std::memory_order_relaxed);
+}
+
+size_t BondStatuses::Flags::size() const {
+    return p_size;
+}
+
+bool BondStatuses::Flags::test(const BondStatuses::BondIndex bond) const {
+    return bond < p_size && (p_words[bond / WordSize] >> (bond % WordSize)) & 1;
+}
+
+void BondStatuses::Flags::reset(const BondStatuses::BondIndex bond) {
+    if (test(bond)) {
+        p_words[bond / WordSize] &= ~(Word(1) << (bond % WordSize));
+        p_revision.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void BondStatuses::Flags::resize(const size_t size) {
+    if (size < p_size)
+        p_revision.fetch_add(count(size, p_size), std::memory_order_relaxed);
+    if (size < p_size && size % WordSize)
+        p_words[size / WordSize] &= (Word(1) << (size % WordSize)) - 1;
+    p_size = size;
+    p_words.resize((size + WordSize - 1) / WordSize, 0);
+}
+
+void BondStatuses::Flags::set(const BondStatuses::BondIndex bond) {
+    if (bond >= p_size)
+        throw std::out_of_range("The bond index " + std::to_string(bond) + " is out of range.");
+    if (!test(bond)) {
+        p_words[bond / WordSize] |= Word(1) << (bond % WordSize);
+        p_revision.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+BondStatuses::BondStatuses(const size_t size)
+    : p_channels{}
+    , p_size{size}
+    , p_statuses{}
+{
+}
+
+BondStatuses::BondStatuses(const BondStatuses &other)
+    : p_channels{}
+    , p_size{other.p_size}
+    , p_statuses{other.p_statuses}
+{
+    std::for_each(other.p_channels.begin(), other.p_channels.end(), [this](const auto& pair) {
+        p_channels[pair.first] = pair.second->clone();
+    });
+}
+
+void BondStatuses::activate(const BondStatuses::StatusIndex index, const BondStatuses::Status &common) {
+    if (index < 0)
+        throw std::out_of_range("The bond status index cannot be negative.");
+
+    if (size_t(index) >= p_statuses.size())
+        p_statuses.resize(index + 1);
+
+    auto& statuses = p_statuses[index];
+    if (!statuses.active) {
+        statuses.active = true;
+        statuses.common = common;
+        statuses.flags.resize(p_size);
+    }
+}
+
+const BondStatuses::Status &BondStatuses::at(const BondStatuses::BondIndex bond, const BondStatuses::StatusIndex index) const {
+    if (!has(bond, index))
+        throw std::out_of_range("The bond has no status at " + std::to_string(index) + ".");
+
+    const auto& statuses = p_statuses[index];
+    const auto item = statuses.values.find(bond);
+    if (item != statuses.values.end())
+        return item->second;
+    return statuses.common;
+}
+
+const BondStatuses::Flags *BondStatuses::flags(const BondStatuses::StatusIndex index) const {
+    if (0 <= index && size_t(index) < p_statuses.size() && p_statuses[index].active)
+        return &p_statuses[index].flags;
+    return nullptr;
+}
+
+bool BondStatuses::has(const BondStatuses::BondIndex bond, const BondStatuses::StatusIndex index) const {
+    const auto ans = flags(index);
+    return ans && ans->test(bond);
+}
+
+size_t BondStatuses::size() const {
+    return p_size;
+}
+
+void BondStatuses::copy(const BondStatuses &other, const BondStatuses::BondIndex from, const BondStatuses::BondIndex to) {
+    for (StatusIndex index = 0; size_t(index) < other.p_statuses.size(); index++) {
+        if (other.has(from, index))
+            set(to, index, other.at(from, index));
+        else
+            erase(to, index);
+    }
+
+    std::for_each(other.p_channels.begin(), other.p_channels.end(), [&](const auto& pair) {
+        auto& channel = p_channels[pair.first];
+        if (!channel)
+            channel = pair.second->create(p_size);
+        channel->copy(*pair.second, from, to);
+    });
+}
+
+void BondStatuses::erase(const BondStatuses::BondIndex bond, const BondStatuses::StatusIndex index) {
+    if (has(bond, index)) {
+        auto& statuses = p_statuses[index];
+        if (statuses.values.count(bond)) {
+            if (statuses.concurrent)
+                throw std::runtime_error("The bond status " + std::to_string(index) + " is set on multiple threads; only its common value can be erased.");
+            statuses.values.erase(bond);
+        }
+        statuses.flags.reset(bond);
+    }
+}
+
+void BondStatuses::set(const BondStatuses::BondIndex bond, const BondStatuses::StatusIndex index, const BondStatuses::Status &status) {
+    if (index < 0)
+        throw std::out_of_range("The bond status index cannot be negative.");
+    if (bond >= p_size)
+        throw std::out_of_range("The bond index " + std::to_string(bond) + " is out of range.");
+
+    activate(index, status);
+    auto& statuses = p_statuses[index];
+    if (statuses.concurrent) { // the values are only read; thus, the threads only write to the bits.
+        if (!(status == statuses.common) || statuses.values.count(bond))
+            throw std::runtime_error("The bond status " + std::to_string(index) + " is set on multiple threads; only its common value can be set.");
+        statuses.flags.set(bond);
+        return;
+    }
+
+    statuses.flags.set(bond);
+    if (status == statuses.common)
+        statuses.values.erase(bond);
+    else
+        statuses.values[bond] = status;
+}
+
+void BondStatuses::setConcurrent(const BondStatuses::StatusIndex index, const bool concurrent) {
+    if (!flags(index)) {
+        if (concurrent)
+            throw std::runtime_error("The bond status " + std::to_string(index) + " must be activated before being set on multiple threads.");
+        return;
+    }
+    p_statuses[index].concurrent = concurrent;
+}
+
+} // namespace rbs::configuration
@@ -0,0 +1,283 @@
+//
+//  BondStatuses.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDSTATUSES_H
+#define BONDSTATUSES_H
+
+#include "../variables/SimVariant.h"
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The configuration namespace provides the means to create configurations and use them.
+ */
+namespace rbs::configuration {
+
+/**
+ * @brief The BondStatuses stores the statuses of a list of bonds, addressed by the bond index.
+ * @details Each status index has,
+ *          - a packed bitset denoting whether the bonds have the status (e.g., whether the bond is broken),
+ *          - the status values, where only the values that are different from the common value of the index (i.e., the
+ *            first set value, see activate()) are stored.
+ *          Moreover, any status index can have a typed channel storing one value per bond (e.g., float stretch history).
+ * @note The status indices are used directly as positions; thus, they should be small and non-negative (e.g., an enum).
+ */
+class BondStatuses
+{
+public:
+    using BondIndex = size_t;
+    using Status = variables::SimVariant;
+    using StatusIndex = int;
+
+    /**
+     * @brief The Flags is a packed bitset storing one bit per bond.
+     * @details The bits count their changes (see revision()); thus, a change of the bits made anywhere is detected by
+     *          comparing the revision with the expected one, without reading the bits.
+     */
+    class Flags {
+    public:
+        using Word = std::uint64_t;
+
+        /**
+         * @brief The number of bits (i.e., bonds) sharing a word.
+         * @note The words are set without atomics; thus, the threads setting the bits must split them on the words.
+         */
+        static constexpr size_t WordSize = sizeof(Word) * 8;
+
+        /**
+         * @brief The constructor.
+         * @param size The number of bonds.
+         */
+        explicit Flags(const size_t size = 0);
+
+        /**
+         * @brief The copy constructor.
+         */
+        Flags(const Flags& other);
+
+        /**
+         * @brief The copy assignment.
+         */
+        Flags& operator=(const Flags& other);
+
+        /**
+         * @brief Counts the set bits in the range of [begin, end).
+         */
+        size_t count(const BondIndex begin, const BondIndex end) const;
+
+        /**
+         * @brief Gives the number of the changes of the bits (i.e., the bits set while clear and reset while set).
+         * @note The revision of a new bitset is zero and the copies keep the revision of their source.
+         */
+        size_t revision() const;
+
+        /**
+         * @brief Gives the number of bits.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Whether the bit of a bond is set.
+         */
+        bool test(const BondIndex bond) const;
+
+        /**
+         * @brief Clears the bit of a bond.
+         */
+        void reset(const BondIndex bond);
+
+        /**
+         * @brief Resizes the bitset; the new bits will be cleared.
+         */
+        void resize(const size_t size);
+
+        /**
+         * @brief Sets the bit of a bond.
+         * @note The bits of the same word must not be set or reset on multiple threads at the same time.
+         */
+        void set(const BondIndex bond);
+
+    private:
+        std::atomic<size_t> p_revision; // The number of the changes of the bits; the threads may set different words.
+        size_t p_size;                  // The number of bits.
+        std::vector<Word> p_words;      // The packed bits.
+    };
+
+    /**
+     * @brief The constructor.
+     * @param size The number of bonds.
+     */
+    explicit BondStatuses(const size_t size = 0);
+
+    /**
+     * @brief The copy constructor.
+     */
+    BondStatuses(const BondStatuses& other);
+
+    /**
+     * @brief Activates a status index, so that its bitset is allocated before any bond has the status.
+     * @note Does nothing if the index is already active; otherwise, the given value becomes the common value of the index.
+     * @param index The status index.
+     * @param common The common value of the index (e.g., int(1) for the Damage).
+     * @throws If the status index is negative.
+     */
+    void activate(const StatusIndex index, const Status& common);
+
+    /**
+     * @brief Gives the status of a bond.
+     * @throws If the bond has no status at the index.
+     */
+    const Status& at(const BondIndex bond, const StatusIndex index) const;
+
+    /**
+     * @brief Gives the typed channel of a status index.
+     * @return The channel values (one per bond) or nullptr if the channel does not exist.
+     * @throws If the channel exists with a different type.
+     */
+    template<typename T>
+    const std::vector<T>* channel(const StatusIndex index) const {
+        const auto item = p_channels.find(index);
+        if (item == p_channels.end())
+            return nullptr;
+        return &cast<T>(*item->second).values;
+    }
+
+    /**
+     * @brief Gives the bitset of a status index.
+     * @return The bitset or nullptr if no bond has ever had the status.
+     */
+    const Flags* flags(const StatusIndex index) const;
+
+    /**
+     * @brief Whether the bond has status at the given index.
+     */
+    bool has(const BondIndex bond, const StatusIndex index) const;
+
+    /**
+     * @brief Gives the number of bonds.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gives direct access to the typed channel of a status index.
+     * @note Creates the channel with default values if it does not exist.
+     * @throws If the channel exists with a different type.
+     */
+    template<typename T>
+    std::vector<T>& channel(const StatusIndex index) {
+        auto& item = p_channels[index];
+        if (!item)
+            item = std::make_unique<Channel<T> >(p_size);
+        return cast<T>(*item).values;
+    }
+
+    /**
+     * @brief Copies the statuses and the channel values of a bond from other bond statuses.
+     * @param other The source bond statuses.
+     * @param from The bond index on the source.
+     * @param to The bond index on this.
+     */
+    void copy(const BondStatuses& other, const BondIndex from, const BondIndex to);
+
+    /**
+     * @brief Erases the status of a bond.
+     * @throws If the index is concurrent (see setConcurrent()) and the status of the bond is not the common value.
+     */
+    void erase(const BondIndex bond, const StatusIndex index);
+
+    /**
+     * @brief Sets the status of a bond.
+     * @note While the index is concurrent (see setConcurrent()), only the bit of the bond is written.
+     * @throws If the status index is negative or if the bond is out of range.
+     * @throws If the index is concurrent and either the status or the current status of the bond is not the common value.
+     */
+    void set(const BondIndex bond, const StatusIndex index, const Status& status);
+
+    /**
+     * @brief Defines whether the bonds of a status index are set and erased on multiple threads at the same time.
+     * @details The concurrent indices only accept their common value (see activate()) and only write to the bits of the
+     *          bonds; thus, the threads setting the bonds of different words of the bitset do not race (see Flags).
+     * @note The other status indices must not be set or erased on multiple threads.
+     * @throws If the index is to be concurrent and is not active.
+     */
+    void setConcurrent(const StatusIndex index, const bool concurrent);
+
+private:
+
+    /**
+     * @brief The base of the typed channels.
+     */
+    struct ChannelBase {
+        virtual ~ChannelBase() = default;
+        virtual std::unique_ptr<ChannelBase> clone() const = 0;
+        virtual std::unique_ptr<ChannelBase> create(const size_t size) const = 0;
+        virtual void copy(const ChannelBase& other, const BondIndex from, const BondIndex to) = 0;
+    };
+
+    /**
+     * @brief The typed channel.
+     */
+    template<typename T>
+    struct Channel : ChannelBase {
+        explicit Channel(const size_t size) : values(size) {}
+        std::unique_ptr<ChannelBase> clone() const override { return std::make_unique<Channel>(*this); }
+        std::unique_ptr<ChannelBase> create(const size_t size) const override { return std::make_unique<Channel>(size); }
+        void copy(const ChannelBase& other, const BondIndex from, const BondIndex to) override {
+            values[to] = static_cast<const Channel&>(other).values[from];
+        }
+        std::vector<T> values;
+    };
+
+    /**
+     * @brief Casts a channel to its type.
+     * @throws If the channel has a different type.
+     */
+    template<typename T>
+    static const Channel<T>& cast(const ChannelBase& channel) {
+        if (const auto ans = dynamic_cast<const Channel<T>*>(&channel))
+            return *ans;
+        throw std::runtime_error("The bond status channel has a different type.");
+    }
+
+    /**
+     * @brief Casts a channel to its type.
+     * @throws If the channel has a different type.
+     */
+    template<typename T>
+    static Channel<T>& cast(ChannelBase& channel) {
+        if (const auto ans = dynamic_cast<Channel<T>*>(&channel))
+            return *ans;
+        throw std::runtime_error("The bond status channel has a different type.");
+    }
+
+    using Channels = std::map<StatusIndex, std::unique_ptr<ChannelBase> >;
+    using Values = std::unordered_map<BondIndex, Status>;
+
+    /**
+     * @brief The statuses of one index.
+     */
+    struct Statuses {
+        bool active = false;        // Whether any bond has ever had the status.
+        bool concurrent = false;    // Whether the bonds are set on multiple threads (see setConcurrent()).
+        Flags flags;                // Whether the bonds have the status.
+        Status common;              // The common status value of the index.
+        Values values;              // The status values that differ from the common value.
+    };
+
+    Channels p_channels;                // The typed channels.
+    size_t p_size;                      // The number of bonds.
+    std::vector<Statuses> p_statuses;   // The statuses indexed by the status index.
+};
+
+} // namespace rbs::configuration
+
+#endif // BONDSTATUSES_H
@@ -10,21 +10,75 @@
 
 namespace rbs::configuration {
 
+Neighborhood::NeighborsView::NeighborsView(const Neighborhood::Neighbors &neighbors)
+    : p_ids{ nullptr }
+    , p_idsOwner{ nullptr }
+    , p_neighbors{ neighbors.data() }
+    , p_size{ neighbors.size() }
+    , p_table{ nullptr }
+{
+}
+
+Neighborhood::NeighborsView::NeighborsView(const Neighborhood::IdsPtr &ids, const size_t first, const size_t size, const Neighborhood::NeighborTablePtr &table)
+    : p_ids{ ids->data() + first }
+    , p_idsOwner{ ids }
+    , p_neighbors{ nullptr }
+    , p_size{ size }
+    , p_table{ table }
+{
+}
+
+Neighborhood::NeighborsView::Iterator Neighborhood::NeighborsView::begin() const {
+    return Iterator(p_ids, p_table.get(), p_neighbors, 0);
+}
+
+bool Neighborhood::NeighborsView::empty() const {
+    return p_size == 0;
+}
+
+Neighborhood::NeighborsView::Iterator Neighborhood::NeighborsView::end() const {
+    return Iterator(p_ids, p_table.get(), p_neighbors, p_size);
+}
+
+const Neighborhood::NeighborPtr &Neighborhood::NeighborsView::front() const {
+    return (*this)[0];
+}
+
+size_t Neighborhood::NeighborsView::size() const {
+    return p_size;
+}
+
 Neighborhood::Neighborhood(const Node &centre)
-    : p_centre{ std::make_shared<Node>(centre) }
+    : p_bondStatuses{ nullptr }
+    , p_bondsSize{ 0 }
+    , p_centre{ std::make_shared<Node>(centre) }
+    , p_firstBond{ 0 }
+    , p_neighborIds{ nullptr }
+    , p_neighborTable{}
     , p_neighbors{}
 {
 }
 
 Neighborhood::Neighborhood(const Neighborhood::NodePtr &centre)
-    : p_centre{ centre }
+    : p_bondStatuses{ nullptr }
+    , p_bondsSize{ 0 }
+    , p_centre{ centre }
+    , p_firstBond{ 0 }
+    , p_neighborIds{ nullptr }
+    , p_neighborTable{}
     , p_neighbors{}
 {
 }
 
 Neighborhood::Neighborhood(const Neighborhood &&other) {
+    p_bondStatuses = std::move(other.p_bondStatuses);
+    p_bondsSize = other.p_bondsSize;
     p_centre = std::move(other.p_centre);
+    p_firstBond = other.p_firstBond;
+    p_neighborIds = std::move(other.p_neighborIds);
+    p_neighborTable = std::move(other.p_neighborTable);
     p_neighbors = std::move(other.p_neighbors);
+    p_statuses = std::move(other.p_statuses);
 }
 
 Neighborhood &Neighborhood::operator =(Neighborhood other) {
@@ -32,15 +86,33 @@ Neighborhood &Neighborhood::operator =(Neighborhood other) {
     return *this;
 }
 
+const Neighborhood::BondStatusesPtr &Neighborhood::bondStatuses() const {
+    return p_bondStatuses;
+}
+
+size_t Neighborhood::bondsSize() const {
+    return p_bondsSize;
+}
+
 const Neighborhood::NodePtr &Neighborhood::centre() const {
     return p_centre;
 }
 
+Neighborhood::BondIndex Neighborhood::firstBond() const {
+    return p_firstBond;
+}
+
 bool Neighborhood::hasNeighbors() const {
-    return !p_neighbors.empty();
+    return size() != 0;
 }
 
 bool Neighborhood::hasStatus(const Neighborhood::NeighborPtr &neighbor, const Neighborhood::StatusIndex index) const {
+    if (p_bondStatuses) {
+        const auto neighborPosition = position(neighbor);
+        if (neighborPosition < p_bondsSize)
+            return p_bondStatuses->has(p_firstBond + neighborPosition, index);
+    }
+
     if (p_statuses.size() != 0) {
         const auto search = p_statuses.find(neighbor.get());
         if (search != p_statuses.end()) {
@@ -49,28 +121,36 @@ bool Neighborhood::hasStatus(const Neighborhood::NeighborPtr &neighbor, const Ne
                 return true;
             }
         }
-        return false;
-    }
-
-    const auto search = p_statuses.find(neighbor.get());
-    if (search != p_statuses.end()) {
-        const auto statusPair = search->second.find(index);
-        if (statusPair != search->second.end()) {
-            return true;
-        }
     }
     return false;
 }
 
-const Neighborhood::Neighbors &Neighborhood::neighbors() const {
-    return p_neighbors;
+const Neighborhood::IdsPtr &Neighborhood::neighborIds() const {
+    return p_neighborIds;
+}
+
+Neighborhood::NeighborsView Neighborhood::neighbors() const {
+    if (!p_neighborIds)
+        return NeighborsView(p_neighbors);
+    if (const auto table = p_neighborTable.lock())
+        return NeighborsView(p_neighborIds, p_firstBond, p_bondsSize, table);
+    return NeighborsView(p_neighbors); // The Part of the neighbors no longer exists.
 }
 
 size_t Neighborhood::size() const {
-    return p_neighbors.size();
+    return neighbors().size();
 }
 
 const Neighborhood::Status &Neighborhood::status(const Neighborhood::NeighborPtr &neighbor, const Neighborhood::StatusIndex index) const {
+    if (p_bondStatuses) {
+        const auto neighborPosition = position(neighbor);
+        if (neighborPosition < p_bondsSize) {
+            if (!p_bondStatuses->has(p_firstBond + neighborPosition, index))
+                throw std::out_of_range("The neighbor has no status at " + std::to_string(index) + ".");
+            return p_bondStatuses->at(p_firstBond + neighborPosition, index);
+        }
+    }
+
     const auto search = p_statuses.find(neighbor.get());
     if (search != p_statuses.end()) {
         const auto statusPair = search->second.find(index);
@@ -83,15 +163,58 @@ const Neighborhood::Status &Neighborhood::status(const Neighborhood::NeighborPtr
     throw std::out_of_range("Neighbor's status not found!");
 }
 
+void Neighborhood::attach(const Neighborhood::BondStatusesPtr &statuses, const Neighborhood::BondIndex firstBond,
+                          const Neighborhood::IdsPtr &neighborIds, const Neighborhood::NeighborTablePtr &neighborTable) {
+    if (!neighborIds || !statuses)
+        storeNeighbors();
+
+    const auto neighbors = this->neighbors();
+    p_bondStatuses = statuses;
+    p_bondsSize = (statuses) ? neighbors.size() : 0;
+    p_firstBond = firstBond;
+
+    if (p_bondStatuses) {
+        for (auto itr = p_statuses.begin(); itr != p_statuses.end();) {
+            const auto neighbor = std::find_if(neighbors.begin(), neighbors.end(), [&itr](const NeighborPtr& neighbor) {
+                return neighbor.get() == itr->first;
+            });
+            if (neighbor != neighbors.end()) {
+                const auto bond = p_firstBond + std::distance(neighbors.begin(), neighbor);
+                std::for_each(itr->second.begin(), itr->second.end(), [this, bond](const auto& statusPair) {
+                    p_bondStatuses->set(bond, statusPair.first, statusPair.second);
+                });
+                itr = p_statuses.erase(itr);
+            } else {
+                itr++;
+            }
+        }
+    }
+
+    if (neighborIds && p_bondStatuses) {
+        p_neighborIds = neighborIds;
+        p_neighborTable = neighborTable;
+        Neighbors().swap(p_neighbors);
+    }
+}
+
 Neighborhood::NodePtr &Neighborhood::centre() {
     return p_centre;
 }
 
-Neighborhood::Neighbors &Neighborhood::neighbors() {
+Neighborhood::Neighbors &Neighborhood::editNeighbors() {
+    storeNeighbors();
     return p_neighbors;
 }
 
 void Neighborhood::setStatus(const Neighborhood::NeighborPtr &neighbor, const Neighborhood::StatusIndex index, const Neighborhood::Status &status) {
+    if (p_bondStatuses) {
+        const auto neighborPosition = position(neighbor);
+        if (neighborPosition < p_bondsSize) {
+            p_bondStatuses->set(p_firstBond + neighborPosition, index, status);
+            return;
+        }
+    }
+
     const auto search = p_statuses.find(neighbor.get());
     if (search != p_statuses.end()) {
         const auto statusPair = search->second.find(index);
@@ -106,8 +229,45 @@ void Neighborhood::setStatus(const Neighborhood::NeighborPtr &neighbor, const Ne
 }
 
 void Neighborhood::swap(Neighborhood &other) {
+    std::swap(p_bondStatuses, other.p_bondStatuses);
+    std::swap(p_bondsSize, other.p_bondsSize);
     std::swap(p_centre, other.p_centre);
+    std::swap(p_firstBond, other.p_firstBond);
+    std::swap(p_neighborIds, other.p_neighborIds);
+    std::swap(p_neighborTable, other.p_neighborTable);
     p_neighbors.swap(other.p_neighbors);
+    p_statuses.swap(other.p_statuses);
+}
+
+size_t Neighborhood::position(const Neighborhood::NeighborPtr &neighbor) const {
+    if (p_neighborIds) {
+        const auto table = p_neighborTable.lock();
+        const auto id = neighbor->centre()->id();
+        if (!table || id >= table->size() || (*table)[id] != neighbor)
+            return p_bondsSize;
+
+        const auto begin = p_neighborIds->begin() + p_firstBond;
+        return std::distance(begin, std::find(begin, begin + p_bondsSize, id));
+    }
+
+    const auto begin = p_neighbors.data();
+    const auto end = begin + p_neighbors.size();
+    const auto less = std::less<const NeighborPtr*>();
+    if (!less(&neighbor, begin) && less(&neighbor, end))
+        return &neighbor - begin;
+
+    const auto item = std::find(p_neighbors.begin(), p_neighbors.end(), neighbor);
+    return std::distance(p_neighbors.begin(), item);
+}
+
+void Neighborhood::storeNeighbors() {
+    if (!p_neighborIds)
+        return;
+
+    const auto neighbors = this->neighbors();
+    p_neighbors.assign(neighbors.begin(), neighbors.end());
+    p_neighborIds = nullptr;
+    p_neighborTable.reset();
 }
 
 } // namespace rbs::configuration
@@ -9,8 +9,11 @@
 #ifndef NEIGHBORHOOD_H
 #define NEIGHBORHOOD_H
 
+#include "BondStatuses.h"
 #include "Node.h"
 #include "../variables/Variant.h"
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <map>
 #include <vector>
@@ -26,6 +29,9 @@ namespace rbs::configuration {
  *          where the constitutive model defines the relation between them.
  * @note Depending on the constitutive model, Neighborhood may require storing different properties along with the neighbors.
  * @note If you need to introduce new form of neighborhood, use this class as a public base class and then implement the required properties.
+ * @note Once attached to a BondStatuses (i.e., by the BondGraph of its Part), the bond statuses are stored there, addressed by the neighbor position.
+ * @note The BondGraph of the inner bonds of a Part also stores the neighbors, as the ids of their centres (see attach());
+ *          the neighborhood then presents them through the neighborhoods of the Part, by their centre id.
  * @warning Avoid using this class directly in your simulation. For each supported constitutive model, there should be subclass of this class.
  */
 class Neighborhood
@@ -36,8 +42,148 @@ public:
     using NeighborPtr       = std::shared_ptr<Neighborhood>;
     using Neighbors         = std::vector<NeighborPtr>;
 
-    using Status            = variables::Variant;
-    using StatusIndex       = int;
+    using BondIndex         = BondStatuses::BondIndex;
+    using BondStatusesPtr   = std::shared_ptr<BondStatuses>;
+    using Status            = BondStatuses::Status;
+    using StatusIndex       = BondStatuses::StatusIndex;
+
+    using Id                = Node::Id;
+    using Ids               = std::vector<Id>;
+    using IdsPtr            = std::shared_ptr<const Ids>;
+    using NeighborTable     = std::vector<NeighborPtr>;
+    using NeighborTablePtr  = std::shared_ptr<const NeighborTable>;
+
+    /**
+     * @brief The NeighborsView presents the neighbors of a neighborhood, whether the neighborhood stores them or the
+     *          BondGraph it is attached to (see attach()).
+     * @details The view of the neighbors stored on a BondGraph shares the ownership of their ids and of the neighbor
+     *          table; each neighbor is given as a reference to its item on the neighbor table.
+     * @warning The view does not follow the changes of the neighbors (i.e., take a new one after modifying them).
+     */
+    class NeighborsView {
+    public:
+
+        /**
+         * @brief The Iterator walks the neighbors of a view.
+         * @details The iterator refers to the storage of the neighbors (i.e., the ids and the neighbor table, or the
+         *          neighbors of the neighborhood) rather than to the view; thus, it stays valid after the view is gone,
+         *          as long as the neighbors are neither modified nor released.
+         */
+        class Iterator {
+        public:
+            using difference_type   = std::ptrdiff_t;
+            using iterator_category = std::random_access_iterator_tag;
+            using pointer           = const NeighborPtr*;
+            using reference         = const NeighborPtr&;
+            using value_type        = NeighborPtr;
+
+            Iterator() = default;
+
+            Iterator(const Id* ids, const NeighborTable* table, const NeighborPtr* neighbors, const size_t position)
+                : p_ids{ids}
+                , p_neighbors{neighbors}
+                , p_position{position}
+                , p_table{table}
+            {
+            }
+
+            reference operator *() const { return at(p_position); }
+            pointer operator ->() const { return &at(p_position); }
+            reference operator [](const difference_type offset) const { return at(p_position + offset); }
+
+            Iterator& operator ++() { p_position++; return *this; }
+            Iterator operator ++(int) { auto ans = *this; p_position++; return ans; }
+            Iterator& operator --() { p_position--; return *this; }
+            Iterator operator --(int) { auto ans = *this; p_position--; return ans; }
+            Iterator& operator +=(const difference_type offset) { p_position += offset; return *this; }
+            Iterator& operator -=(const difference_type offset) { p_position -= offset; return *this; }
+            Iterator operator +(const difference_type offset) const { return Iterator(p_ids, p_table, p_neighbors, p_position + offset); }
+            Iterator operator -(const difference_type offset) const { return Iterator(p_ids, p_table, p_neighbors, p_position - offset); }
+            difference_type operator -(const Iterator& other) const { return difference_type(p_position) - difference_type(other.p_position); }
+
+            bool operator ==(const Iterator& other) const { return isOnStorageOf(other) && p_position == other.p_position; }
+            bool operator !=(const Iterator& other) const { return !(*this == other); }
+            bool operator <(const Iterator& other) const { return p_position < other.p_position; }
+            bool operator >(const Iterator& other) const { return p_position > other.p_position; }
+            bool operator <=(const Iterator& other) const { return p_position <= other.p_position; }
+            bool operator >=(const Iterator& other) const { return p_position >= other.p_position; }
+
+        private:
+
+            /**
+             * @brief Gives the neighbor at a position.
+             */
+            reference at(const size_t position) const {
+                return (p_ids) ? (*p_table)[p_ids[position]] : p_neighbors[position];
+            }
+
+            /**
+             * @brief Whether the other iterator walks the same neighbors.
+             */
+            bool isOnStorageOf(const Iterator& other) const {
+                return p_ids == other.p_ids && p_neighbors == other.p_neighbors && p_table == other.p_table;
+            }
+
+            const Id* p_ids = nullptr;                  // The neighbor ids stored on the BondGraph (nullptr for the neighborhood neighbors).
+            const NeighborPtr* p_neighbors = nullptr;   // The neighbors stored on the neighborhood.
+            size_t p_position = 0;                      // The position of the neighbor.
+            const NeighborTable* p_table = nullptr;     // The neighborhoods by their centre id.
+        };
+
+        /**
+         * @brief The constructor.
+         * @param neighbors The neighbors stored on the neighborhood.
+         */
+        explicit NeighborsView(const Neighbors& neighbors);
+
+        /**
+         * @brief The constructor.
+         * @param ids The neighbor ids stored on the BondGraph.
+         * @param first The position of the first neighbor id.
+         * @param size The number of neighbors.
+         * @param table The neighborhoods by their centre id.
+         */
+        NeighborsView(const IdsPtr& ids, const size_t first, const size_t size, const NeighborTablePtr& table);
+
+        /**
+         * @brief Gives the neighbor at a position.
+         */
+        const NeighborPtr& operator [](const size_t position) const {
+            return (p_ids) ? (*p_table)[p_ids[position]] : p_neighbors[position];
+        }
+
+        /**
+         * @brief Gives the iterator to the first neighbor.
+         */
+        Iterator begin() const;
+
+        /**
+         * @brief Whether there is no neighbor.
+         */
+        bool empty() const;
+
+        /**
+         * @brief Gives the iterator after the last neighbor.
+         */
+        Iterator end() const;
+
+        /**
+         * @brief Gives the first neighbor.
+         */
+        const NeighborPtr& front() const;
+
+        /**
+         * @brief Gives the number of neighbors.
+         */
+        size_t size() const;
+
+    private:
+        const Id* p_ids;                // The neighbor ids stored on the BondGraph (nullptr for the neighborhood neighbors).
+        IdsPtr p_idsOwner;              // The owner of the neighbor ids.
+        const NeighborPtr* p_neighbors; // The neighbors stored on the neighborhood.
+        size_t p_size;                  // The number of neighbors.
+        NeighborTablePtr p_table;       // The neighborhoods by their centre id.
+    };
 
     /**
      * @brief The constructor.
@@ -68,11 +214,27 @@ public:
      */
     Neighborhood &operator =(Neighborhood other);
 
+    /**
+     * @brief Gives the bond statuses that the neighborhood is attached to.
+     * @return The bond statuses or nullptr if the neighborhood is not attached.
+     */
+    const BondStatusesPtr& bondStatuses() const;
+
+    /**
+     * @brief Gives the number of neighbors that their bond statuses are stored on the attached bond statuses.
+     */
+    size_t bondsSize() const;
+
     /**
      * @brief Gives the centre of neighborhood.
      */
     const NodePtr& centre() const;
 
+    /**
+     * @brief Gives the index of the first neighbor bond on the attached bond statuses.
+     */
+    BondIndex firstBond() const;
+
     /**
      * @brief Whether the neighborhood includes any neighbors or not.
      */
@@ -83,10 +245,18 @@ public:
      */
     bool hasStatus(const NeighborPtr& neighbor, const StatusIndex index) const;
 
+    /**
+     * @brief Gives the ids of the neighbors stored on the BondGraph the neighborhood is attached to.
+     * @return The neighbor ids of all the bonds of the graph (see firstBond() and bondsSize()) or nullptr if the
+     *          neighborhood stores its neighbors.
+     */
+    const IdsPtr& neighborIds() const;
+
     /**
      * @brief Gives the neighbors of the neighborhood at once.
+     * @note The neighbors stored on a BondGraph are only presented as long as the neighbor table (i.e., their Part) exists.
      */
-    const Neighbors& neighbors() const;
+    NeighborsView neighbors() const;
 
     /**
      * @brief Gives the size of neighborhood.
@@ -102,15 +272,32 @@ public:
      */
     const Status& status(const NeighborPtr& neighbor, const StatusIndex index) const;
 
+    /**
+     * @brief Attaches the neighborhood to a bond statuses.
+     * @details The statuses of the neighbor at position i will be stored at firstBond + i.
+     * @note The statuses that are stored inside the neighborhood will be moved to the bond statuses,
+     *          the statuses stored on a previously attached bond statuses will not be copied.
+     * @note If the neighbor ids are given, the neighborhood releases its neighbors and presents the ones of the ids
+     *          instead; otherwise, it stores its neighbors (copying them back from the previous neighbor ids, if any).
+     * @param statuses The bond statuses.
+     * @param firstBond The bond index of the first neighbor.
+     * @param neighborIds The neighbor ids, from firstBond on, matching the neighbors (or nullptr).
+     * @param neighborTable The neighborhoods by their centre id (needed with the neighbor ids).
+     */
+    void attach(const BondStatusesPtr& statuses, const BondIndex firstBond,
+                const IdsPtr& neighborIds = nullptr, const NeighborTablePtr& neighborTable = nullptr);
+
     /**
      * @brief Gives the centre of neighborhood.
      */
     NodePtr& centre();
 
     /**
-     * @brief Gives the neighbors of the neighborhood at once.
+     * @brief Gives direct access to the neighbors of the neighborhood.
+     * @note The neighbors stored on a BondGraph are copied into the neighborhood first; thus, the graph will no longer
+     *          match the neighborhood (see BondGraph::matches()) until it is rebuilt (e.g., by Part::updateBonds()).
      */
-    Neighbors& neighbors();
+    Neighbors& editNeighbors();
 
     /**
      * @brief Set the neighbor (i.e., bond) status.
@@ -131,9 +318,26 @@ private:
      */
     void swap(Neighborhood & other);
 
-    NodePtr p_centre;       // The centre point.
-    Neighbors p_neighbors;  // The neighbors.
-    Statuses p_statuses;    // The neighbors' statuses.
+    /**
+     * @brief Gives the position of a neighbor inside the neighbors.
+     * @note If the neighbor is a reference to an item of the neighbors, its position will be found without searching.
+     * @return The position of the neighbor or the size of neighbors if not found.
+     */
+    size_t position(const NeighborPtr& neighbor) const;
+
+    /**
+     * @brief Copies the neighbors stored on the BondGraph into the neighborhood.
+     */
+    void storeNeighbors();
+
+    BondStatusesPtr p_bondStatuses; // The attached bond statuses.
+    size_t p_bondsSize;             // The number of neighbors stored on the attached bond statuses.
+    NodePtr p_centre;               // The centre point.
+    BondIndex p_firstBond;          // The bond index of the first neighbor on the attached bond statuses.
+    IdsPtr p_neighborIds;           // The neighbor ids stored on the attached BondGraph (nullptr if stored in p_neighbors).
+    std::weak_ptr<const NeighborTable> p_neighborTable; // The neighborhoods the neighbor ids refer to.
+    Neighbors p_neighbors;          // The neighbors (when not stored on the BondGraph).
+    Statuses p_statuses;            // The neighbors' statuses (when the neighborhood or the neighbor is not attached).
 
 };
 
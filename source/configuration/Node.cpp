@@ -10,17 +10,31 @@
 
 namespace rbs::configuration {
 
-Node::Node(const space::Point<3> &initialPosition) {
-    p_initialPosition = std::make_shared<Property>(initialPosition);
+Node::Node(const space::Point<3> &initialPosition)
+    : p_table{std::make_shared<PropertyTable>()}
+    , p_id{0}
+{
+    p_id = p_table->append(Position(initialPosition));
+}
+
+Node::Node(const Node::Index initialIndex)
+    : p_table{std::make_shared<PropertyTable>()}
+    , p_id{0}
+{
+    p_id = p_table->append(Position(initialIndex));
 }
 
-Node::Node(const Node::Index initialIndex) {
-    p_initialPosition = std::make_shared<Property>(initialIndex);
+Node::Node(const Node::TablePtr &table, const Node::Id id)
+    : p_table{table}
+    , p_id{id}
+{
+    if (!p_table || p_id >= p_table->size())
+        throw std::out_of_range("The property table has no row " + std::to_string(id) + ".");
 }
 
 Node::Node(Node &&node) {
-    p_initialPosition = std::move(node.p_initialPosition);
-    p_properties = std::move(node.p_properties);
+    p_table = std::move(node.p_table);
+    p_id = node.p_id;
 }
 
 Node &Node::operator =(Node other) {
@@ -30,79 +44,72 @@ Node &Node::operator =(Node other) {
 
 Node::~Node() = default;
 
-const Node::Property &Node::at(const Node::Index index) const {
-    const auto item = p_properties.find(index);
-    if (item != p_properties.end())
-        return *item->second;
-    throw std::runtime_error("The is no property set at index: " + std::to_string(index) + ".");
+Node::Property Node::at(const Node::Index index) const {
+    return p_table->at(p_id, index);
 }
 
 bool Node::has(const Node::Index index) const {
-    return p_properties.find(index) != p_properties.end();
+    return p_table->has(p_id, index);
 }
 
-const Node::Property &Node::initialPosition() const {
-    return *p_initialPosition;
+Node::Id Node::id() const {
+    return p_id;
 }
 
-const Node::PropertyPtr &Node::reference(const Node::Index index) const {
-    const auto item = p_properties.find(index);
-    if (item != p_properties.end())
-        return item->second;
-    throw std::runtime_error("The is no property set at index: " + std::to_string(index) + ".");
+const Node::Position &Node::initialPosition() const {
+    return p_table->initialPosition(p_id);
 }
 
-Node::Property &Node::at(const Node::Index index) {
-    const auto item = p_properties.find(index);
-    if (item != p_properties.end())
-        return *item->second;
-    p_properties[index] = std::make_shared<Property>();
-    return *p_properties[index];
+const PropertyTable &Node::table() const {
+    return *p_table;
+}
+
+Node::PropertyReference Node::at(const Node::Index index) {
+    return p_table->at(p_id, index);
 }
 
 void Node::dereferencelizeInitialPosition() {
-    if (!p_initialPosition)
+    if (!p_table)
         throw std::runtime_error("The Node has no initial position.");
-    p_initialPosition = std::make_shared<Property>(*p_initialPosition);
+    detach();
 }
 
 void Node::dereferencelizeProperties() {
-    std::for_each(p_properties.begin(), p_properties.end(), [this](auto& pair) {
-        if (!p_initialPosition)
-            throw std::runtime_error("The Node property is missing.");
-        pair.second = std::make_shared<Property>(*pair.second);
-    });
+    if (!p_table)
+        throw std::runtime_error("The Node property is missing.");
+    detach();
 }
 
 void Node::dereferencelizePropertyAt(const Node::Index index) {
-    if (index < p_properties.size())
-        p_properties[index] = std::make_shared<Property>(*p_properties[index]);
-    throw std::out_of_range("The Node has no property at index " + std::to_string(index) + ".");
+    if (!has(index))
+        throw std::out_of_range("The Node has no property at index " + std::to_string(index) + ".");
+    detach();
 }
 
 void Node::erase(const Node::Index index) {
-    p_properties.erase(index);
-}
-
-Node::PropertyPtr &Node::reference(const Node::Index index) {
-    const auto item = p_properties.find(index);
-    if (item != p_properties.end())
-        return item->second;
-    p_properties[index] = std::make_shared<Property>();
-    return p_properties[index];
+    p_table->erase(p_id, index);
 }
 
-const Node::Property &Node::operator [](const Node::Index index) const {
+Node::Property Node::operator [](const Node::Index index) const {
     return at(index);
 }
 
-Node::Property &Node::operator [](const Node::Index index) {
+Node::PropertyReference Node::operator [](const Node::Index index) {
     return at(index);
 }
 
 void Node::swap(Node &other) {
-    std::swap(p_initialPosition, other.p_initialPosition);
-    p_properties.swap(other.p_properties);
+    std::swap(p_table, other.p_table);
+    std::swap(p_id, other.p_id);
+}
+
+void Node::detach() {
+    auto table = std::make_shared<PropertyTable>();
+    const auto id = table->append(p_table->initialPosition(p_id));
+    for (const auto index : p_table->indices(p_id))
+        table->at(id, index) = p_table->at(p_id, index);
+    p_table = table;
+    p_id = id;
 }
 
 std::ostream &operator <<(std::ostream &out, const Node &node)
@@ -113,17 +120,18 @@ std::ostream &operator <<(std::ostream &out, const Node &node)
 configuration::Node::operator std::string() const {
     std::string ans = "Node:{";
 
-    if (!p_properties.empty())
+    const auto indices = p_table->indices(p_id);
+    if (!indices.empty())
         ans = ans + "\n  ";
-    ans = ans + "initial_position: " + std::string(*p_initialPosition);
+    ans = ans + "initial_position: " + std::string(initialPosition());
 
     size_t itr = 0;
-    for(const auto& property: p_properties) {
+    for(const auto index: indices) {
         if (!itr) {
             ans = ans + ",\n  property list:{ \n";
-            ans = ans +    "    [" + std::to_string(property.first) + "] => " + ((property.second)? std::string(*property.second): "nullptr");
+            ans = ans +    "    [" + std::to_string(index) + "] => " + std::string(at(index));
         } else {
-            ans = ans + ",\n    [" + std::to_string(property.first) + "] => " + ((property.second)? std::string(*property.second): "nullptr");
+            ans = ans + ",\n    [" + std::to_string(index) + "] => " + std::string(at(index));
         }
         itr++;
     }
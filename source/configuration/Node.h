@@ -9,8 +9,7 @@
 #ifndef NODE_H
 #define NODE_H
 
-#include "../variables/Variant.h"
-#include <map>
+#include "PropertyTable.h"
 #include <memory>
 
 /**
@@ -22,29 +21,42 @@ namespace rbs::configuration {
  * @brief Each node presents part of the configuration's discretized body in the simulation.
  * @note Depending on the constitutive model, Nodes require storing different properties of the subdomain that they are representing.
  * @note This class only provides storage that is capable of storing various types.
+ * @note The properties are stored at a row of a PropertyTable; a Node is merely a view to its row.
  * @note If you need to introduce new type of Node, use this class as a protected base class and then implement the required properties.
  * @warning Avoid using this class directly in your simulation. For each supported constitutive model, there should be subclass of this class.
  */
 class Node
 {
 public:
-    using Index = size_t;
-    using Property = variables::Variant;
-    using PropertyPtr = std::shared_ptr<Property>;
-    using PropertyMap = std::map<Index, PropertyPtr>;
+    using Id = PropertyTable::Id;
+    using Index = PropertyTable::Index;
+    using Position = PropertyTable::Position;
+    using Property = PropertyTable::Property;
+    using PropertyReference = PropertyTable::Reference;
+    using TablePtr = std::shared_ptr<PropertyTable>;
 
     /**
      * @brief The constructor.
+     * @note The node will own a PropertyTable with a single row.
      * @param the initialPosition of the node.
      */
     explicit Node(const space::Point<3>& initialPosition);
 
     /**
      * @brief The constructor.
+     * @note The node will own a PropertyTable with a single row.
      * @param initialIndex The index of the initial position.
      */
     explicit Node(const Index initialIndex);
 
+    /**
+     * @brief The constructor.
+     * @param table The property table that stores the node properties.
+     * @param id The row of the node in the property table.
+     * @throws If the table has no row with the given id.
+     */
+    explicit Node(const TablePtr& table, const Id id);
+
     /**
      * @brief The default copy constructor.
      */
@@ -71,48 +83,60 @@ public:
      * @brief Gives the property at a specific index.
      * @throws If there is no property stored at the index.
      */
-    const Property& at(const Index index) const;
+    Property at(const Index index) const;
 
     /**
      * @brief Whether the node contains property at a specific index.
      */
     bool has(const Index index) const;
 
+    /**
+     * @brief Gives the id of the node (i.e., its row in the property table).
+     */
+    Id id() const;
+
     /**
      * @brief Gives the initial postition of the node.
      */
-    const Property& initialPosition() const;
+    const Position& initialPosition() const;
 
     /**
-     * @brief Gives a shared pointer to property at a specific index.
-     * @throws If there is no property stored at the index.
+     * @brief Gives the property table that stores the node properties.
      */
-    const PropertyPtr& reference(const Index index) const;
+    const PropertyTable& table() const;
 
     /**
      * @brief Gives direct access to the property at a specific index.
+     * @note The property is accessed through a reference to its PropertyTable column (see PropertyTable::Reference).
      */
-    Property& at(const Index index);
+    PropertyReference at(const Index index);
 
     /**
      * @brief Dereferencelizes the initial position.
-     * @details The nodes are pointing to their properties; thus, all the copied nodes will share the same properties.
-     * @note This will create a new initial position for the node, but the properties will stay untouched.
+     * @details The nodes are pointing to their property table row; thus, all the copied nodes will share the same properties.
+     * @note The initial position and the properties are stored on the same row; thus, this will move the node to a new
+     *          PropertyTable holding copies of both of them.
+     * @warning The Nodes held by the neighborhoods of a Part must not be dereferencelized; they would leave the Part
+     *          property table (see Part::properties()) and the relations would no longer see their properties. Only
+     *          dereferencelize the copies of them.
      */
     void dereferencelizeInitialPosition();
 
     /**
      * @brief Dereferencelizes all the properties.
-     * @details The nodes are pointing to their properties; thus, all the copied nodes will share the same properties.
-     * @note This will create a new properties for this node, but the initial postition will stay untouched.
+     * @details The nodes are pointing to their property table row; thus, all the copied nodes will share the same properties.
+     * @note This will move the node to a new PropertyTable holding copies of its initial position and properties.
+     * @warning Only dereferencelize the copies of the Part nodes (see dereferencelizeInitialPosition()).
      */
     void dereferencelizeProperties();
 
     /**
      * @brief Dereferencelizes a property at a specific index.
-     * @details The nodes are pointing to their properties; thus, all the copied nodes will share the same properties.
-     * @note This will create a new property for this node, but all the other properties and initial position will stay untouched.
+     * @details The nodes are pointing to their property table row; thus, all the copied nodes will share the same properties.
+     * @note This will move the node to a new PropertyTable holding copies of its initial position and properties.
+     * @warning Only dereferencelize the copies of the Part nodes (see dereferencelizeInitialPosition()).
      * @param index The index of the property.
+     * @throws If there is no property stored at the index.
      */
     void dereferencelizePropertyAt(const Index index);
 
@@ -121,21 +145,16 @@ public:
      */
     void erase(const Index index);
 
-    /**
-     * @brief Gives a shared pointer to property at a specific index.
-     */
-    PropertyPtr& reference(const Index index);
-
     /**
      * @brief Gives the property at a specific index.
      * @throws If there is no property stored at the index.
      */
-    const Property& operator [](const Index index) const;
+    Property operator [](const Index index) const;
 
     /**
      * @brief Gives direct access to the property at a specific index.
      */
-    Property& operator [](const Index index);
+    PropertyReference operator [](const Index index);
 
     /**
      * @brief Gives the string representation.
@@ -149,8 +168,13 @@ private:
      */
     void swap(Node & other);
 
-    PropertyPtr p_initialPosition;  // The initial position of the Node.
-    PropertyMap p_properties;       // The map between properties index and their pointers.
+    /**
+     * @brief Copies the row of the node into a new PropertyTable and points the node to it.
+     */
+    void detach();
+
+    TablePtr p_table;   // The property table storing the Node properties.
+    Id p_id;            // The row of the Node in the property table.
 };
 
 std::ostream & operator << (std::ostream & out, const Node & node);
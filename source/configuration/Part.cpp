@@ -7,6 +7,10 @@
 //
 
 #include "Part.h"
+#include "../parallel/threads.h"
+#include "../space/KDTree.h"
+#include "../space/SpaceFillingCurve.h"
+#include <numeric>
 
 namespace rbs::configuration {
 
@@ -14,13 +18,39 @@ Part::Part(const std::string &name) : Part(name, CS::Global().appendLocal(CS::Ca
 }
 
 Part::Part(const std::string &name, Part::CS &coordinateSystem)
-    : p_geometry{nullptr}
+    : p_bonds{}
+    , p_connectionSearch{ConnectionSearch::Grid}
+    , p_connectionSkin{0}
+    , p_geometry{nullptr}
+    , p_gridNeighborhoods{}
     , p_localCoordinateSystem{std::shared_ptr<CS>(&coordinateSystem, [](auto){}) }
     , p_name{name}
+    , p_neighborhoodPool{}
+    , p_neighborBonds{}
     , p_neighborParts{}
+    , p_neighborTable{std::make_shared<NeighborhoodPtrs>()}
+    , p_nodePool{}
+    , p_properties{std::make_shared<PropertyTable>()}
+    , p_searchThreadsSize{1}
+    , p_verletLists{}
 {
 }
 
+const BondGraph &Part::bonds() const {
+    return p_bonds;
+}
+
+const BondGraph &Part::bonds(const Part &neighborPart) const {
+    if (this == &neighborPart)
+        return bonds();
+
+    const auto contactBonds = p_neighborBonds.find(&neighborPart);
+    if (contactBonds != p_neighborBonds.end())
+        return contactBonds->second;
+
+    throw std::runtime_error("No connection is defined for \"" + p_name + "\" Part and \"" + neighborPart.p_name + "\" Part");
+}
+
 size_t Part::exportConfiguration(const std::string &path) const noexcept{
     if (p_name.find("Part") != std::string::npos)
         return exportConfiguration(path, p_name);
@@ -273,10 +303,26 @@ const std::string &Part::name() const {
     return p_name;
 }
 
+Part::ConnectionSearch Part::connectionSearch() const {
+    return p_connectionSearch;
+}
+
+double Part::connectionSkin() const {
+    return p_connectionSkin;
+}
+
 const Part::NeighborhoodPtrs &Part::neighborhoods() const {
     return p_neighborhoods;
 }
 
+const PropertyTable &Part::properties() const {
+    return *p_properties;
+}
+
+size_t Part::searchThreadsSize() const {
+    return p_searchThreadsSize;
+}
+
 size_t Part::initiateNeighborhoods() {
     using Logger = report::Logger;
     auto& logger = Logger::centre();
@@ -289,14 +335,19 @@ size_t Part::initiateNeighborhoods() {
     }
 
     const auto start_t = clock();
-    p_mapper = p_localCoordinateSystem->getLinearindexMapper<std::shared_ptr<Neighborhood> >([](const space::Point<3>& point) {
-        return std::make_shared<Neighborhood>(Node(point));
+    const auto pointsSize = p_localCoordinateSystem->pointsSize();
+    p_properties->reserve(p_properties->size() + pointsSize);
+    p_nodePool.reserve(pointsSize);
+    p_neighborhoodPool.reserve(pointsSize);
+    p_gridNeighborhoods = p_localCoordinateSystem->getGridPositionMapper<NeighborhoodPtr>([this](const space::Point<3>& point) {
+        const auto id = p_properties->append(point);
+        return p_neighborhoodPool.make(p_nodePool.make(p_properties, id));
     });
 
-    std::transform(p_mapper.begin(), p_mapper.end(), std::back_inserter(p_neighborhoods),
-                   [](const std::pair<size_t, std::shared_ptr<Neighborhood> >& pair) {
-                       return pair.second;
-                   });
+    std::copy_if(p_gridNeighborhoods.begin(), p_gridNeighborhoods.end(), std::back_inserter(p_neighborhoods),
+                 [](const NeighborhoodPtr& neighborhood) {
+                     return neighborhood != nullptr;
+                 });
 
     const auto problemSize = p_localCoordinateSystem->pointsSize();
     logProcessTiming(clock() - start_t, problemSize, "neighborhood", "initiated");
@@ -307,7 +358,7 @@ size_t Part::searchInnerNeighbors(const double searchRadius) {
     const auto squareHorizonRadius = pow(searchRadius, 2);
     return searchInnerNeighbors( searchRadius, [&squareHorizonRadius](const space::Point<3>& centre, const space::Point<3>& neighbor) {
         return (neighbor.positionVector() - centre.positionVector()).lengthSquared() <= squareHorizonRadius;
-    });
+    }, true);
 }
 
 coordinate_system::CoordinateSystem &Part::local() {
@@ -335,57 +386,112 @@ Part::NeighborhoodPtrs &Part::neighborhoods(const Part &neighborPart)
     throw std::runtime_error("No connection is defined for \"" + p_name + "\" Part and \"" + neighborPart.p_name + "\" Part");
 }
 
-size_t Part::searchInnerNeighbors(const double searchRadius, const Part::NeighborhoodSearchFunction &function) {
+PropertyTable &Part::properties() {
+    return *p_properties;
+}
+
+size_t Part::reorder(const Part::Ordering ordering) {
+    using Curve = space::SpaceFillingCurve;
     using Logger = report::Logger;
     auto& logger = Logger::centre();
-
-    logger.log(Logger::Broadcast::Process, "Searching for inner neighbors of \"" + p_name + "\" Part.");
+    logger.log(Logger::Broadcast::Process, "Reordering the \"" + p_name + "\" Part neighborhoods along the " + ((ordering == Ordering::Hilbert)? "Hilbert" : "Morton") + " curve.");
 
     if (p_neighborhoods.empty()) {
-        logger.log(Logger::Broadcast::Exeption, "The \"" + p_name + "\" Part is not meshed!");
-        throw std::runtime_error("The \"" + p_name + "\" Part is not meshed!");
+        logger.log(Logger::Broadcast::Warning, "No neighborhood found to reorder.");
+        return 0;
     }
 
     const auto start_t = clock();
 
-    const auto searchVector = space::consts::one3D * searchRadius;
-    size_t problemSize = 0;
-    const auto search = [&](const auto& begin, const auto end) {
-        std::for_each(begin, end, [&](const NeighborhoodPtr& neighborhood) {
-            const auto centrePosition = neighborhood->centre()->initialPosition().value<space::Point<3> >();
-            const auto neighborIndexes = p_localCoordinateSystem->getNeighborPointIndices(centrePosition, searchVector, function, centrePosition);
-
-            const auto neighborhoodSize = neighborIndexes.size();
-            problemSize += neighborhoodSize;
-
-            if (neighborhoodSize) {
-                const auto& localMapper = p_mapper;
-                auto& neighborhoodNeighbors = neighborhood->neighbors();
-                std::transform(neighborIndexes.begin(), neighborIndexes.end(), std::back_inserter(neighborhoodNeighbors),
-                               [&localMapper](const coordinate_system::CoordinateSystem::LinearIndex& neighborCentreLinearindex){
-                                   return localMapper.at(neighborCentreLinearindex);
-                               });
-            }
+    std::vector<space::vec3> positions;
+    positions.reserve(p_neighborhoods.size());
+    std::transform(p_neighborhoods.begin(), p_neighborhoods.end(), std::back_inserter(positions), [](const NeighborhoodPtr& neighborhood) {
+        return neighborhood->centre()->initialPosition().value<space::Point<3> >().positionVector();
+    });
+    auto lower = positions.front();
+    auto upper = positions.front();
+    std::for_each(positions.begin(), positions.end(), [&lower, &upper](const space::vec3& position) {
+        for (size_t axis = 0; axis < 3; axis++) {
+            lower[axis] = std::min(lower[axis], position[axis]);
+            upper[axis] = std::max(upper[axis], position[axis]);
+        }
+    });
+
+    std::vector<std::pair<Curve::Key, size_t> > keys;
+    keys.reserve(positions.size());
+    for (size_t row = 0; row < positions.size(); row++) {
+        const auto cell = Curve::cell(positions[row], lower, upper);
+        keys.emplace_back((ordering == Ordering::Hilbert)? Curve::hilbert(cell) : Curve::morton(cell), row);
+    }
+    std::stable_sort(keys.begin(), keys.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first < rhs.first;
+    });
+
+    // The neighborhood centres take the ids they already occupy, in the new order; the other rows stay in place.
+    PropertyTable::Ids slots;
+    slots.reserve(p_neighborhoods.size());
+    std::transform(p_neighborhoods.begin(), p_neighborhoods.end(), std::back_inserter(slots), [this](const NeighborhoodPtr& neighborhood) {
+        if (&neighborhood->centre()->table() != p_properties.get())
+            throw std::runtime_error("The \"" + p_name + "\" Part cannot be reordered; some of its neighborhood centres are not stored on its property table.");
+        return neighborhood->centre()->id();
+    });
+    std::sort(slots.begin(), slots.end());
+
+    PropertyTable::Ids order(p_properties->size());
+    std::iota(order.begin(), order.end(), 0);
+    PropertyTable::Ids ids = order;
+    NeighborhoodPtrs neighborhoods;
+    neighborhoods.reserve(p_neighborhoods.size());
+    for (size_t row = 0; row < keys.size(); row++) {
+        const auto& neighborhood = p_neighborhoods[keys[row].second];
+        order[slots[row]] = neighborhood->centre()->id();
+        ids[neighborhood->centre()->id()] = slots[row];
+        neighborhoods.emplace_back(neighborhood);
+    }
+
+    p_properties->permute(order);
+    std::for_each(neighborhoods.begin(), neighborhoods.end(), [&ids, this](const NeighborhoodPtr& neighborhood) {
+        auto& centre = *neighborhood->centre();
+        centre = Node(p_properties, ids[centre.id()]);
+    });
+    p_neighborhoods.swap(neighborhoods);
+    std::for_each(p_neighborParts.begin(), p_neighborParts.end(), [](auto& pair) {
+        std::stable_sort(pair.second.begin(), pair.second.end(), [](const NeighborhoodPtr& lhs, const NeighborhoodPtr& rhs) {
+            return lhs->centre()->id() < rhs->centre()->id();
         });
-    };
-    search(p_neighborhoods.begin(), neighborhoods().end());
+    });
 
-    logProcessTiming(clock() - start_t, problemSize, "neighhor", "found");
+    // Renumbering the inner bonds lets the rebuild match the bond statuses by the new neighbor ids.
+    p_bonds.renumber(ids, *p_properties);
+    updateBonds();
+    p_verletLists.clear(); // The Verlet lists hold the old node ids.
+
+    const auto problemSize = p_neighborhoods.size();
+    logProcessTiming(clock() - start_t, problemSize, "neighborhood", "reordered");
     return problemSize;
 }
 
+size_t Part::searchInnerNeighbors(const double searchRadius, const Part::NeighborhoodSearchFunction &function) {
+    return searchInnerNeighbors(searchRadius, function, false);
+}
+
 size_t Part::searchNeighborsWith(const Part &neighborPart, const double searchRadius, const bool update) {
     const auto squareHorizonRadius = pow(searchRadius, 2);
-    return searchNeighborsWith(neighborPart, searchRadius, [&squareHorizonRadius](const space::Point<3>& centre, const space::Point<3>& neighbor) {
+    return searchConnection(neighborPart, searchRadius, [&squareHorizonRadius](const space::Point<3>& centre, const space::Point<3>& neighbor) {
         return (neighbor.positionVector() - centre.positionVector()).lengthSquared() <= squareHorizonRadius;
-    }, update);
+    }, true, update);
 }
 
 size_t Part::searchNeighborsWith(const Part &neighborPart, const double searchRadius, const Part::NeighborhoodSearchFunction &function, const bool update) {
-    const auto removeContact = [&neighborPart](NeighborParts& contacts) {
+    return searchConnection(neighborPart, searchRadius, function, false, update);
+}
+
+size_t Part::searchConnection(const Part &neighborPart, const double searchRadius, const Part::NeighborhoodSearchFunction &function, const bool isSpherical, const bool update) {
+    const auto removeContact = [&neighborPart, this](NeighborParts& contacts) {
         const auto contactPair = std::find_if(contacts.begin(), contacts.end(), [&neighborPart](const auto& pair) { return &(*pair.first) == &neighborPart; });
         if(contactPair != contacts.end())
             contacts.erase(contactPair);
+        p_neighborBonds.erase(&neighborPart);
     };
 
     using Logger = report::Logger;
@@ -413,64 +519,191 @@ size_t Part::searchNeighborsWith(const Part &neighborPart, const double searchRa
 
     const auto start_t = clock();
 
-    const auto contactPair = std::find_if(p_neighborParts.begin(), p_neighborParts.end(), [&neighborPart](const auto& pair) { return &(*pair.first) == &neighborPart; });
-    const size_t oldSize = (update)? contactPair->second.size() : 0;
+    // The global positions are only needed for keeping the Verlet list (i.e., for the updates and the skin).
+    const auto keepsVerletList = update || p_connectionSkin > 0;
+    Positions centres, neighbors;
+    if (keepsVerletList) {
+        const auto& global = CS::Global();
+        centres = positionsOn(global);
+        neighbors = neighborPart.positionsOn(global);
+    }
+    const auto verletList = p_verletLists.find(&neighborPart);
+    if (update && verletList != p_verletLists.end()) {
+        auto& list = verletList->second;
+        const auto maxDisplacement = [](const Positions& previous, const Positions& current) {
+            double ans = 0;
+            for (size_t i = 0; i < current.size(); i++)
+                ans = std::max(ans, (current[i] - previous[i]).lengthSquared());
+            return std::sqrt(ans);
+        };
+        const auto isValid = list.searchRadius == searchRadius && list.skin == p_connectionSkin
+                && list.neighborsRevision == neighborPart.p_properties->revision()
+                && list.centres.size() == centres.size() && list.neighbors.size() == neighbors.size()
+                && 2 * std::max(maxDisplacement(list.centres, centres), maxDisplacement(list.neighbors, neighbors)) <= p_connectionSkin;
+        if (isValid) {
+            const auto contactPair = std::find_if(p_neighborParts.begin(), p_neighborParts.end(), [&neighborPart](const auto& pair) { return &(*pair.first) == &neighborPart; });
+            auto& contactNeighbors = (contactPair != p_neighborParts.end()) ? contactPair->second : p_neighborParts[std::shared_ptr<const Part>(&neighborPart, [](auto&){})];
+            const auto problemSize = filterCandidates(neighborPart, list, centres, neighbors, searchRadius, function, contactNeighbors);
+            if (contactNeighbors.empty())
+                removeContact(p_neighborParts);
+            else
+                p_neighborBonds[&neighborPart].assign(contactNeighbors);
 
-    auto& contactNeighbors = searchPotentialNeighborhoods(neighborPart, searchRadius * 1.25, update);
-    const auto checkSize = update && contactNeighbors.size() != p_neighborhoods.size();
+            logProcessTiming(clock() - start_t, problemSize, "neighhor", "updated");
+            return problemSize;
+        }
+    }
+    if (update) // The nodes moved more than half of the skin; re-searching on all the nodes.
+        removeContact(p_neighborParts);
 
-    const auto searchVector = space::consts::one3D * searchRadius;
-    size_t problemSize = 0;
-    const auto search = [&](const auto& begin, const auto end) {
+    auto& contactNeighbors = searchPotentialNeighborhoods(neighborPart);
+
+    // With a skin, the candidates are found without the function and filtered afterwards.
+    const auto hasSkin = p_connectionSkin > 0;
+    const NeighborhoodSearchFunction acceptAll = [](const space::Point<3>&, const space::Point<3>&) { return true; };
+    const auto& candidateFunction = (hasSkin) ? acceptAll : function;
+    const auto candidateRadius = searchRadius + p_connectionSkin;
+
+    const auto searchVector = space::consts::one3D * candidateRadius;
+    const auto threadsSize = parallel::threadsSizeFor(p_searchThreadsSize, contactNeighbors.size());
+    std::vector<size_t> problemSizes(threadsSize, 0);
+    const auto& neighborCS = *neighborPart.p_localCoordinateSystem;
+    const auto& gridNeighborhoods = neighborPart.p_gridNeighborhoods;
+    const auto toNeighbor = [&neighborCS, &gridNeighborhoods](const coordinate_system::CoordinateSystem::LinearIndex& neighborCentreLinearindex) {
+        return gridNeighborhoods[neighborCS.gridPositionOf(neighborCentreLinearindex)];
+    };
+    const auto search = [&](const auto& begin, const auto end, size_t& problemSize) {
+        std::vector<coordinate_system::CoordinateSystem::LinearIndex> neighborIndexes;
         std::for_each(begin, end, [&](const NeighborhoodPtr& neighborhood) {
             const auto centrePosition = neighborhood->centre()->initialPosition().value<space::Point<3> >();
             const auto centrePositionOnNeighborPart = neighborPart.p_localCoordinateSystem->convert( centrePosition, *p_localCoordinateSystem);
-            const auto neighborIndexes = neighborPart.p_localCoordinateSystem->getNeighborPointIndices(centrePositionOnNeighborPart, searchVector, function, centrePositionOnNeighborPart);
-
-            const auto neighborhoodSize = neighborIndexes.size();
-            problemSize += neighborhoodSize;
-
-            if (neighborhoodSize) {
-                const auto& localMapper = neighborPart.p_mapper;
-                auto& neighborhoodNeighbors = neighborhood->neighbors();
-                std::transform(neighborIndexes.begin(), neighborIndexes.end(), std::back_inserter(neighborhoodNeighbors),
-                               [&localMapper](const coordinate_system::CoordinateSystem::LinearIndex& neighborCentreLinearindex){
-                                   return localMapper.at(neighborCentreLinearindex);
-                               });
-            }
+            neighborIndexes.clear();
+            neighborPart.p_localCoordinateSystem->getNeighborPointIndices(centrePositionOnNeighborPart, searchVector, candidateFunction, centrePositionOnNeighborPart, neighborIndexes);
+            problemSize += neighborIndexes.size();
+
+            auto& neighborhoodNeighbors = neighborhood->editNeighbors();
+            std::transform(neighborIndexes.begin(), neighborIndexes.end(), std::back_inserter(neighborhoodNeighbors), toNeighbor);
         });
     };
-    search(contactNeighbors.begin(), contactNeighbors.end());
+
+    // The neighbor Part centres in the global coordinate system, in the order of their linear indices.
+    const auto useTree = p_connectionSearch == ConnectionSearch::KDTree;
+    std::vector<const NeighborhoodPtr*> neighborCentres;
+    space::KDTree::Positions neighborPositions;
+    if (useTree) {
+        neighborCentres.reserve(neighborPart.p_neighborhoods.size());
+        neighborPositions.reserve(neighborPart.p_neighborhoods.size());
+        for (const auto& neighborCentre : gridNeighborhoods) {
+            if (!neighborCentre)
+                continue;
+            const auto& position = neighborCentre->centre()->initialPosition().value<space::Point<3> >();
+            neighborCentres.emplace_back(&neighborCentre);
+            neighborPositions.emplace_back(CS::Global().convert(position, *neighborPart.p_localCoordinateSystem).positionVector());
+        }
+    }
+    const auto tree = (useTree) ? space::KDTree(neighborPositions) : space::KDTree();
+    const auto searchTree = [&](const auto& begin, const auto end, size_t& problemSize) {
+        space::KDTree::Positions globalCentrePositions;
+        globalCentrePositions.reserve(end - begin);
+        std::transform(begin, end, std::back_inserter(globalCentrePositions), [this](const NeighborhoodPtr& neighborhood) {
+            const auto centrePosition = neighborhood->centre()->initialPosition().value<space::Point<3> >();
+            return CS::Global().convert(centrePosition, *p_localCoordinateSystem).positionVector();
+        });
+
+        // A spherical search takes the query results as they are (i.e., the query is the neighborhood); the other
+        // functions filter the sphere through the corners of the cube, on the global axes.
+        const auto queryRadius = (isSpherical) ? candidateRadius : candidateRadius * std::sqrt(3.);
+        std::vector<space::KDTree::Ids> candidates;
+        tree.within(globalCentrePositions, queryRadius, candidates);
+
+        for (size_t n = 0; n < candidates.size(); n++) {
+            auto& neighborhoodNeighbors = (*(begin + n))->editNeighbors();
+            if (isSpherical) {
+                std::transform(candidates[n].begin(), candidates[n].end(), std::back_inserter(neighborhoodNeighbors), [&neighborCentres](const auto candidate) {
+                    return *neighborCentres[candidate];
+                });
+                problemSize += candidates[n].size();
+                continue;
+            }
+            const auto globalCentrePosition = space::Point<3>(globalCentrePositions[n]);
+            for (const auto candidate : candidates[n]) {
+                const auto distance = neighborPositions[candidate] - globalCentrePositions[n];
+                if (std::abs(distance[0]) > candidateRadius || std::abs(distance[1]) > candidateRadius || std::abs(distance[2]) > candidateRadius)
+                    continue;
+                if (candidateFunction(globalCentrePosition, space::Point<3>(neighborPositions[candidate]))) {
+                    neighborhoodNeighbors.emplace_back(*neighborCentres[candidate]);
+                    problemSize++;
+                }
+            }
+        }
+    };
+
+    parallel::forEachRange(contactNeighbors.size(), threadsSize, [&](const size_t thread, const size_t begin, const size_t end) {
+        size_t problemSize = 0;
+        if (useTree)
+            searchTree(contactNeighbors.begin() + begin, contactNeighbors.begin() + end, problemSize);
+        else
+            search(contactNeighbors.begin() + begin, contactNeighbors.begin() + end, problemSize);
+        problemSizes[thread] = problemSize;
+    });
+    auto problemSize = std::accumulate(problemSizes.begin(), problemSizes.end(), size_t(0));
 
     // Search for empty neighbors and remove them.
     contactNeighbors.erase(std::remove_if(contactNeighbors.begin(), contactNeighbors.end(), [](const NeighborhoodPtr& neighborhood) {
         return neighborhood->neighbors().empty();
     }), contactNeighbors.end());
 
-    if (checkSize) {
-        if (oldSize) {
-            const auto newSize = contactNeighbors.size();
-            const auto rasio = double(newSize) / oldSize;
-            if ( rasio < .75 || 1.25 < rasio) {
-                logger.log(Logger::Broadcast::Warning, "The contact surface tolerance is higher than maximum allowed 15%.");
-                logger.log(Logger::Broadcast::Warning, "Re-searching the neighborhoods, this time considering all of the neighborhood centers of \"" + p_name + "\" Part.");
-                contactNeighbors.clear();
-                removeContact(p_neighborParts);
-                return searchNeighborsWith(neighborPart, searchRadius, function, false);
-            }
-        } else {
-            logger.log(Logger::Broadcast::Warning, "Contact is not found.");
-            logger.log(Logger::Broadcast::Warning, "No connection made between \"" + p_name + "\" Part and \"" + neighborPart.p_name + "\" Part.");
-        }
+    if (!keepsVerletList) {
+        p_verletLists.erase(&neighborPart);
+    } else {
+        auto& list = p_verletLists[&neighborPart];
+        list.neighborhoods = contactNeighbors;
+        list.offsets.assign(1, 0);
+        list.candidates.clear();
+        list.candidates.reserve(problemSize);
+        list.candidateTable.assign(neighborPart.p_properties->size(), nullptr);
+        std::for_each(contactNeighbors.begin(), contactNeighbors.end(), [&list](const NeighborhoodPtr& neighborhood) {
+            const auto& candidates = neighborhood->neighbors();
+            std::transform(candidates.begin(), candidates.end(), std::back_inserter(list.candidates), [&list](const NeighborhoodPtr& candidate) {
+                const auto id = candidate->centre()->id();
+                list.candidateTable[id] = candidate;
+                return id;
+            });
+            list.offsets.emplace_back(list.candidates.size());
+        });
+        list.centres.swap(centres);
+        list.neighbors.swap(neighbors);
+        list.neighborsRevision = neighborPart.p_properties->revision();
+        list.searchRadius = searchRadius;
+        list.skin = p_connectionSkin;
+        if (hasSkin)
+            problemSize = filterCandidates(neighborPart, list, list.centres, list.neighbors, searchRadius, function, contactNeighbors);
+    }
+
+    if (update && contactNeighbors.empty()) {
+        logger.log(Logger::Broadcast::Warning, "Contact is not found.");
+        logger.log(Logger::Broadcast::Warning, "No connection made between \"" + p_name + "\" Part and \"" + neighborPart.p_name + "\" Part.");
     }
 
     if (contactNeighbors.empty())
         removeContact(p_neighborParts);
+    else
+        p_neighborBonds[&neighborPart].assign(contactNeighbors);
 
     logProcessTiming(clock() - start_t, problemSize, "neighhor", "found");
     return problemSize;
 }
 
+void Part::setConnectionSearch(const Part::ConnectionSearch search) {
+    p_connectionSearch = search;
+}
+
+void Part::setConnectionSkin(const double skin) {
+    if (skin < 0)
+        throw std::out_of_range("The connection skin cannot be negative.");
+    p_connectionSkin = skin;
+}
+
 void Part::setGeometry(const geometry::Combined &shape) {
     p_geometry = std::make_shared<geometry::Combined>(shape);
 }
@@ -479,6 +712,17 @@ void Part::setGeometry(const geometry::Primary &shape) {
     p_geometry = std::make_shared<geometry::Primary>(shape);
 }
 
+void Part::setSearchThreadsSize(const size_t threadsSize) {
+    p_searchThreadsSize = threadsSize;
+}
+
+void Part::updateBonds() {
+    assignInnerBonds();
+    std::for_each(p_neighborParts.begin(), p_neighborParts.end(), [this](const auto& pair) {
+        p_neighborBonds[&(*pair.first)].assign(pair.second);
+    });
+}
+
 void Part::logProcessTiming(const long dist, const size_t problemSize, const std::string &item, const std::string action) const noexcept {
     using Logger = report::Logger;
     auto& logger = Logger::centre();
@@ -518,7 +762,67 @@ void Part::logUnknownExeption() const noexcept {
     logger.log(Logger::Broadcast::Exeption, "Try to re-run the program; if the same happens, the software is unstable. Please open an issue on https://github.com/alijenabi/RBS/issues." );
 }
 
-Part::NeighborhoodPtrs &Part::searchPotentialNeighborhoods(const Part &neighborPart, const double searchRadius, const bool update) {
+size_t Part::searchInnerNeighbors(const double searchRadius, const Part::NeighborhoodSearchFunction &function, const bool useStencil) {
+    using Logger = report::Logger;
+    auto& logger = Logger::centre();
+
+    logger.log(Logger::Broadcast::Process, "Searching for inner neighbors of \"" + p_name + "\" Part.");
+
+    if (p_neighborhoods.empty()) {
+        logger.log(Logger::Broadcast::Exeption, "The \"" + p_name + "\" Part is not meshed!");
+        throw std::runtime_error("The \"" + p_name + "\" Part is not meshed!");
+    }
+
+    const auto start_t = clock();
+
+    const auto searchVector = space::consts::one3D * searchRadius;
+    std::shared_ptr<coordinate_system::Stencil> stencil;
+    if (useStencil && p_localCoordinateSystem->isUniform()) {
+        stencil = std::make_shared<coordinate_system::Stencil>(p_localCoordinateSystem->getNeighborStencil(searchVector, function));
+        logger.log(Logger::Broadcast::Process, "Using a stencil of " + std::to_string(stencil->size()) + " neighbor offsets.");
+    }
+
+    using LinearIndex = coordinate_system::CoordinateSystem::LinearIndex;
+    // The occupied grid positions, in the order of their linear indices.
+    std::vector<size_t> centres;
+    centres.reserve(p_neighborhoods.size());
+    for (size_t gridPosition = 0; gridPosition < p_gridNeighborhoods.size(); gridPosition++) {
+        if (p_gridNeighborhoods[gridPosition])
+            centres.emplace_back(gridPosition);
+    }
+
+    const auto& localCS = *p_localCoordinateSystem;
+    const auto& gridNeighborhoods = p_gridNeighborhoods;
+    const auto toNeighbor = [&localCS, &gridNeighborhoods](const LinearIndex& neighborCentreLinearindex){
+        return gridNeighborhoods[localCS.gridPositionOf(neighborCentreLinearindex)];
+    };
+    const auto threadsSize = parallel::threadsSizeFor(p_searchThreadsSize, centres.size());
+    std::vector<size_t> problemSizes(threadsSize, 0);
+    parallel::forEachRange(centres.size(), threadsSize, [&](const size_t thread, const size_t begin, const size_t end) {
+        size_t problemSize = 0;
+        std::vector<LinearIndex> neighborIndexes;
+        std::for_each(centres.begin() + begin, centres.begin() + end, [&](const size_t gridPosition) {
+            const auto& centre = p_gridNeighborhoods[gridPosition];
+            auto& neighborhoodNeighbors = centre->editNeighbors();
+            neighborIndexes.clear();
+            if (!stencil || !localCS.getNeighborPointIndices(localCS.linearIndexAt(gridPosition), *stencil, neighborIndexes)) {
+                // The generic search, also for the neighborhoods close to the grid boundary.
+                const auto centrePosition = centre->centre()->initialPosition().template value<space::Point<3> >();
+                localCS.getNeighborPointIndices(centrePosition, searchVector, function, centrePosition, neighborIndexes);
+            }
+            problemSize += neighborIndexes.size();
+            std::transform(neighborIndexes.begin(), neighborIndexes.end(), std::back_inserter(neighborhoodNeighbors), toNeighbor);
+        });
+        problemSizes[thread] = problemSize;
+    });
+    const auto problemSize = std::accumulate(problemSizes.begin(), problemSizes.end(), size_t(0));
+    assignInnerBonds();
+
+    logProcessTiming(clock() - start_t, problemSize, "neighhor", "found");
+    return problemSize;
+}
+
+Part::NeighborhoodPtrs &Part::searchPotentialNeighborhoods(const Part &neighborPart) {
     const auto include = [](const auto& source, NeighborhoodPtrs& target) {
         std::transform(source.begin(), source.end(), std::back_inserter(target),
                        [](const auto& neighborhood){
@@ -539,28 +843,7 @@ Part::NeighborhoodPtrs &Part::searchPotentialNeighborhoods(const Part &neighborP
         return contactPair->second;
     }
 
-    if (!update) {
-        include(p_neighborhoods, contactPair->second);
-        return contactPair->second;
-    }
-
-    std::set<size_t> potentialIndices = {};
-    const auto radiusVector = searchRadius * space::consts::one3D;
-    const auto searchFunction = [](const auto&, const auto&) { return true; };
-    std::for_each(contactPair->second.begin(), contactPair->second.end(), [&radiusVector, &searchFunction, &potentialIndices, this](const NeighborhoodPtr& neighborhood) {
-        const auto& centrePosition = neighborhood->centre()->initialPosition().value<space::Point<3> >();
-        const auto& currentIndices = p_localCoordinateSystem->getNeighborPointIndices(centrePosition, radiusVector, searchFunction, centrePosition);
-
-        potentialIndices.insert(currentIndices.begin(), currentIndices.end());
-    });
-
-    contactPair->second.clear();
-    std::transform(potentialIndices.begin(), potentialIndices.end(), std::back_inserter(contactPair->second),
-                   [this](const coordinate_system::CoordinateSystem::LinearIndex neighborCentreLinearindex){
-                       const auto& centre = p_mapper.at(neighborCentreLinearindex)->centre();
-                       return std::make_shared<Neighborhood>(centre);
-                   });
-
+    include(p_neighborhoods, contactPair->second);
     return contactPair->second;
 }
 
@@ -598,10 +881,76 @@ void Part::sortNeighborhoods() {
         logger.log(Logger::Broadcast::ProcessEnd, "");
     });
 
+    // The rows of the bonds follow the order of the neighborhoods.
+    updateBonds();
+
     durationText = report::date_time::duration::formated(double(clock() - start_t) / CLOCKS_PER_SEC, 6) ;
     logger.log(Logger::Broadcast::ProcessStart, "");
     logger.log(Logger::Broadcast::ProcessTiming, "In total: done in " + ((durationText.empty())? " less than a nanosecond" : durationText) + ".");
     logger.log(Logger::Broadcast::ProcessEnd, "");
 }
 
+void Part::assignInnerBonds() {
+    auto& table = *p_neighborTable;
+    table.assign(p_properties->size(), nullptr);
+    std::for_each(p_neighborhoods.begin(), p_neighborhoods.end(), [&table, this](const NeighborhoodPtr& neighborhood) {
+        const auto& centre = *neighborhood->centre();
+        if (&centre.table() == p_properties.get())
+            table[centre.id()] = neighborhood;
+    });
+    p_bonds.assign(p_neighborhoods, p_neighborTable);
+}
+
+Part::Positions Part::positionsOn(const CS &coordinateSystem) const {
+    Positions positions(p_properties->size(), space::consts::o3D);
+    const auto isLocal = &coordinateSystem == p_localCoordinateSystem.get();
+    for (const auto& neighborhood : p_neighborhoods) {
+        const auto& centre = *neighborhood->centre();
+        const auto& position = centre.initialPosition().value<space::Point<3> >();
+        positions[centre.id()] = (isLocal) ? position.positionVector() : coordinateSystem.convert(position, *p_localCoordinateSystem).positionVector();
+    }
+    return positions;
+}
+
+size_t Part::filterCandidates(const Part &neighborPart, const Part::VerletList &list, const Part::Positions &centres, const Part::Positions &neighbors, const double searchRadius, const Part::NeighborhoodSearchFunction &function, Part::NeighborhoodPtrs &contactNeighbors) const {
+    // The function receives the positions in the same coordinate system as the searches do.
+    const auto useTree = p_connectionSearch == ConnectionSearch::KDTree;
+    Positions localCentres, localNeighbors;
+    if (!useTree) {
+        localCentres = positionsOn(*neighborPart.p_localCoordinateSystem);
+        localNeighbors = neighborPart.positionsOn(*neighborPart.p_localCoordinateSystem);
+    }
+    const auto& centrePositions = (useTree) ? centres : localCentres;
+    const auto& neighborPositions = (useTree) ? neighbors : localNeighbors;
+
+    const auto& neighborhoods = list.neighborhoods;
+    const auto threadsSize = parallel::threadsSizeFor(p_searchThreadsSize, neighborhoods.size());
+    std::vector<size_t> problemSizes(threadsSize, 0);
+    parallel::forEachRange(neighborhoods.size(), threadsSize, [&](const size_t thread, const size_t begin, const size_t end) {
+        size_t problemSize = 0;
+        for (auto n = begin; n < end; n++) {
+            auto& neighborhoodNeighbors = neighborhoods[n]->editNeighbors();
+            neighborhoodNeighbors.clear();
+            const auto& centre = centrePositions[neighborhoods[n]->centre()->id()];
+            for (auto candidate = list.offsets[n]; candidate < list.offsets[n + 1]; candidate++) {
+                const auto id = list.candidates[candidate];
+                const auto distance = neighborPositions[id] - centre;
+                if (std::abs(distance[0]) > searchRadius || std::abs(distance[1]) > searchRadius || std::abs(distance[2]) > searchRadius)
+                    continue;
+                if (function(space::Point<3>(centre), space::Point<3>(neighborPositions[id]))) {
+                    neighborhoodNeighbors.emplace_back(list.candidateTable[id]);
+                    problemSize++;
+                }
+            }
+        }
+        problemSizes[thread] = problemSize;
+    });
+
+    contactNeighbors.clear();
+    std::copy_if(neighborhoods.begin(), neighborhoods.end(), std::back_inserter(contactNeighbors), [](const NeighborhoodPtr& neighborhood) {
+        return !neighborhood->neighbors().empty();
+    });
+    return std::accumulate(problemSizes.begin(), problemSizes.end(), size_t(0));
+}
+
 } // namespace rbs::configuration
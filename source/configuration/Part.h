@@ -9,7 +9,9 @@
 #ifndef PART_H
 #define PART_H
 
+#include "BondGraph.h"
 #include "Neighborhood.h"
+#include "Pool.h"
 #include "../coordinate_system/CoordinateSystem.h"
 #include "../exporting/VTK.h"
 #include "../geometry/Combined.h"
@@ -32,6 +34,8 @@ public:
     using NeighborhoodPtr = std::shared_ptr<Neighborhood>;
     using NeighborhoodPtrs = std::vector<NeighborhoodPtr>;
 
+    using PropertyTablePtr = std::shared_ptr<PropertyTable>;
+
     using Geometry = geometry::Geometry;
     using GeometryPtr = std::shared_ptr<Geometry>;
 
@@ -39,6 +43,22 @@ public:
 
     using NeighborhoodSearchFunction = std::function<bool(const space::Point<3>&, const space::Point<3>&)>;
 
+    /**
+     * @brief The ConnectionSearch enum denotes how the neighbors are found on the neighbor Part (see searchNeighborsWith()).
+     */
+    enum class ConnectionSearch {
+        Grid,       // Along the neighbor Part local grid; the function receives the positions in the neighbor Part local coordinate system.
+        KDTree,     // By radius queries on a k-d tree of the neighbor Part global positions; the function receives the global positions (in a cube on the global axes).
+    };
+
+    /**
+     * @brief The Ordering enum denotes the space-filling curve used for reordering the neighborhoods (see reorder()).
+     */
+    enum class Ordering {
+        Hilbert,    // Along the Hilbert curve (the better locality).
+        Morton,     // Along the Morton (i.e., Z-order) curve (the cheaper keys).
+    };
+
     /**
      * @brief Part Constructor.
      * @param name The name of the part.
@@ -52,6 +72,22 @@ public:
      */
     explicit Part(const std::string& name, CS& coordinateSystem);
 
+    /**
+     * @brief Gives the bonds of the inner neighborhoods in compressed sparse row format.
+     * @note The rows are in the same order as the neighborhoods.
+     * @note The graph stores the neighbors of the inner neighborhoods (see BondGraph::storesNeighbors()), as long as
+     *       they are all neighborhoods of this part.
+     */
+    const BondGraph& bonds() const;
+
+    /**
+     * @brief Gives the bonds of the connection neighborhoods in compressed sparse row format.
+     * @note The rows are in the same order as the connection neighborhoods and the neighbor ids refer to the neighbor Part nodes.
+     * @note It will return this part inner bonds if given neighborhood part is the same as this part.
+     * @throws If there is no connection between the parts.
+     */
+    const BondGraph& bonds(const Part& neighborPart) const;
+
     /**
      * @brief Exports initial configuration to Vtk file.
      * @note The part name plus "Part" keyword will be used for exportation.
@@ -122,13 +158,35 @@ public:
      */
     const std::string& name() const;
 
+    /**
+     * @brief Gives how the neighbors are found on the neighbor Parts (see setConnectionSearch()).
+     */
+    ConnectionSearch connectionSearch() const;
+
+    /**
+     * @brief Gives the distance added to the search radius of the connections (see setConnectionSkin()).
+     */
+    double connectionSkin() const;
+
     /**
      * @brief Gives direct access to the neighborhoods.
      */
     const NeighborhoodPtrs& neighborhoods() const;
 
+    /**
+     * @brief Gives the property table storing the properties of the neighborhood centres.
+     * @note The id of each neighborhood centre is its row in the table.
+     */
+    const PropertyTable& properties() const;
+
+    /**
+     * @brief Gives the number of the threads used by the neighborhood searches (see setSearchThreadsSize()).
+     */
+    size_t searchThreadsSize() const;
+
     /**
      * @brief Initiates the neighborhoods.
+     * @note The neighborhood centres will be stored on the part property table, in the same order as the neighborhoods.
      * @return The number of neighborhoods.
      */
     size_t initiateNeighborhoods();
@@ -154,8 +212,32 @@ public:
      */
     NeighborhoodPtrs& neighborhoods(const Part& neighborPart);
 
+    /**
+     * @brief Gives direct access to the property table storing the properties of the neighborhood centres.
+     */
+    PropertyTable& properties();
+
+    /**
+     * @brief Reorders the neighborhoods along a space-filling curve, so the close nodes are stored close in memory.
+     * @details The neighborhoods, the property table rows and the bonds of the part are permuted together; thus, the
+     *          node ids stay equal to the neighborhood positions and the bond statuses are kept. The Nodes and the
+     *          Neighborhoods themselves are not replaced; thus, the pointers to them (e.g., held by the exporters, the
+     *          boundary domains or the neighbor Parts) stay valid and present the same points.
+     * @note The neighbors of each neighborhood keep their order.
+     * @note The bonds and the Verlet lists of the other Parts ending on this part store the old node ids; they are
+     *       detected as stale through the property table revision (see PropertyTable::revision()) and rebuilt by the
+     *       relations and the next connection search, respectively.
+     * @warning The copied Nodes (i.e., the Nodes not held by the neighborhoods) still point to their old rows.
+     * @param ordering The space-filling curve.
+     * @return The number of reordered neighborhoods.
+     */
+    size_t reorder(const Ordering ordering = Ordering::Hilbert);
+
     /**
      * @brief Performs an spherical inner neighborhood search.
+     * @note If the local coordinate system is uniform (see CoordinateSystem::isUniform()), the neighbor offsets are
+     *          computed once and the neighbors of the neighborhoods away from the grid boundary are found by only
+     *          checking the existence of the offset points (see coordinate_system::Stencil).
      * @param searchRadius The radius of the spherical neighborhood.
      * @return The number of total found neighbors (i.e., the number of one ended bonds).
      */
@@ -163,6 +245,7 @@ public:
 
     /**
      * @brief Performs a neighborhood search finding the neighbors of the neighborhood inside this part.
+     * @warning The function must be safe to call from multiple threads if there are more than one search threads.
      * @param searchRadius The cubic neighborhood radius.
      * @param function The function that desides whether the neighbor point in the cubic neighborhood is a neighbor.
      * @return The number of total found neighbors (i.e., the number of one ended bonds).
@@ -171,25 +254,56 @@ public:
 
     /**
      * @brief Perfoms a spherical neighborhood search on the neihbour Part neighborhood centers.
-     * @note Use update only if the relative displacement between two part is small compare to the base part grid spacing.
+     * @note The update reuses the candidates of the last search if the nodes have not moved more than half of the
+     *          connection skin since then (see setConnectionSkin()); otherwise, it searches on all the nodes.
      * @param neighborPart The neighbor Part.
      * @param searchRadius The radius of the spherical neighborhood.
-     * @param update Whether to update the current connection or search on all the nodes.
+     * @param update Whether to update the last connection with the same neighbor Part and search radius or search on all the nodes.
      * @return The number of total found neighbors (i.e., the number of one ended bonds).
      */
     size_t searchNeighborsWith(const Part& neighborPart, const double searchRadius, const bool update = false);
 
     /**
      * @brief Perfoms a neighborhood search on the neihbour Part neighborhood centers.
-     * @note Use update only if the relative displacement between two part is small compare to the base part grid spacing.
+     * @note The update reuses the candidates of the last search if the nodes have not moved more than half of the
+     *          connection skin since then (see setConnectionSkin()); otherwise, it searches on all the nodes.
+     * @warning The function must be safe to call from multiple threads if there are more than one search threads.
      * @param neighborPart The neighbor Part.
      * @param searchRadius The cubic neighborhood radius.
      * @param function The function that desides whether the neighbor point in the cubic neighborhood is a neighbor.
-     * @param update Whether to update the current connection or search on all the nodes.
+     * @param update Whether to update the last connection with the same neighbor Part and search radius or search on all the nodes.
      * @return The number of total found neighbors (i.e., the number of one ended bonds).
      */
     size_t searchNeighborsWith(const Part& neighborPart, const double searchRadius, const NeighborhoodSearchFunction& function, const bool update = false);
 
+    /**
+     * @brief Sets how the neighbors are found on the neighbor Parts.
+     * @details The grid search converts each centre to the neighbor Part local coordinate system and searches the cuboid
+     *          around it on the neighbor Part grid; in a cylindrical, spherical or rotated coordinate system this cuboid
+     *          does not match the neighborhood and most of the candidates are rejected (or missed). The k-d tree search
+     *          finds the candidates in the global coordinate system instead, independent of the neighbor Part grid.
+     * @note The spherical k-d tree searches (see searchNeighborsWith()) query exactly the neighborhood sphere; a custom
+     *       search function filters the cube around the centre on the global axes instead.
+     * @param search The search method.
+     */
+    void setConnectionSearch(const ConnectionSearch search);
+
+    /**
+     * @brief Sets the distance added to the search radius of the connections.
+     * @details The connection searches find the candidates within the search radius plus the skin (i.e., Verlet lists)
+     *          and keep them along with the global positions of the nodes of both Parts. The updating searches (see
+     *          searchNeighborsWith()) only filter these candidates as long as no node has moved more than half of the
+     *          skin; thus, for the Parts moving slowly relative to each other (i.e., their local coordinate systems), the
+     *          connections are searched once in several updates instead of on every update.
+     * @note The tracked positions are the initial positions of the nodes (i.e., without their Displacement), since the
+     *       connection searches and the filtering of the candidates are on the initial positions as well; the
+     *       displacements do not change the connections and thus do not invalidate the candidates.
+     * @note With a zero skin (the default), only the updating searches keep the candidates, and reuse them while the
+     *       nodes have not moved at all.
+     * @throws If the skin is negative.
+     */
+    void setConnectionSkin(const double skin);
+
     /**
      * @brief Sets the shape.
      */
@@ -200,6 +314,21 @@ public:
      */
     void setGeometry(const geometry::Primary& shape);
 
+    /**
+     * @brief Sets the number of the threads used by the neighborhood searches.
+     * @details The neighborhoods are split into consecutive ranges, one per thread, and the found neighbors of each
+     *          neighborhood keep their order; thus, the results are identical to the single-threaded search.
+     * @param threadsSize The number of the threads; zero means as many as the hardware can run at the same time.
+     */
+    void setSearchThreadsSize(const size_t threadsSize);
+
+    /**
+     * @brief Rebuilds the bonds of the inner and the connection neighborhoods.
+     * @note The neighborhood searches build the bonds; use this only after modifying the neighbors of the neighborhoods
+     *       directly (see Neighborhood::editNeighbors()).
+     */
+    void updateBonds();
+
 protected:
 
     /**
@@ -222,28 +351,108 @@ protected:
     void logUnknownExeption() const noexcept;
 
     /**
-     * @brief Searches the neighborhoods of this part and finds the potential neighborhoods for searching bonds among them.
+     * @brief Performs a neighborhood search finding the neighbors of the neighborhood inside this part.
+     * @param searchRadius The cubic neighborhood radius.
+     * @param function The function that desides whether the neighbor point in the cubic neighborhood is a neighbor.
+     * @param useStencil Whether to use a stencil if the local coordinate system is uniform.
+     *                   The function must only depend on the relative position of the neighbor to the centre.
+     * @return The number of total found neighbors (i.e., the number of one ended bonds).
+     */
+    size_t searchInnerNeighbors(const double searchRadius, const NeighborhoodSearchFunction& function, const bool useStencil);
+
+    /**
+     * @brief Gives the connection neighborhoods of this part with the other part, adding them if there is no connection.
      * @param part The other part.
      */
-    NeighborhoodPtrs& searchPotentialNeighborhoods(const Part& part, const double searchRadius, const bool update);
+    NeighborhoodPtrs& searchPotentialNeighborhoods(const Part& part);
 
     /**
      * @brief Sort the Neighborhoods.
+     * @note The bonds are rebuilt in the new order, keeping their statuses (see updateBonds()).
      */
     void sortNeighborhoods();
 
 private:
 
+    using Positions = std::vector<space::Vector<3> >;
+
+    /**
+     * @brief The VerletList stores the candidate neighbors of a connection, found within the search radius plus the skin.
+     */
+    struct VerletList {
+        NeighborhoodPtrs neighborhoods;             // The connection neighborhoods having at least one candidate.
+        std::vector<size_t> offsets;                // The position of the first candidate of each neighborhood (plus the end).
+        std::vector<size_t> candidates;             // The ids of the candidate neighbor Part nodes.
+        NeighborhoodPtrs candidateTable;            // The candidate neighbor Part neighborhoods, by their ids.
+        Positions centres;                          // The initial global positions of this part nodes at the search, by their ids.
+        Positions neighbors;                        // The initial global positions of the neighbor Part nodes at the search, by their ids.
+        PropertyTable::Revision neighborsRevision;  // The revision of the neighbor Part property table at the search.
+        double searchRadius;                        // The search radius without the skin.
+        double skin;                                // The skin.
+    };
+
+    /**
+     * @brief Rebuilds the bonds of the inner neighborhoods, storing their neighbors (see BondGraph::assign()).
+     * @note Updates the neighbor table first; thus, the neighbors are presented by their centre id.
+     */
+    void assignInnerBonds();
+
+    /**
+     * @brief Perfoms a neighborhood search on the neihbour Part neighborhood centers (see searchNeighborsWith()).
+     * @param neighborPart The neighbor Part.
+     * @param searchRadius The cubic neighborhood radius.
+     * @param function The function that desides whether the neighbor point in the cubic neighborhood is a neighbor.
+     * @param isSpherical Whether the function is the spherical neighborhood of the search radius; the k-d tree search
+     *                    then takes the neighbors of its radius query without calling the function.
+     * @param update Whether to update the last connection with the same neighbor Part and search radius or search on all the nodes.
+     * @return The number of total found neighbors (i.e., the number of one ended bonds).
+     */
+    size_t searchConnection(const Part& neighborPart, const double searchRadius, const NeighborhoodSearchFunction& function, const bool isSpherical, const bool update);
+
+    /**
+     * @brief Gives the positions of the neighborhood centres in a coordinate system, indexed by their ids.
+     * @note The positions are independent of the order of the neighborhoods (see sortNeighborhoods()); the rows of the
+     *       property table without a neighborhood are at the origin.
+     */
+    Positions positionsOn(const CS& coordinateSystem) const;
+
+    /**
+     * @brief Finds the neighbors of the Verlet list neighborhoods among their candidates.
+     * @param neighborPart The neighbor Part.
+     * @param list The Verlet list.
+     * @param centres The current global positions of this part nodes, by their ids.
+     * @param neighbors The current global positions of the neighbor Part nodes, by their ids.
+     * @param searchRadius The cubic neighborhood radius.
+     * @param function The function that desides whether the neighbor point in the cubic neighborhood is a neighbor.
+     * @param contactNeighbors The connection neighborhoods, replaced by the ones having at least one neighbor.
+     * @return The number of total found neighbors (i.e., the number of one ended bonds).
+     */
+    size_t filterCandidates(const Part& neighborPart, const VerletList& list, const Positions& centres, const Positions& neighbors, const double searchRadius, const NeighborhoodSearchFunction& function, NeighborhoodPtrs& contactNeighbors) const;
+
     using CSPtr = std::shared_ptr<CS>;
-    using Mapper = std::map<size_t, std::shared_ptr<Neighborhood> >;
+    using GridNeighborhoods = std::vector<NeighborhoodPtr>;
     using NeighborParts = std::map<std::shared_ptr<const Part>, NeighborhoodPtrs>;
-
+    using NeighborBonds = std::map<const Part*, BondGraph>;
+    using NeighborhoodPool = Pool<Neighborhood>;
+    using NodePool = Pool<Node>;
+    using VerletLists = std::map<const Part*, VerletList>;
+
+    BondGraph p_bonds;                  // The bonds of the inner neighborhoods.
+    ConnectionSearch p_connectionSearch; // How the neighbors are found on the neighbor Parts.
+    double p_connectionSkin;            // The distance added to the search radius of the connections.
     GeometryPtr p_geometry;             // The geometry of the part ( if null, then all of the points inside the geometry will be taken )
+    GridNeighborhoods p_gridNeighborhoods; // The neighborhoods at the grid positions of the local coordinate system (null where there is no point).
     CSPtr p_localCoordinateSystem;      // The local coordinate of the part.
-    Mapper p_mapper;                    // The mapper
     std::string p_name;                 // The name of the part.
+    NeighborhoodPool p_neighborhoodPool; // The slabs of the included neighborhoods.
     NeighborhoodPtrs p_neighborhoods;   // The included neighborhoods of the part configuration.
+    NeighborBonds p_neighborBonds;      // The bonds of the neighborhoods with other parts.
     NeighborParts p_neighborParts;      // The neighborhood with other parts neighborhoods.
+    std::shared_ptr<NeighborhoodPtrs> p_neighborTable; // The neighborhoods by their centre id (presenting the neighbors of the inner bonds).
+    NodePool p_nodePool;                // The slabs of the neighborhood centres.
+    PropertyTablePtr p_properties;      // The properties of the neighborhood centres.
+    size_t p_searchThreadsSize;         // The number of the threads used by the neighborhood searches.
+    VerletLists p_verletLists;          // The candidate neighbors of the connections.
 };
 
 } // namespace rbs::configuration
@@ -0,0 +1,119 @@
+//
+//  Pool.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+/**
+ * The configuration namespace provides the means to create configurations and use them.
+ */
+namespace rbs::configuration {
+
+/**
+ * @brief The Pool creates objects inside contiguous slabs instead of one heap block per object.
+ * @details Each slab is a fixed capacity array of objects owned by a single shared pointer; the pointers given by the
+ *          pool share the ownership of their slab (i.e., aliasing shared pointers). Thus, creating an object does not
+ *          allocate (except for the first object of each slab), the objects created one after another are neighbors in
+ *          memory, and a slab is freed at once when the pool and all the pointers to its objects are released.
+ * @note The objects are never moved; thus, the pointers given by the pool stay valid as long as they are kept.
+ * @warning A slab stays in memory as long as any of its objects is referenced.
+ * @tparam T The type of the objects.
+ */
+template<typename T>
+class Pool
+{
+public:
+    using Ptr = std::shared_ptr<T>;
+
+    /**
+     * @brief The constructor.
+     * @param slabSize The default number of objects in each slab.
+     */
+    explicit Pool(const size_t slabSize = 4096)
+        : p_size{0}
+        , p_slabSize{std::max<size_t>(slabSize, 1)}
+        , p_slabs{}
+    {
+    }
+
+    /**
+     * @brief Gives the number of objects created by the pool.
+     */
+    size_t size() const {
+        return p_size;
+    }
+
+    /**
+     * @brief Gives the number of slabs kept by the pool.
+     */
+    size_t slabsSize() const {
+        return p_slabs.size();
+    }
+
+    /**
+     * @brief Releases the slabs of the pool.
+     * @note The objects that are still referenced will stay valid.
+     */
+    void clear() {
+        p_slabs.clear();
+        p_size = 0;
+    }
+
+    /**
+     * @brief Creates an object inside the pool.
+     * @param args The constructor arguments of the object.
+     * @return The pointer sharing the ownership of the object slab.
+     */
+    template<typename... Args>
+    Ptr make(Args&&... args) {
+        if (p_slabs.empty() || p_slabs.back()->size() == p_slabs.back()->capacity())
+            appendSlab(p_slabSize);
+
+        auto& slab = p_slabs.back();
+        slab->emplace_back(std::forward<Args>(args)...);
+        p_size++;
+        return Ptr(slab, &slab->back());
+    }
+
+    /**
+     * @brief Makes sure that the next objects will be created inside the same slab.
+     * @param size The number of the next objects.
+     */
+    void reserve(const size_t size) {
+        if (size == 0)
+            return;
+        if (p_slabs.empty() || p_slabs.back()->capacity() - p_slabs.back()->size() < size)
+            appendSlab(std::max(size, p_slabSize));
+    }
+
+private:
+    using Slab = std::vector<T>;
+    using SlabPtr = std::shared_ptr<Slab>;
+
+    /**
+     * @brief Appends an empty slab.
+     * @param capacity The number of objects the slab can hold.
+     */
+    void appendSlab(const size_t capacity) {
+        auto slab = std::make_shared<Slab>();
+        slab->reserve(capacity);
+        p_slabs.emplace_back(std::move(slab));
+    }
+
+    size_t p_size;                  // The number of objects created by the pool.
+    size_t p_slabSize;              // The default number of objects in each slab.
+    std::vector<SlabPtr> p_slabs;   // The slabs.
+};
+
+} // namespace rbs::configuration
+
+#endif // POOL_H
@@ -0,0 +1,192 @@
+//
+//  PropertyKey.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef PROPERTYKEY_H
+#define PROPERTYKEY_H
+
+#include "Node.h"
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ * The configuration namespace provides the means to create configurations and use them.
+ */
+namespace rbs::configuration {
+
+/**
+ * @brief The PropertyKey provides typed access to a property index of the Nodes.
+ * @details Both the type and the index of the property are resolved at compile time; thus, the accessors read the
+ *          property column directly with a single lookup. The double and space::vec3 properties are read without any
+ *          type check from the typed array of their column, if the column is typed (see column()); the properties of the
+ *          untyped columns are read with a single type check (see SimVariant::valueIf()).
+ * @note A property set with another type is an error, not a missing property; thus, the accessors (including find() and
+ *          getOr()) throw for it, and only fall back when the property is not set.
+ * @example using Displacement = PropertyKey<space::vec3, Property::Displacement>;
+ *          const auto displacement = Displacement::getOr(node, space::consts::o3D);
+ * @tparam T The type of the property.
+ * @tparam PropertyIndex The index of the property.
+ */
+template<typename T, PropertyTable::Index PropertyIndex>
+class PropertyKey
+{
+public:
+    using Column = PropertyTable::Column;
+    using Id = PropertyTable::Id;
+    using Index = PropertyTable::Index;
+    using Type = T;
+
+    static constexpr Index index = PropertyIndex;
+
+    /**
+     * @brief Whether the column of the property can be typed (see column()).
+     */
+    static constexpr bool isTyped = std::is_same_v<T, double> || std::is_same_v<T, space::vec3>;
+
+    /**
+     * @brief Gives the column of the property in a property table.
+     * @note Creates the column if it does not exist and types it (see PropertyTable::Column::setType()) if the type of the
+     *       property can be stored in a typed array (see isTyped).
+     * @warning Creating or typing a column allocates it; thus, it cannot happen on multiple threads.
+     * @throws If the column stores a property with a different type.
+     */
+    static Column& column(PropertyTable& table) {
+        auto& ans = table.column(index);
+        if constexpr (isTyped)
+            ans.setType(PropertyTable::Property::typeOf<T>());
+        return ans;
+    }
+
+    /**
+     * @brief Gives the property of a column row, if any.
+     * @param column The column of the property index (can be nullptr).
+     * @param id The row.
+     * @return The property or std::nullopt if there is no property at the row.
+     * @throws If the property of the row has a different type.
+     */
+    static std::optional<T> find(const Column* column, const Id id) {
+        if (!column || !column->has(id))
+            return std::nullopt;
+        if (const auto values = column->template values<T>())
+            return values[id];
+        if (const auto property = column->find(id))
+            if (const auto ans = property->template valueIf<T>())
+                return ans;
+        throw std::runtime_error("The property set at index: " + std::to_string(index) + " has a different type than the requested one.");
+    }
+
+    /**
+     * @brief Gives the property of a property table row, if any.
+     * @return The property or std::nullopt if there is no property at the row.
+     * @throws If the property of the row has a different type.
+     */
+    static std::optional<T> find(const PropertyTable& table, const Id id) {
+        return find(table.column(index), id);
+    }
+
+    /**
+     * @brief Gives the property of a Node, if any.
+     * @return The property or std::nullopt if there is no property at the Node.
+     * @throws If the property of the Node has a different type.
+     */
+    static std::optional<T> find(const Node& node) {
+        return find(node.table(), node.id());
+    }
+
+    /**
+     * @brief Gives the property of a column row.
+     * @param column The column of the property index (can be nullptr).
+     * @param id The row.
+     * @throws If there is no property at the row or it has a different type.
+     */
+    static T get(const Column* column, const Id id) {
+        if (const auto ans = find(column, id))
+            return *ans;
+        throw std::runtime_error("There is no property set at index: " + std::to_string(index) + ".");
+    }
+
+    /**
+     * @brief Gives the property of a property table row.
+     * @throws If there is no property at the row or it has a different type.
+     */
+    static T get(const PropertyTable& table, const Id id) {
+        return get(table.column(index), id);
+    }
+
+    /**
+     * @brief Gives the property of a Node.
+     * @throws If there is no property at the Node or it has a different type.
+     */
+    static T get(const Node& node) {
+        return get(node.table(), node.id());
+    }
+
+    /**
+     * @brief Gives the property of a column row, or the fallback if there is no property at the row.
+     * @param column The column of the property index (can be nullptr).
+     * @throws If the property of the row has a different type.
+     */
+    static T getOr(const Column* column, const Id id, const T& fallback) {
+        return find(column, id).value_or(fallback);
+    }
+
+    /**
+     * @brief Gives the property of a property table row, or the fallback if there is no property at the row.
+     * @throws If the property of the row has a different type.
+     */
+    static T getOr(const PropertyTable& table, const Id id, const T& fallback) {
+        return getOr(table.column(index), id, fallback);
+    }
+
+    /**
+     * @brief Gives the property of a Node, or the fallback if there is no property at the Node.
+     * @throws If the property of the Node has a different type.
+     */
+    static T getOr(const Node& node, const T& fallback) {
+        return getOr(node.table(), node.id(), fallback);
+    }
+
+    /**
+     * @brief Whether a Node has the property.
+     * @throws If the property of the Node has a different type.
+     */
+    static bool has(const Node& node) {
+        return find(node).has_value();
+    }
+
+    /**
+     * @brief Sets the property of a column row.
+     * @warning The column must be the column of the property index.
+     * @throws If the column is typed with a different type.
+     */
+    static void set(Column& column, const Id id, const T& value) {
+        column.set(id, value);
+    }
+
+    /**
+     * @brief Sets the property of a property table row.
+     * @note Types the column (see column()).
+     * @throws If the column stores a property with a different type.
+     */
+    static void set(PropertyTable& table, const Id id, const T& value) {
+        set(column(table), id, value);
+    }
+
+    /**
+     * @brief Sets the property of a Node.
+     * @throws If the column is typed with a different type.
+     */
+    static void set(Node& node, const T& value) {
+        node.at(index).setValue(value);
+    }
+};
+
+} // namespace rbs::configuration
+
+#endif // PROPERTYKEY_H
@@ -0,0 +1,320 @@
+//
+//  PropertyTable.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "PropertyTable.h"
+#include <atomic>
+#include <limits>
+#include <utility>
+
+namespace rbs::configuration {
+
+namespace {
+
+/**
+ * @brief Gives a new row ids revision.
+ */
+PropertyTable::Revision nextRevision() {
+    static std::atomic<PropertyTable::Revision> lastRevision{0};
+    return ++lastRevision;
+}
+
+/**
+ * @brief Gives the values moved to their new positions.
+ * @param order The old position of each new value.
+ * @return The moved values or an empty vector if there are no values.
+ */
+template<typename T>
+std::vector<T> permuted(const std::vector<T>& values, const PropertyTable::Ids& order) {
+    std::vector<T> ans;
+    if (values.empty())
+        return ans;
+    ans.reserve(order.size());
+    for (const auto id : order)
+        ans.emplace_back(values[id]);
+    return ans;
+}
+
+/**
+ * @brief Gives the value of a property stored in a typed column.
+ * @throws If the property has a different type than the column.
+ */
+template<typename T>
+T typedValue(const PropertyTable::Property& property) {
+    if (!property.is<T>())
+        throw std::runtime_error("The property has a different type than the column.");
+    return property.value<T>();
+}
+
+} // namespace
+
+PropertyTable::Column::Column()
+    : p_active{false}
+    , p_type{Type::None}
+    , p_values{}
+    , p_reals{}
+    , p_vectors{}
+    , p_presence{}
+{
+}
+
+PropertyTable::Property PropertyTable::Column::at(const PropertyTable::Id id) const {
+    if (!has(id))
+        throw std::runtime_error("The is no property set at row: " + std::to_string(id) + ".");
+    switch (p_type) {
+    case Type::Double: return p_reals[id];
+    case Type::Vector3D: return p_vectors[id];
+    default: return p_values[id];
+    }
+}
+
+bool PropertyTable::Column::isActive() const {
+    return p_active;
+}
+
+size_t PropertyTable::Column::size() const {
+    return p_presence.size();
+}
+
+PropertyTable::Type PropertyTable::Column::type() const {
+    return p_type;
+}
+
+PropertyTable::Reference PropertyTable::Column::at(const PropertyTable::Id id) {
+    if (id >= p_presence.size())
+        throw std::out_of_range("The column has no row " + std::to_string(id) + ".");
+    return Reference(*this, id);
+}
+
+void PropertyTable::Column::erase(const PropertyTable::Id id) {
+    if (has(id)) {
+        if (p_type == Type::None)
+            p_values[id].clear();
+        p_presence[id] = false;
+    }
+}
+
+void PropertyTable::Column::permute(const PropertyTable::Ids &order) {
+    if (!p_active)
+        return;
+
+    p_values = permuted(p_values, order);
+    p_reals = permuted(p_reals, order);
+    p_vectors = permuted(p_vectors, order);
+    p_presence = permuted(p_presence, order);
+}
+
+void PropertyTable::Column::resize(const size_t size) {
+    p_active = true;
+    switch (p_type) {
+    case Type::Double: p_reals.resize(size); break;
+    case Type::Vector3D: p_vectors.resize(size); break;
+    default: p_values.resize(size);
+    }
+    p_presence.resize(size, false);
+}
+
+void PropertyTable::Column::set(const PropertyTable::Id id, const PropertyTable::Property &property) {
+    if (id >= p_presence.size())
+        throw std::out_of_range("The column has no row " + std::to_string(id) + ".");
+    if (property.isEmpty()) {
+        erase(id);
+        return;
+    }
+
+    switch (p_type) {
+    case Type::Double:
+        p_reals[id] = typedValue<double>(property);
+        break;
+    case Type::Vector3D:
+        p_vectors[id] = typedValue<space::vec3>(property);
+        break;
+    default:
+        p_values[id] = property;
+    }
+    p_presence[id] = true;
+}
+
+void PropertyTable::Column::setType(const PropertyTable::Type type) {
+    if (type == p_type)
+        return;
+    if (type != Type::Double && type != Type::Vector3D)
+        throw std::invalid_argument("Only the double and space::vec3 properties can be stored in a typed column.");
+    if (p_type != Type::None)
+        throw std::runtime_error("The column is already typed with another type.");
+
+    const auto size = p_presence.size();
+    for (size_t id = 0; id < size; id++) {
+        if (p_presence[id] && p_values[id].type() != type)
+            throw std::runtime_error("The property set at row: " + std::to_string(id) + " has a different type than the column.");
+    }
+
+    p_type = type;
+    if (type == Type::Double) {
+        p_reals.resize(size);
+        for (size_t id = 0; id < size; id++) {
+            if (p_presence[id])
+                p_reals[id] = p_values[id].value<double>();
+        }
+    } else {
+        p_vectors.resize(size);
+        for (size_t id = 0; id < size; id++) {
+            if (p_presence[id])
+                p_vectors[id] = p_values[id].value<space::vec3>();
+        }
+    }
+    std::vector<Property>().swap(p_values);
+}
+
+PropertyTable::Reference::Reference(PropertyTable::Column &column, const PropertyTable::Id id)
+    : p_column{&column}
+    , p_id{id}
+{
+}
+
+PropertyTable::Reference &PropertyTable::Reference::operator =(const PropertyTable::Reference &other) {
+    p_column->set(p_id, other.property());
+    return *this;
+}
+
+PropertyTable::Reference &PropertyTable::Reference::operator =(const PropertyTable::Property &property) {
+    p_column->set(p_id, property);
+    return *this;
+}
+
+bool PropertyTable::Reference::hasValue() const {
+    return p_column->has(p_id);
+}
+
+bool PropertyTable::Reference::isEmpty() const {
+    return !hasValue();
+}
+
+PropertyTable::Type PropertyTable::Reference::type() const {
+    return property().type();
+}
+
+void PropertyTable::Reference::clear() {
+    p_column->erase(p_id);
+}
+
+PropertyTable::Reference::operator Property() const {
+    return property();
+}
+
+PropertyTable::Reference::operator std::string() const {
+    return std::string(property());
+}
+
+PropertyTable::Property PropertyTable::Reference::property() const {
+    return p_column->has(p_id) ? std::as_const(*p_column).at(p_id) : Property{};
+}
+
+PropertyTable::PropertyTable()
+    : p_columns{}
+    , p_initialPositions{}
+    , p_revision{nextRevision()}
+{
+}
+
+PropertyTable::Id PropertyTable::append(const PropertyTable::Position &initialPosition) {
+    const auto id = p_initialPositions.size();
+    if (id >= std::numeric_limits<Id>::max())
+        throw std::overflow_error("The property table cannot store more than " + std::to_string(std::numeric_limits<Id>::max()) + " rows.");
+
+    p_initialPositions.emplace_back(initialPosition);
+    std::for_each(p_columns.begin(), p_columns.end(), [&](Column& column) {
+        if (column.isActive())
+            column.resize(id + 1);
+    });
+    return static_cast<Id>(id);
+}
+
+PropertyTable::Property PropertyTable::at(const PropertyTable::Id id, const PropertyTable::Index index) const {
+    if (const auto ans = column(index))
+        if (ans->has(id))
+            return ans->at(id);
+    throw std::runtime_error("The is no property set at index: " + std::to_string(index) + ".");
+}
+
+const PropertyTable::Column *PropertyTable::column(const PropertyTable::Index index) const {
+    if (index < p_columns.size() && p_columns[index].isActive())
+        return &p_columns[index];
+    return nullptr;
+}
+
+bool PropertyTable::has(const PropertyTable::Id id, const PropertyTable::Index index) const {
+    const auto ans = column(index);
+    return ans && ans->has(id);
+}
+
+std::vector<PropertyTable::Index> PropertyTable::indices(const PropertyTable::Id id) const {
+    std::vector<Index> ans;
+    for (Index index = 0; index < p_columns.size(); index++) {
+        if (has(id, index))
+            ans.emplace_back(index);
+    }
+    return ans;
+}
+
+const PropertyTable::Position &PropertyTable::initialPosition(const PropertyTable::Id id) const {
+    return p_initialPositions.at(id);
+}
+
+PropertyTable::Revision PropertyTable::revision() const {
+    return p_revision;
+}
+
+size_t PropertyTable::size() const {
+    return p_initialPositions.size();
+}
+
+PropertyTable::Reference PropertyTable::at(const PropertyTable::Id id, const PropertyTable::Index index) {
+    return column(index).at(id);
+}
+
+PropertyTable::Column &PropertyTable::column(const PropertyTable::Index index) {
+    if (index >= p_columns.size())
+        p_columns.resize(index + 1);
+
+    auto& ans = p_columns[index];
+    if (!ans.isActive())
+        ans.resize(p_initialPositions.size());
+    return ans;
+}
+
+void PropertyTable::erase(const PropertyTable::Id id, const PropertyTable::Index index) {
+    if (index < p_columns.size())
+        p_columns[index].erase(id);
+}
+
+void PropertyTable::permute(const PropertyTable::Ids &order) {
+    if (order.size() != size())
+        throw std::out_of_range("The order must have one entry per row of the property table.");
+    std::vector<bool> seen(order.size(), false);
+    for (const auto id : order) {
+        if (id >= order.size() || seen[id])
+            throw std::runtime_error("The order is not a permutation of the property table rows.");
+        seen[id] = true;
+    }
+
+    std::vector<Position> initialPositions;
+    initialPositions.reserve(order.size());
+    for (const auto id : order)
+        initialPositions.emplace_back(p_initialPositions[id]);
+    p_initialPositions.swap(initialPositions);
+    std::for_each(p_columns.begin(), p_columns.end(), [&order](Column& column) {
+        column.permute(order);
+    });
+    p_revision = nextRevision();
+}
+
+void PropertyTable::reserve(const size_t size) {
+    p_initialPositions.reserve(size);
+}
+
+} // namespace rbs::configuration
@@ -0,0 +1,402 @@
+//
+//  PropertyTable.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef PROPERTYTABLE_H
+#define PROPERTYTABLE_H
+
+#include "../variables/SimVariant.h"
+#include "../variables/Variant.h"
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+/**
+ * The configuration namespace provides the means to create configurations and use them.
+ */
+namespace rbs::configuration {
+
+/**
+ * @brief The PropertyTable stores the properties of a set of Nodes in a columnar (i.e., structure of arrays) layout.
+ * @details Each row of the table belongs to a Node and is addressed by its dense id, each column stores one property
+ *          index of all the rows in a contiguous array. Accessing the same property of consecutive nodes therefore walks
+ *          a contiguous memory block instead of one map per node.
+ * @note The property indices are used directly as the column positions; thus, they should be small (e.g., an enum).
+ * @note Adding a new column does not move the existing ones.
+ * @note The columns of the fixed-type properties should be typed (see Column::setType()); the generic access to them
+ *       (see at()) goes through a Reference.
+ * @warning Appending rows may reallocate the columns; the references to the properties are only valid until the next append.
+ */
+class PropertyTable
+{
+public:
+    using Id = std::uint32_t;
+    using Ids = std::vector<Id>;
+    using Index = size_t;
+    using Position = variables::Variant;
+    using Property = variables::SimVariant;
+    using Revision = size_t;
+
+    using Type = Property::Type;
+
+    class Reference;
+
+    /**
+     * @brief The Column stores one property index for all of the rows.
+     * @details The properties are stored as Property (i.e., SimVariant) values, unless the column is typed (see
+     *          setType()); a typed column stores the double or space::vec3 values directly in a contiguous array, which
+     *          is read without checking the type of each value (see values()).
+     */
+    class Column {
+    public:
+
+        /**
+         * @brief The constructor.
+         * @note The column will be inactive (i.e., not storing any row) until it is resized.
+         */
+        Column();
+
+        /**
+         * @brief Gives the property of a row.
+         * @throws If there is no property stored at the row.
+         */
+        Property at(const Id id) const;
+
+        /**
+         * @brief Gives a pointer to the property of a row.
+         * @return The pointer to the property or nullptr if the row has no property or the column is typed.
+         */
+        const Property* find(const Id id) const {
+            return (p_type == Type::None && has(id)) ? &p_values[id] : nullptr;
+        }
+
+        /**
+         * @brief Whether the row has the property.
+         */
+        bool has(const Id id) const {
+            return id < p_presence.size() && p_presence[id];
+        }
+
+        /**
+         * @brief Whether the column is in use.
+         */
+        bool isActive() const;
+
+        /**
+         * @brief Gives the number of rows.
+         */
+        size_t size() const;
+
+        /**
+         * @brief Gives the type of the values if the column is typed, or Type::None otherwise.
+         */
+        Type type() const;
+
+        /**
+         * @brief Gives the values of the rows if the column is typed with T.
+         * @note Only the rows having the property (see has()) hold a value.
+         * @tparam T The value type (i.e., double or space::vec3).
+         * @return The pointer to the first value or nullptr if the column is not typed with T.
+         */
+        template<typename T>
+        const T* values() const noexcept {
+            if constexpr (std::is_same_v<T, double>)
+                return (p_type == Type::Double) ? p_reals.data() : nullptr;
+            else if constexpr (std::is_same_v<T, space::vec3>)
+                return (p_type == Type::Vector3D) ? p_vectors.data() : nullptr;
+            else
+                return nullptr;
+        }
+
+        /**
+         * @brief Gives direct access to the property of a row.
+         * @throws If the column has no such row.
+         */
+        Reference at(const Id id);
+
+        /**
+         * @brief Erases the property of a row.
+         */
+        void erase(const Id id);
+
+        /**
+         * @brief Moves the rows to new positions.
+         * @param order The old row of each new row.
+         */
+        void permute(const Ids& order);
+
+        /**
+         * @brief Resizes and activates the column.
+         */
+        void resize(const size_t size);
+
+        /**
+         * @brief Sets the property of a row.
+         * @note Setting an empty property erases the property of the row.
+         * @throws If the column has no such row or is typed with another type than the one of the property.
+         */
+        void set(const Id id, const Property& property);
+
+        /**
+         * @brief Sets the property of a row.
+         * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+         * @throws If the column has no such row or is typed with another type than the one of the value.
+         */
+        template<typename T>
+        void set(const Id id, const T& value) {
+            if constexpr (Property::typeOf<T>() == Type::Double) {
+                if (p_type == Type::Double && id < p_presence.size()) {
+                    p_reals[id] = static_cast<double>(value);
+                    p_presence[id] = true;
+                    return;
+                }
+            } else if constexpr (Property::typeOf<T>() == Type::Vector3D) {
+                if (p_type == Type::Vector3D && id < p_presence.size()) {
+                    p_vectors[id] = value;
+                    p_presence[id] = true;
+                    return;
+                }
+            }
+            set(id, Property(value));
+        }
+
+        /**
+         * @brief Stores the values of the column in a typed array.
+         * @note Converts the stored properties; does nothing if the column is already typed with the type.
+         * @param type The type of the values (i.e., Type::Double or Type::Vector3D).
+         * @throws If the type cannot be stored in a typed array, the column is typed with another type or a stored
+         *          property has another type.
+         */
+        void setType(const Type type);
+
+    private:
+        bool p_active;                          // Whether the column is in use.
+        Type p_type;                            // The type of the values of a typed column, or Type::None.
+        std::vector<Property> p_values;         // The properties of the rows (untyped column).
+        std::vector<double> p_reals;            // The values of the rows (Type::Double column).
+        std::vector<space::vec3> p_vectors;     // The values of the rows (Type::Vector3D column).
+        std::vector<unsigned char> p_presence;  // Whether the row has a property (byte per row to allow parallel writes).
+    };
+
+    /**
+     * @brief The Reference gives direct access to the property of a row, whether or not the column is typed.
+     * @details The Reference reads and writes the column like a Property; thus, it can be used where a Property&
+     *          would be (e.g., node.at(index) = value).
+     * @warning The Reference is only valid as long as the row is (see PropertyTable).
+     */
+    class Reference {
+    public:
+
+        /**
+         * @brief The constructor.
+         * @param column The column of the property.
+         * @param id The row of the property.
+         */
+        Reference(Column& column, const Id id);
+
+        /**
+         * @brief The default copy constructor.
+         */
+        Reference(const Reference& other) = default;
+
+        /**
+         * @brief Sets the property to the value of another one.
+         * @throws If the column is typed with another type than the one of the value.
+         */
+        Reference &operator =(const Reference& other);
+
+        /**
+         * @brief Sets the property.
+         * @note Setting an empty property erases the property of the row.
+         * @throws If the column is typed with another type than the one of the property.
+         */
+        Reference &operator =(const Property& property);
+
+        /**
+         * @brief Sets a new value.
+         * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+         * @throws If the column is typed with another type than the one of the value.
+         */
+        template<typename T>
+        Reference &operator =(const T& value) {
+            setValue(value);
+            return *this;
+        }
+
+        /**
+         * @brief Whether the property has a value.
+         */
+        bool hasValue() const;
+
+        /**
+         * @brief Whether the property holds a value of type T.
+         */
+        template<typename T>
+        bool is() const {
+            return property().template is<T>();
+        }
+
+        /**
+         * @brief Whether the property is empty.
+         */
+        bool isEmpty() const;
+
+        /**
+         * @brief Gives the type of the holding value.
+         */
+        Type type() const;
+
+        /**
+         * @brief Gives the value.
+         * @throws If the property is empty, the value has a different type or the integer does not fit T.
+         */
+        template<typename T>
+        T value() const {
+            return property().template value<T>();
+        }
+
+        /**
+         * @brief Gives the value if it is set with the requested type.
+         * @return The value or std::nullopt if the property is empty, has a different type or the integer does not fit T.
+         */
+        template<typename T>
+        std::optional<T> valueIf() const {
+            return property().template valueIf<T>();
+        }
+
+        /**
+         * @brief Erases the property.
+         */
+        void clear();
+
+        /**
+         * @brief Sets a new value.
+         * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+         * @throws If the column is typed with another type than the one of the value.
+         */
+        template<typename T>
+        void setValue(const T& value) {
+            p_column->set(p_id, value);
+        }
+
+        /**
+         * @brief Gives a copy of the property.
+         */
+        operator Property() const;
+
+        /**
+         * @brief Converts the property to a string.
+         */
+        operator std::string() const;
+
+    private:
+        /**
+         * @brief Gives a copy of the property (an empty one if the row has no property).
+         */
+        Property property() const;
+
+        Column* p_column;   // The column of the property.
+        Id p_id;            // The row of the property.
+    };
+
+    /**
+     * @brief The constructor.
+     */
+    PropertyTable();
+
+    /**
+     * @brief Appends a row to the table.
+     * @param initialPosition The initial position of the new row.
+     * @return The id of the new row.
+     * @throws If the table is full (i.e., the number of rows exceeds the Id range).
+     */
+    Id append(const Position& initialPosition);
+
+    /**
+     * @brief Gives the property of a row at a specific index.
+     * @throws If there is no property stored at the index.
+     */
+    Property at(const Id id, const Index index) const;
+
+    /**
+     * @brief Gives the column of a specific index.
+     * @return The column or nullptr if no property has been stored at the index.
+     */
+    const Column* column(const Index index) const;
+
+    /**
+     * @brief Whether the row contains a property at a specific index.
+     */
+    bool has(const Id id, const Index index) const;
+
+    /**
+     * @brief Gives the indices of the properties stored at a row.
+     */
+    std::vector<Index> indices(const Id id) const;
+
+    /**
+     * @brief Gives the initial position of a row.
+     */
+    const Position& initialPosition(const Id id) const;
+
+    /**
+     * @brief Gives the revision of the row ids.
+     * @details The revision is unique among all the tables and changes each time the rows are permuted (see permute());
+     *          thus, the ids stored elsewhere (e.g., the neighbor ids of a BondGraph) are valid as long as the revision
+     *          they were taken at does not change.
+     */
+    Revision revision() const;
+
+    /**
+     * @brief Gives the number of rows.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gives direct access to the property of a row at a specific index.
+     * @note Creates the column if it does not exist.
+     */
+    Reference at(const Id id, const Index index);
+
+    /**
+     * @brief Gives direct access to the column of a specific index.
+     * @note Creates the column if it does not exist.
+     */
+    Column& column(const Index index);
+
+    /**
+     * @brief Erases the property of a row at a specific index.
+     */
+    void erase(const Id id, const Index index);
+
+    /**
+     * @brief Moves the rows to new positions (i.e., gives new ids to the rows).
+     * @note Gives a new revision to the table (see revision()).
+     * @warning The Nodes still point to their old ids; update them accordingly.
+     * @param order The old id of each new row.
+     * @throws If the order is not a permutation of the row ids.
+     */
+    void permute(const Ids& order);
+
+    /**
+     * @brief Reserves the memory for a number of rows.
+     */
+    void reserve(const size_t size);
+
+private:
+    using Columns = std::deque<Column>;
+
+    Columns p_columns;                          // The columns indexed by the property index.
+    std::vector<Position> p_initialPositions;   // The initial positions of the rows.
+    Revision p_revision;                        // The revision of the row ids.
+};
+
+} // namespace rbs::configuration
+
+#endif // PROPERTYTABLE_H
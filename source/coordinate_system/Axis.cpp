@@ -8,57 +8,61 @@
 
 #include "Axis.h"
 #include "../space/Point.h"
-#include <set>
+#include <algorithm>
+#include <cmath>
 
 namespace rbs::coordinate_system {
 
 Axis::Axis()
-    : p_values{}
+    : p_spacing{0}
+    , p_values{}
 {}
 
+Axis::Axis(const Axis::ValueSet &values)
+    : p_spacing{0}
+    , p_values{values.begin(), values.end()}
+{
+    updateSpacing();
+}
+
 Axis::Axis(const Axis::Values &values)
-    : p_values{values}
-{}
+    : p_spacing{0}
+    , p_values{values}
+{
+    std::sort(p_values.begin(), p_values.end());
+    p_values.erase(std::unique(p_values.begin(), p_values.end()), p_values.end());
+    updateSpacing();
+}
 
 Axis::Value Axis::at(const Index index) const {
     if (p_values.empty())
         throw std::range_error("The axis is empty.");
 
-    if (index < p_values.size()) {
-        auto itr = p_values.begin();
-        std::advance(itr, index);
-        return *itr;
-    }
+    if (index < p_values.size())
+        return p_values[index];
     throw std::range_error("Index is out of IndexRange.");
 }
 
 Axis::OptionalValue Axis::closestTo(const Axis::Value value) const {
     if (p_values.empty())
         return nullptr;
-
-    const auto itr = p_values.lower_bound(value);
-    if (itr == p_values.begin())
-        return std::make_shared<Value>(*itr);
-
-    const auto preItr = std::prev(itr);
-    if (itr == p_values.end() || value - *preItr <= *itr - value)
-        return std::make_shared<Value>(*preItr);
-    return std::make_shared<Value>(*itr);
+    return std::make_shared<Value>(p_values[closestIndex(value)]);
 }
 
 Axis::OptionalIndex Axis::closestIndexTo(const Axis::Value value) const {
-    const auto v = closestTo(value);
-    return (v) ? indexOf(*v) : nullptr;
+    if (p_values.empty())
+        return nullptr;
+    return std::make_shared<Index>(closestIndex(value));
 }
 
 bool Axis::contains(const Axis::Value value) const {
-    return p_values.find(value) != p_values.end();
+    return indexOf(value) != nullptr;
 }
 
 bool Axis::covers(const Axis::Value value) const {
     if (isEmpty())
         return false;
-    return *p_values.begin() <= value && value <= *p_values.rbegin();
+    return p_values.front() <= value && value <= p_values.back();
 }
 
 bool Axis::covers(const Axis::Range range) const {
@@ -66,28 +70,21 @@ bool Axis::covers(const Axis::Range range) const {
 }
 
 bool Axis::covers(const Axis::Value start, const Axis::Value end) const {
-    return covers(start) || covers(end) || ( start < *p_values.begin() &&  *p_values.rbegin()< end );
+    if (isEmpty())
+        return false;
+    return covers(start) || covers(end) || ( start < p_values.front() && p_values.back() < end );
 }
 
 Axis::OptionalIndexRange Axis::indicesBetween(const Axis::Value low, const Axis::Value high) const {
     if (high < low)
         return indicesBetween(high, low);
 
-    OptionalIndexRange range;
     if (covers(low, high)) {
-        const auto l = closestTo(low);
-        const auto h = closestTo(high);
-        if (l && h) {
-            auto start = iteratorFor(*l);
-            const auto end = iteratorFor(*h);
-
-            if (start == end && !(low <= *start && *end <= high)) {
-                return nullptr;
-            } else if (++start == end && *start < low && high < *end) {
-                return nullptr;
-            }
-            return std::make_shared<IndexRange>(std::distance(p_values.begin(),iteratorFor(*l)), std::distance(p_values.begin(), end));
-        }
+        const auto l = closestIndex(low);
+        const auto h = closestIndex(high);
+        if (l == h && !(low <= p_values[l] && p_values[h] <= high))
+            return nullptr;
+        return std::make_shared<IndexRange>(l, h);
     }
     return nullptr;
 }
@@ -96,6 +93,10 @@ bool Axis::isEmpty() const {
     return p_values.empty();
 }
 
+bool Axis::isUniform() const {
+    return p_spacing > 0;
+}
+
 Axis::OptionalIndexRange Axis::neighborRange(const Axis::Value centre, const Axis::Value radius) const {
     return indicesBetween(centre - radius, centre + radius);
 }
@@ -108,6 +109,10 @@ size_t Axis::size() const {
     return p_values.size();
 }
 
+Axis::Value Axis::spacing() const {
+    return p_spacing;
+}
+
 const Axis::Values& Axis::values() const {
     return p_values;
 }
@@ -118,19 +123,16 @@ Axis::ValuePtrs Axis::valuesBetween(const Axis::Value low, const Axis::Value hig
 
     ValuePtrs values;
     if (covers(low, high)) {
-        const auto l = closestTo(low);
-        const auto h = closestTo(high);
-        if (l && h) {
-            const auto end = iteratorFor(*h);
-            for(auto itr = iteratorFor(*l); itr != end; itr++) {
-                values.emplace_back(std::make_shared<Value>(*itr));
-            }
-            if (values.size() == 2 && *values[0] < low && high < *values[1]) {
-                values.clear();
-            }
-            if (values.size() == 1 && !(low <= *values[0] && *values[0] <= high)) {
-                values.clear();
-            }
+        const auto l = closestIndex(low);
+        const auto h = closestIndex(high);
+        for(auto index = l; index != h; index++) {
+            values.emplace_back(std::make_shared<Value>(p_values[index]));
+        }
+        if (values.size() == 2 && *values[0] < low && high < *values[1]) {
+            values.clear();
+        }
+        if (values.size() == 1 && !(low <= *values[0] && *values[0] <= high)) {
+            values.clear();
         }
     }
     return values;
@@ -138,38 +140,70 @@ Axis::ValuePtrs Axis::valuesBetween(const Axis::Value low, const Axis::Value hig
 
 void Axis::clear() {
     p_values.clear();
+    p_spacing = 0;
 }
 
 void Axis::exclude(const Axis::Value value) {
-    p_values.erase(value);
+    if (const auto index = indexOf(value)) {
+        p_values.erase(p_values.begin() + static_cast<std::ptrdiff_t>(*index));
+        updateSpacing();
+    }
 }
 
 Axis::Index Axis::include(const Axis::Value value) {
-    const auto set = p_values.insert(value);
-    return static_cast<Index>(std::distance(p_values.begin(), set.first));
-}
-
-Axis::Values::iterator Axis::iteratorFor(const Axis::Value value) const {
-    const auto f = p_values.find(value);
-    if(f != p_values.end())
-        return f;
-    throw std::range_error("The value is not on the axis.");
+    const auto index = lowerBound(value);
+    if (index == p_values.size() || p_values[index] != value) {
+        p_values.insert(p_values.begin() + static_cast<std::ptrdiff_t>(index), value);
+        updateSpacing();
+    }
+    return index;
 }
 
-Axis::Values::iterator Axis::iteratorOf(const Axis::Index index) const {
-    if (index < p_values.size()) {
-        auto itr = p_values.begin();
-        std::advance(itr, index);
-        return itr;
-    }
-    throw std::range_error("Index is out of range.");
+Axis::Index Axis::closestIndex(const Axis::Value value) const {
+    const auto index = lowerBound(value);
+    if (index == 0)
+        return index;
+    if (index == p_values.size() || value - p_values[index - 1] <= p_values[index] - value)
+        return index - 1;
+    return index;
 }
 
 Axis::OptionalIndex Axis::indexOf(const Axis::Value value) const {
-    const auto v = p_values.find(value);
-    if (v == p_values.end())
+    const auto index = lowerBound(value);
+    if (index == p_values.size() || p_values[index] != value)
         return nullptr;
-    return std::make_shared<Index>(static_cast<Index>(std::distance(p_values.begin(), v)));
+    return std::make_shared<Index>(index);
+}
+
+Axis::Index Axis::lowerBound(const Axis::Value value) const {
+    if (!isUniform())
+        return static_cast<Index>(std::lower_bound(p_values.begin(), p_values.end(), value) - p_values.begin());
+
+    // The guess is at most one value away, since the values deviate less than the spacing from the uniform grid.
+    const auto size = p_values.size();
+    const auto ratio = (value - p_values.front()) / p_spacing;
+    auto index = (ratio > 0) ? ((ratio < size) ? static_cast<Index>(std::ceil(ratio)) : size) : Index(0);
+    while (index > 0 && !(p_values[index - 1] < value))
+        index--;
+    while (index < size && p_values[index] < value)
+        index++;
+    return index;
+}
+
+void Axis::updateSpacing() {
+    p_spacing = 0;
+    if (p_values.size() < 2)
+        return;
+
+    const auto spacing = (p_values.back() - p_values.front()) / (p_values.size() - 1);
+    // A relative tolerance of 1e-12 of the largest magnitude; the Stencil computes the offsets from the spacing instead of
+    // the values.
+    const auto tolerance = 1e-12 * std::max({std::abs(p_values.front()), std::abs(p_values.back()), spacing});
+    for (size_t index = 1; index < p_values.size() - 1; index++) {
+        if (std::abs(p_values[index] - (p_values.front() + index * spacing)) > tolerance)
+            return;
+    }
+    p_spacing = spacing;
 }
 
 } // namespace rbs::coordinate_system
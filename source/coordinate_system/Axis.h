@@ -9,6 +9,7 @@
 #ifndef AXIS_H
 #define AXIS_H
 
+#include <memory>
 #include <set>
 #include <vector>
 
@@ -28,6 +29,9 @@ namespace rbs::coordinate_system {
 
 /**
  * @brief The Axis class provides the means to mamge coordinate systems axies and their data.
+ * @details The values are kept sorted in a contiguous array; thus, accessing a value by its index is O(1) and finding the
+ *          index of a value is a binary search. If the values are uniformly spaced (e.g., generated by the grid generators),
+ *          the index of a value is computed directly from the spacing instead.
  * @note The axis is defined in a 3D space where but it presents a 1D space.
  */
 class Axis
@@ -44,7 +48,8 @@ public:
     using Range = std::pair<Value, Value>;
     using OptionalRange = std::shared_ptr<Range>;
 
-    using Values = std::set<Value>;
+    using Values = std::vector<Value>;
+    using ValueSet = std::set<Value>;
     using ValuePtr = std::shared_ptr<Value>;
     using ValuePtrs = std::vector<ValuePtr>;
 
@@ -57,6 +62,13 @@ public:
      * @brief The constructor.
      * @param values The valuse on the axis.
      */
+    Axis(const ValueSet & values);
+
+    /**
+     * @brief The constructor.
+     * @note The values will be sorted and the duplicates removed.
+     * @param values The valuse on the axis.
+     */
     Axis(const Values & values);
 
     /**
@@ -112,6 +124,14 @@ public:
      */
     bool isEmpty() const;
 
+    /**
+     * @brief Whether the values on the axis are uniformly spaced or not.
+     * @note The values must match the uniform grid up to a relative tolerance of 1e-12; thus, a
+     *       neighbor search using the spacing (see Stencil) finds the same neighbors as the one using the values.
+     * @note An axis with less than two values is not uniform.
+     */
+    bool isUniform() const;
+
     /**
      * @brief Gives the index of the values around a centre.
      * @param centre The centre of neighborhood.
@@ -131,6 +151,12 @@ public:
      */
     size_t size() const;
 
+    /**
+     * @brief Gives the distance between the values of a uniform axis.
+     * @return The distance or zero if the axis is not uniform.
+     */
+    Value spacing() const;
+
     /**
      * @brief Gives the values on the axis.
      */
@@ -163,17 +189,11 @@ public:
 private:
 
     /**
-     * @brief Give the iterator for a given value.
-     * @throws If the value does not exist on the axis.
+     * @brief Gives the index of the closest value to the given value.
+     * @note If the value is in the middle of two values, the smaller one will be taken.
+     * @warning The axis must not be empty.
      */
-    Values::iterator iteratorFor(const Value value) const;
-
-    /**
-     * @brief Gives the iterator of  value having its index.
-     * @param index The index.
-     * @throws If the axis is empty.
-     */
-    Values::iterator iteratorOf(const Index index) const;
+    Index closestIndex(const Value value) const;
 
     /**
      * @brief Gives the index of a specific value.
@@ -182,7 +202,19 @@ private:
      */
     OptionalIndex indexOf(const Value value) const;
 
-    Values p_values;    // The values on the axis.
+    /**
+     * @brief Gives the index of the first value that is not less than the given value.
+     * @return The index or size() if all the values are less than the given value.
+     */
+    Index lowerBound(const Value value) const;
+
+    /**
+     * @brief Checks whether the values are uniformly spaced and updates the spacing.
+     */
+    void updateSpacing();
+
+    Value p_spacing;    // The distance between the values if they are uniformly spaced, zero otherwise.
+    Values p_values;    // The sorted values on the axis.
 
 };
 
@@ -145,8 +145,7 @@ CoordinateSystem::Points CoordinateSystem::getAllPoints(const bool includeChildr
 
     // Extracting the local points.
     gridPoints.reserve(p_indices.size());
-    for(const auto& linearIndex: p_indices) {
-        const auto index = convertInverce(linearIndex);
+    for(const auto& index: p_indices.indices()) {
         gridPoints.emplace_back(Point{p_axes[0].at(index[0]), p_axes[1].at(index[1]), p_axes[2].at(index[2]) });
     }
 
@@ -192,8 +191,12 @@ CoordinateSystem::Points CoordinateSystem::getNeighborPoints(const Point &centre
 }
 
 CoordinateSystem::Points CoordinateSystem::getNeighborPoints(const Point &searchcentre, const Vector radiusVector, const std::function<bool (Point, Point)> &include, const Point &neighborhoodCentre) const {
-    using Points = std::vector<Point>;
     Points neighbors;
+    getNeighborPoints(searchcentre, radiusVector, include, neighborhoodCentre, neighbors);
+    return neighbors;
+}
+
+void CoordinateSystem::getNeighborPoints(const Point &searchcentre, const Vector radiusVector, const std::function<bool (Point, Point)> &include, const Point &neighborhoodCentre, Points &points) const {
     if (pointsSize()) {
         const auto& posVector = searchcentre.positionVector();
         const auto range_0 = p_axes[0].neighborRange(posVector[0], radiusVector[0]);
@@ -210,24 +213,28 @@ CoordinateSystem::Points CoordinateSystem::getNeighborPoints(const Point &search
                     gridIndex[1] = itr1;
                     for(itr2 = range_2->first; itr2 <= range_2->second; itr2++) {
                         gridIndex[2] = itr2;
-                        if (p_indices.find(convert(gridIndex)) != p_indices.end()) {
+                        if (p_indices.contains(gridIndex)) {
                             neighbor.positionVector()[0] = p_axes[0].at(gridIndex[0]);
                             neighbor.positionVector()[1] = p_axes[1].at(gridIndex[1]);
                             neighbor.positionVector()[2] = p_axes[2].at(gridIndex[2]);
                             if (include(neighborhoodCentre, neighbor))
-                                neighbors.emplace_back(neighbor);
+                                points.emplace_back(neighbor);
                         }
                     }
                 }
             }
         }
     }
-    return neighbors;
 }
 
 CoordinateSystem::LinearIndices CoordinateSystem::getNeighborPointIndices(const Point &searchCentre, const Vector radiusVector, const std::function<bool (const Point&, const Point&)> &include, const Point &neighborhoodCentre) const
 {
-    LinearIndices indices;
+    std::vector<LinearIndex> indices;
+    getNeighborPointIndices(searchCentre, radiusVector, include, neighborhoodCentre, indices);
+    return LinearIndices(indices.begin(), indices.end());
+}
+
+void CoordinateSystem::getNeighborPointIndices(const Point &searchCentre, const Vector radiusVector, const std::function<bool (const Point &, const Point &)> &include, const Point &neighborhoodCentre, std::vector<LinearIndex> &indices) const {
     if (pointsSize()) {
         const auto& posVector = searchCentre.positionVector();
         const auto range_0 = p_axes[0].neighborRange(posVector[0], radiusVector[0]);
@@ -235,38 +242,71 @@ CoordinateSystem::LinearIndices CoordinateSystem::getNeighborPointIndices(const
         const auto range_2 = p_axes[2].neighborRange(posVector[2], radiusVector[2]);
 
         if (range_0 && range_1 && range_2) {
+            // The last axis is the outer loop; thus, the indices are appended in ascending order.
             Point neighbor;
             Index gridIndex;
-            LinearIndex gridLinearIndex;
             size_t itr0, itr1, itr2;
-            for(itr0 = range_0->first; itr0 <= range_0->second; itr0++ ) {
-                gridIndex[0] = itr0;
+            for(itr2 = range_2->first; itr2 <= range_2->second; itr2++ ) {
+                gridIndex[2] = itr2;
                 for(itr1 = range_1->first; itr1 <= range_1->second; itr1++) {
                     gridIndex[1] = itr1;
-                    for(itr2 = range_2->first; itr2 <= range_2->second; itr2++) {
-                        gridIndex[2] = itr2;
-                        gridLinearIndex = convert(gridIndex);
-                        if (p_indices.find(gridLinearIndex) != p_indices.end()) {
+                    for(itr0 = range_0->first; itr0 <= range_0->second; itr0++) {
+                        gridIndex[0] = itr0;
+                        if (p_indices.contains(gridIndex)) {
                             neighbor.positionVector()[0] = p_axes[0].at(gridIndex[0]);
                             neighbor.positionVector()[1] = p_axes[1].at(gridIndex[1]);
                             neighbor.positionVector()[2] = p_axes[2].at(gridIndex[2]);
                             if (include(neighborhoodCentre, neighbor))
-                                indices.insert(gridLinearIndex);
+                                indices.emplace_back(convert(gridIndex));
                         }
                     }
                 }
             }
         }
     }
-    return indices;
 }
 
-CoordinateSystem::OptionalPoint CoordinateSystem::getPoint(const size_t &index) const {
-    if (index < p_indices.size()) {
-        auto itr = p_indices.begin();
-        std::advance(itr, index);
-        return getPointAt(*itr);
+bool CoordinateSystem::getNeighborPointIndices(const LinearIndex centre, const Stencil &stencil, std::vector<LinearIndex> &indices) const {
+    const auto centreIndex = convertInverce(centre);
+    if (!stencil.fits(centreIndex, Index{p_axes[0].size(), p_axes[1].size(), p_axes[2].size()}))
+        return false;
+
+    Index neighborIndex;
+    unsigned char i;
+    for (const auto& offset : stencil.offsets()) {
+        for (i = 0; i < 3; i++)
+            neighborIndex[i] = centreIndex[i] + offset[i];
+        if (p_indices.contains(neighborIndex))
+            indices.emplace_back(convert(neighborIndex));
     }
+    return true;
+}
+
+Stencil CoordinateSystem::getNeighborStencil(const Vector radiusVector, const std::function<bool (const Point &, const Point &)> &include) const {
+    if (!isUniform())
+        throw std::runtime_error("Cannot create a neighborhood stencil on a non-uniform grid.");
+    return Stencil(Vector{p_axes[0].spacing(), p_axes[1].spacing(), p_axes[2].spacing()}, radiusVector, include);
+}
+
+size_t CoordinateSystem::gridPositionOf(const LinearIndex linearIndex) const {
+    const auto index = convertInverce(linearIndex);
+    if (index[0] >= p_axes[0].size() || index[1] >= p_axes[1].size() || index[2] >= p_axes[2].size())
+        throw std::out_of_range("The linear index is out of the grid.");
+    return gridPositionOf(index);
+}
+
+CoordinateSystem::LinearIndex CoordinateSystem::linearIndexAt(const size_t gridPosition) const {
+    if (gridPosition >= gridSize())
+        throw std::out_of_range("The grid position is out of the grid.");
+    const auto layerSize = p_axes[0].size() * p_axes[1].size();
+    const auto index2 = gridPosition / layerSize;
+    const auto index1 = (gridPosition - index2 * layerSize) / p_axes[0].size();
+    return convert({gridPosition - index2 * layerSize - index1 * p_axes[0].size(), index1, index2});
+}
+
+CoordinateSystem::OptionalPoint CoordinateSystem::getPoint(const size_t &index) const {
+    if (index < p_indices.size())
+        return getPointAt(p_indices.indices()[index]);
     throw std::range_error("Index is out of IndexRange.");
 }
 
@@ -275,7 +315,7 @@ CoordinateSystem::OptionalPoint CoordinateSystem::getPointAt(const Index &index)
 }
 
 CoordinateSystem::OptionalPoint CoordinateSystem::getPointAt(const LinearIndex &linearIndex) const {
-    if (p_indices.find(linearIndex) == p_indices.end())
+    if (!p_indices.contains(convertInverce(linearIndex)))
         return nullptr;
 
     const auto positionVector = composePositionVectorAt(convertInverce(linearIndex));
@@ -295,6 +335,14 @@ bool CoordinateSystem::isGlobal() const {
     return false;
 }
 
+bool CoordinateSystem::isUniform() const {
+    if (p_type != Cartesian)
+        return false;
+    return std::all_of(std::begin(p_axes), std::end(p_axes), [](const Axis& axis) {
+        return axis.size() < 2 || axis.isUniform();
+    });
+}
+
 const CoordinateSystem::Point &CoordinateSystem::origin() const {
     return p_origin;
 }
@@ -425,7 +473,7 @@ void CoordinateSystem::exclude(const Vector &vector) noexcept {
                 index[i] = *p_axes[i].closestIndexTo(vector[i]);
             }
         }
-        p_indices.erase(convert(index));
+        p_indices.erase(index);
     }  catch (...) {
     }
 }
@@ -447,7 +495,7 @@ void CoordinateSystem::exclude(std::function<bool (const Point &)> remove, const
                 localIndex[2] = itr2;
                 localPoint[2] = p_axes[2].at(itr0);
                 if (remove(localPoint))
-                    p_indices.insert(convert(localIndex));
+                    p_indices.insert(localIndex);
             }
         }
     }
@@ -478,7 +526,7 @@ void CoordinateSystem::include(const Vector &vector) {
 
     if (forwardDirections[0] || forwardDirections[1] || forwardDirections[2])
         forwardLinearIndices(index, forwardDirections);
-    p_indices.insert(convert(index));
+    p_indices.insert(index);
 }
 
 void CoordinateSystem::include(std::function<bool (const Point &)> add, const bool includeToChildrenGrids) {
@@ -498,7 +546,7 @@ void CoordinateSystem::include(std::function<bool (const Point &)> add, const bo
                 localIndex[2] = itr2;
                 localPoint[2] = p_axes[2].at(itr2);
                 if (add(localPoint))
-                    p_indices.insert(convert(localIndex));
+                    p_indices.insert(localIndex);
             }
         }
     }
@@ -566,6 +614,10 @@ CoordinateSystem::Index CoordinateSystem::convertInverce(const LinearIndex index
     return {index - c1() * y - c2() * z, y, z};
 }
 
+size_t CoordinateSystem::gridPositionOf(const Index &index) const {
+    return index[0] + p_axes[0].size() * (index[1] + p_axes[1].size() * index[2]);
+}
+
 std::string CoordinateSystem::branchInfo(const size_t tab) const {
     const auto tabs = [](const size_t tab) {
         std::string ans = "";
@@ -582,9 +634,9 @@ std::string CoordinateSystem::branchInfo(const size_t tab) const {
     };
     const auto getPoints = [&tabs, &tab, &getPoint](const CoordinateSystem& cs) {
         std::string ans = tabs(tab + 1) + "Points: {";
-        const auto begin = cs.p_indices.begin();
-        for (auto itr = begin; itr != cs.p_indices.end(); itr++) {
-            ans = ans + "\n" + tabs(tab + 2) + std::to_string(std::distance(begin, itr)) + ": " + getPoint(cs, *itr);
+        const auto& indices = cs.p_indices.indices();
+        for (size_t i = 0; i < indices.size(); i++) {
+            ans = ans + "\n" + tabs(tab + 2) + std::to_string(i) + ": " + getPoint(cs, convert(indices[i]));
         }
         ans = ans + "\n" + tabs(tab + 1) + "},\n";
         return ans;
@@ -614,7 +666,7 @@ std::string CoordinateSystem::branchInfo(const size_t tab) const {
     std::string ans = tabs(tab) + ((isGlobal())? "GlobalCoordinateSystem: {\n" : "LocalCoordinateSystem: {\n");
     ans = ans + getInfo(*this);
 
-    if (!p_indices.empty())
+    if (!p_indices.isEmpty())
         ans = ans + getPoints(*this);
 
     if (!p_children.empty()) {
@@ -640,29 +692,15 @@ CoordinateSystem::OptionalVector CoordinateSystem::composePositionVectorAt(const
 }
 
 void CoordinateSystem::forwardLinearIndices(const Index &index, bool *directions) {
-    LinearIndices removeables;
+    const auto indices = p_indices.indices();
+    p_indices.clear();
     unsigned char i;
-    for( auto itr = p_indices.rbegin(); itr != p_indices.rend(); itr++ ) {
-        const auto oldIndex = convertInverce(*itr);
-        LinearIndex newLinearIndex = *itr;
+    for (auto forwarded : indices) {
         for (i = 0; i < 3; i++) {
-            if (directions[i] && index[i] <= oldIndex[i]) {
-                if (i == 0)
-                    newLinearIndex += 1;
-                else if (i == 1)
-                    newLinearIndex += c1();
-                else
-                    newLinearIndex += c2();
-            }
+            if (directions[i] && index[i] <= forwarded[i])
+                forwarded[i] += 1;
         }
-        if (newLinearIndex != *itr) {
-            removeables.insert(*itr);
-            removeables.erase(newLinearIndex);
-            p_indices.insert(newLinearIndex);
-        }
-    }
-    for(auto itr = removeables.begin(); itr != removeables.end(); itr++) {
-        p_indices.erase(*itr);
+        p_indices.insert(forwarded);
     }
 }
 
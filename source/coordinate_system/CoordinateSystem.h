@@ -11,6 +11,9 @@
 
 #include "Axis.h"
 #include "convertors.h"
+#include "Occupancy.h"
+#include "Stencil.h"
+#include <algorithm>
 #include <functional>
 #include <map>
 #include <vector>
@@ -185,6 +188,17 @@ public:
      */
     Points getNeighborPoints(const Point& searchCentre, const Vector radiusVector, const std::function<bool(Point, Point)>& include, const Point& neighborhoodCentre) const;
 
+    /**
+     * @brief Gets the neighbor points into a reusable list.
+     * @note The centre of neighborhood will be passed to the include function.
+     * @param searchCentre The centre of the neighborhood that will be used for extracting the cuboid neighborhood.
+     * @param radiusVector The cuboid radius of the neighborhood (i.e., from the centre to one of the neighborhood corner).
+     * @param include A function that receives centre and neighbor and returns a boolean indicating whether to add the point to the neighborhood or not.
+     * @param neighborhoodCentre The centre of the neighborhood.
+     * @param points The list to append the neighbor points to; it is not cleared.
+     */
+    void getNeighborPoints(const Point& searchCentre, const Vector radiusVector, const std::function<bool(Point, Point)>& include, const Point& neighborhoodCentre, Points& points) const;
+
     /**
      * @brief Gets the neighbors indexes of a neighborhood.
      * @note The centre of neighborhood will be passed to the include function.
@@ -198,6 +212,36 @@ public:
      */
     LinearIndices getNeighborPointIndices(const Point& searchCentre, const Vector radiusVector, const std::function<bool(const Point&, const Point&)>& include, const Point& neighborhoodCentre) const;
 
+    /**
+     * @brief Gets the neighbors indexes of a neighborhood into a reusable list.
+     * @note The centre of neighborhood will be passed to the include function.
+     * @param searchCentre The centre of the neighborhood that will be used for extracting the cuboid neighborhood.
+     * @param radiusVector The cuboid radius of the neighborhood (i.e., from the centre to one of the neighborhood corner).
+     * @param include A function that receives centre and neighbor and returns a boolean indicating whether to add the point to the neighborhood or not.
+     * @param neighborhoodCentre The centre of the neighborhood.
+     * @param indices The list to append the neighbors indexes to, in ascending order; it is not cleared.
+     */
+    void getNeighborPointIndices(const Point& searchCentre, const Vector radiusVector, const std::function<bool(const Point&, const Point&)>& include, const Point& neighborhoodCentre, std::vector<LinearIndex>& indices) const;
+
+    /**
+     * @brief Gets the neighbors indexes of a point using the offsets of a stencil.
+     * @note Only the existence of the offset points is checked; the neighborhood function is already applied on the stencil.
+     * @param centre The linear index of the centre of the neighborhood.
+     * @param stencil The stencil of the neighborhood (see getNeighborStencil()).
+     * @param indices The list to append the neighbors indexes to, in ascending order.
+     * @return False, without appending any index, if the stencil does not fit in the grid around the centre (i.e., the
+     *          centre is close to the grid boundary); true otherwise.
+     */
+    bool getNeighborPointIndices(const LinearIndex centre, const Stencil& stencil, std::vector<LinearIndex>& indices) const;
+
+    /**
+     * @brief Gets the stencil of a neighborhood on the grid of this coordinate system.
+     * @param radiusVector The cuboid radius of the neighborhood (i.e., from the centre to one of the neighborhood corner).
+     * @param include A function that receives centre and neighbor and returns a boolean indicating whether to add the point to the neighborhood or not.
+     * @throws If the grid is not uniform (see isUniform()).
+     */
+    Stencil getNeighborStencil(const Vector radiusVector, const std::function<bool(const Point&, const Point&)>& include) const;
+
     /**
      * @brief Creates a mapper to the point's linear indexes
      * @tparam T The type of the map values.
@@ -207,14 +251,48 @@ public:
     template<typename T>
     std::map<LinearIndex, T> getLinearindexMapper(const std::function<T(const space::Point<3>& point)> constructor) {
         std::map<LinearIndex, T> mapper;
-        std::transform(p_indices.begin(), p_indices.end(), std::inserter(mapper, mapper.begin()), [&constructor, this](const LinearIndex& linearIndex) {
-            const auto index = convertInverce(linearIndex);
+        const auto& indices = p_indices.indices();
+        std::transform(indices.begin(), indices.end(), std::inserter(mapper, mapper.end()), [&constructor, this](const Index& index) {
             const auto point = space::Point<3>{p_axes[0].at(index[0]), p_axes[1].at(index[1]), p_axes[2].at(index[2])};
-            return std::pair(linearIndex, constructor(point));
+            return std::pair(convert(index), constructor(point));
         });
         return mapper;
     }
 
+    /**
+     * @brief Creates a dense mapper from the grid positions (see gridPositionOf()) to custom values.
+     * @tparam T The type of the mapper values.
+     * @param constructor A function that recives the points location and creates the mapper values.
+     * @return A list of gridSize() values, where the positions without a point hold the default value of T.
+     * @note Unlike getLinearindexMapper(), finding a value is a plain array access; the memory grows with the grid
+     *          size rather than the number of points, which is of the same order for the meshed parts.
+     */
+    template<typename T>
+    std::vector<T> getGridPositionMapper(const std::function<T(const space::Point<3>& point)> constructor) {
+        std::vector<T> mapper(gridSize());
+        const auto& indices = p_indices.indices();
+        std::for_each(indices.begin(), indices.end(), [&mapper, &constructor, this](const Index& index) {
+            const auto point = space::Point<3>{p_axes[0].at(index[0]), p_axes[1].at(index[1]), p_axes[2].at(index[2])};
+            mapper[gridPositionOf(index)] = constructor(point);
+        });
+        return mapper;
+    }
+
+    /**
+     * @brief Gives the position of a grid point on the dense grid (i.e., from 0 to gridSize() - 1).
+     * @note The grid positions are in the same order as the linear indices.
+     * @param linearIndex The linear index of the grid point.
+     * @throws If the linear index is out of the grid.
+     */
+    size_t gridPositionOf(const LinearIndex linearIndex) const;
+
+    /**
+     * @brief Gives the linear index of a position on the dense grid (see gridPositionOf()).
+     * @param gridPosition The position on the dense grid.
+     * @throws If the position is out of the grid.
+     */
+    LinearIndex linearIndexAt(const size_t gridPosition) const;
+
     /**
      * @brief Gets the point at index.
      * @param index The point index, from 0 to point size - 1.
@@ -240,6 +318,12 @@ public:
      */
     bool isGlobal() const;
 
+    /**
+     * @brief Whether the coordinate system is Cartesian and all of its axes are uniformly spaced.
+     * @note The axes that hold at most one value are uniform.
+     */
+    bool isUniform() const;
+
     /**
      * @brief Gives direct access to the origion.
      * @throws Incase of attempting to change the global coordinate system origin.
@@ -417,6 +501,12 @@ private:
      */
     static Index convertInverce(const LinearIndex index);
 
+    /**
+     * @brief Gives the position of a grid point on the dense grid (see gridPositionOf()).
+     * @note The index is not checked.
+     */
+    size_t gridPositionOf(const Index& index) const;
+
     /**
      * @brief Provides the string representation of the tree of this coordinate system tree.
      */
@@ -429,7 +519,7 @@ private:
     OptionalVector composePositionVectorAt(const Index & index) const;
 
     /**
-     * @brief Forwards the linear indices that are bigger than index and is specific direction only.
+     * @brief Forwards the indices that are bigger than index and is specific direction only.
      * @note This will use only and only if we need to adjust the indices due to appending new value ot the axes.
      * @param index The index of the point.
      * @param directions The directions to forward.
@@ -445,7 +535,7 @@ private:
     Children p_children;            // The children of this coordinte system.
     Vector p_i;                     // The i vector of this coordinate system in its parent coordinate system.
     Vector p_j;                     // The j vector of this coordinate system in its parent coordinate system.
-    LinearIndices p_indices;        // The linaer indices of the existing points.
+    Occupancy p_indices;            // The indices of the existing points.
     Vector p_k;                     // The k vector of this coordinate system in its parent coordinate system.
     Point p_origin;                 // The origin of the coordinate system in its parent coordinate system.
     CoordinateSystemPtr p_parent;   // The parent of this coordinate system, nullptr if its Global.
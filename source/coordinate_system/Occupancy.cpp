@@ -0,0 +1,191 @@
+//
+//  Occupancy.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 01.02.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "Occupancy.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace rbs::coordinate_system {
+
+namespace {
+
+constexpr size_t blockBits = 3;                             // The number of bits of the grid index inside a block.
+constexpr size_t blockSize = size_t(1) << blockBits;        // The number of grid points along each axis of a block.
+constexpr size_t blockMask = blockSize - 1;                 // The mask of the grid index inside a block.
+constexpr size_t keyBits = 21;                              // The number of bits of each block position in the key.
+constexpr size_t keyMask = (size_t(1) << keyBits) - 1;      // The mask of each block position in the key.
+constexpr size_t maxIndex = size_t(1) << (keyBits + blockBits); // The upper limit of the grid index along each axis.
+
+/**
+ * @brief Whether the index can be stored in the occupancy.
+ */
+bool isStorable(const space::Index<3>& index) {
+    return index[0] < maxIndex && index[1] < maxIndex && index[2] < maxIndex;
+}
+
+} // namespace
+
+Occupancy::Occupancy()
+    : p_blocks{}
+    , p_lastKey{std::numeric_limits<Key>::max()}
+    , p_lastSlot{0}
+    , p_size{0}
+    , p_slots{}
+    , p_sorted{}
+    , p_sortedValid{true}
+{
+}
+
+size_t Occupancy::blocksSize() const {
+    return p_blocks.size();
+}
+
+bool Occupancy::contains(const Occupancy::Index &index) const {
+    if (!isStorable(index))
+        return false;
+    const auto slot = slotOf(keyOf(index));
+    if (slot == p_blocks.size())
+        return false;
+    return (p_blocks[slot].words[wordOf(index)] >> bitOf(index)) & 1;
+}
+
+const Occupancy::Indices &Occupancy::indices() const {
+    if (p_sortedValid)
+        return p_sorted;
+
+    p_sorted.clear();
+    p_sorted.reserve(p_size);
+    Index index;
+    std::for_each(p_blocks.begin(), p_blocks.end(), [&index, this](const Block& block) {
+        const auto origin = blockIndexOf(block.key);
+        for (size_t word = 0; word < block.words.size(); word++) {
+            index[2] = origin[2] + word;
+            for (auto bits = block.words[word]; bits; bits &= bits - 1) {
+                size_t bit = 0;
+                while (!((bits >> bit) & 1))
+                    bit++;
+                index[0] = origin[0] + (bit & blockMask);
+                index[1] = origin[1] + (bit >> blockBits);
+                p_sorted.emplace_back(index);
+            }
+        }
+    });
+    std::sort(p_sorted.begin(), p_sorted.end(), [](const Index& lhs, const Index& rhs) {
+        if (lhs[2] != rhs[2])
+            return lhs[2] < rhs[2];
+        if (lhs[1] != rhs[1])
+            return lhs[1] < rhs[1];
+        return lhs[0] < rhs[0];
+    });
+    p_sortedValid = true;
+    return p_sorted;
+}
+
+bool Occupancy::isEmpty() const {
+    return p_size == 0;
+}
+
+size_t Occupancy::size() const {
+    return p_size;
+}
+
+void Occupancy::clear() {
+    p_blocks.clear();
+    p_lastKey = std::numeric_limits<Key>::max();
+    p_lastSlot = 0;
+    p_size = 0;
+    p_slots.clear();
+    p_sorted.clear();
+    p_sortedValid = true;
+}
+
+bool Occupancy::erase(const Occupancy::Index &index) {
+    if (!isStorable(index))
+        return false;
+    const auto key = keyOf(index);
+    const auto slot = slotOf(key);
+    if (slot == p_blocks.size())
+        return false;
+
+    auto& word = p_blocks[slot].words[wordOf(index)];
+    const auto bit = std::uint64_t(1) << bitOf(index);
+    if (!(word & bit))
+        return false;
+
+    word &= ~bit;
+    p_size--;
+    p_sortedValid = false;
+    if (--p_blocks[slot].count == 0) { // removing the empty block by moving the last block to its slot.
+        p_slots.erase(key);
+        if (slot != p_blocks.size() - 1) {
+            p_blocks[slot] = p_blocks.back();
+            p_slots[p_blocks[slot].key] = slot;
+        }
+        p_blocks.pop_back();
+        p_lastKey = std::numeric_limits<Key>::max();
+    }
+    return true;
+}
+
+bool Occupancy::insert(const Occupancy::Index &index) {
+    if (!isStorable(index))
+        throw std::out_of_range("The grid index " + std::string(index) + " is out of the occupancy range.");
+
+    const auto key = keyOf(index);
+    if (key != p_lastKey) {
+        p_lastSlot = slotOf(key);
+        if (p_lastSlot == p_blocks.size()) {
+            p_blocks.emplace_back(Block{key, Words{}, 0});
+            p_slots.emplace(key, p_lastSlot);
+        }
+        p_lastKey = key;
+    }
+
+    auto& block = p_blocks[p_lastSlot];
+    auto& word = block.words[wordOf(index)];
+    const auto bit = std::uint64_t(1) << bitOf(index);
+    if (word & bit)
+        return false;
+
+    word |= bit;
+    block.count++;
+    p_size++;
+    p_sortedValid = false;
+    return true;
+}
+
+Occupancy::Index Occupancy::blockIndexOf(const Occupancy::Key key) {
+    Index ans;
+    ans[0] = (key & keyMask) << blockBits;
+    ans[1] = ((key >> keyBits) & keyMask) << blockBits;
+    ans[2] = ((key >> (2 * keyBits)) & keyMask) << blockBits;
+    return ans;
+}
+
+size_t Occupancy::bitOf(const Occupancy::Index &index) {
+    return (index[0] & blockMask) + ((index[1] & blockMask) << blockBits);
+}
+
+Occupancy::Key Occupancy::keyOf(const Occupancy::Index &index) {
+    return Key(index[0] >> blockBits)
+            | Key(index[1] >> blockBits) << keyBits
+            | Key(index[2] >> blockBits) << (2 * keyBits);
+}
+
+size_t Occupancy::wordOf(const Occupancy::Index &index) {
+    return index[2] & blockMask;
+}
+
+size_t Occupancy::slotOf(const Occupancy::Key key) const {
+    const auto slot = p_slots.find(key);
+    return (slot != p_slots.end()) ? slot->second : p_blocks.size();
+}
+
+} // namespace rbs::coordinate_system
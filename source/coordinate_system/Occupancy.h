@@ -0,0 +1,136 @@
+//
+//  Occupancy.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 01.02.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef OCCUPANCY_H
+#define OCCUPANCY_H
+
+#include "../space/Index.h"
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The coordinate_system namespace provides the means to work with different coordinate systems.
+ */
+namespace rbs::coordinate_system {
+
+/**
+ * @brief The Occupancy stores which of the grid points of a coordinate system exist, as a block-sparse bitmask.
+ * @details The grid is tiled into blocks of 8x8x8 grid points and only the blocks having at least one point are stored,
+ *          each as a 512 bit mask; the blocks are found by a hash of their position. Thus, testing and adding a point is
+ *          O(1), and the memory used by sparse shapes (e.g., rings or notched plates) stays proportional to the number
+ *          of occupied blocks rather than the whole grid.
+ * @note The indices are given in the order of their third, second and then first component (i.e., the order of the
+ *          coordinate system linear indices).
+ */
+class Occupancy
+{
+public:
+    using Index = space::Index<3>;
+    using Indices = std::vector<Index>;
+
+    /**
+     * @brief The constructor.
+     */
+    Occupancy();
+
+    /**
+     * @brief Gives the number of the stored blocks.
+     */
+    size_t blocksSize() const;
+
+    /**
+     * @brief Whether the grid point at an index exists.
+     */
+    bool contains(const Index& index) const;
+
+    /**
+     * @brief Gives the indices of the existing grid points.
+     * @note The sorted indices are cached until the next modification; thus, this is not safe to call from multiple
+     *          threads at the same time after a modification.
+     */
+    const Indices& indices() const;
+
+    /**
+     * @brief Whether there is no grid point.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Gives the number of the existing grid points.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Removes all the grid points.
+     */
+    void clear();
+
+    /**
+     * @brief Removes the grid point at an index.
+     * @return Whether the grid point existed.
+     */
+    bool erase(const Index& index);
+
+    /**
+     * @brief Adds the grid point at an index.
+     * @return Whether the grid point was added (i.e., it did not exist).
+     */
+    bool insert(const Index& index);
+
+private:
+    using Key = std::uint64_t;
+    using Words = std::array<std::uint64_t, 8>;
+
+    /**
+     * @brief The Block stores the existence of the grid points of an 8x8x8 tile, a word per layer along the third axis.
+     */
+    struct Block {
+        Key key;        // The position of the block.
+        Words words;    // The bitmask of the grid points.
+        size_t count;   // The number of existing grid points.
+    };
+
+    /**
+     * @brief Gives the position of a block along the axes.
+     */
+    static Index blockIndexOf(const Key key);
+
+    /**
+     * @brief Gives the bit of an index inside its word.
+     */
+    static size_t bitOf(const Index& index);
+
+    /**
+     * @brief Gives the key of the block holding an index.
+     */
+    static Key keyOf(const Index& index);
+
+    /**
+     * @brief Gives the word of an index inside its block.
+     */
+    static size_t wordOf(const Index& index);
+
+    /**
+     * @brief Gives the position of the block holding an index on the blocks or the blocks size if there is no such block.
+     */
+    size_t slotOf(const Key key) const;
+
+    std::vector<Block> p_blocks;                // The occupied blocks.
+    Key p_lastKey;                              // The key of the last modified block.
+    size_t p_lastSlot;                          // The slot of the last modified block.
+    size_t p_size;                              // The number of existing grid points.
+    std::unordered_map<Key, size_t> p_slots;    // The position of each block on the blocks.
+    mutable Indices p_sorted;                   // The cached sorted indices.
+    mutable bool p_sortedValid;                 // Whether the cached sorted indices are up to date.
+};
+
+} // namespace rbs::coordinate_system
+
+#endif // OCCUPANCY_H
@@ -0,0 +1,59 @@
+//
+//  Stencil.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 01.02.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "Stencil.h"
+#include <cmath>
+
+namespace rbs::coordinate_system {
+
+Stencil::Stencil(const Stencil::Vector &spacing, const Stencil::Vector &radiusVector, const std::function<bool (const Stencil::Point &, const Stencil::Point &)> &include)
+    : p_offsets{}
+    , p_reach{}
+{
+    for (unsigned char i = 0; i < 3; i++)
+        p_reach[i] = (spacing[i] > 0) ? static_cast<size_t>(std::ceil(std::abs(radiusVector[i]) / spacing[i])) : 0;
+
+    const auto centre = Point{0, 0, 0};
+    Point neighbor;
+    Offset offset;
+    for (offset[2] = -std::ptrdiff_t(p_reach[2]); offset[2] <= std::ptrdiff_t(p_reach[2]); offset[2]++) {
+        for (offset[1] = -std::ptrdiff_t(p_reach[1]); offset[1] <= std::ptrdiff_t(p_reach[1]); offset[1]++) {
+            for (offset[0] = -std::ptrdiff_t(p_reach[0]); offset[0] <= std::ptrdiff_t(p_reach[0]); offset[0]++) {
+                bool inside = true;
+                for (unsigned char i = 0; i < 3; i++) {
+                    neighbor.positionVector()[i] = offset[i] * spacing[i];
+                    inside = inside && std::abs(neighbor.positionVector()[i]) <= std::abs(radiusVector[i]);
+                }
+                if (inside && include(centre, neighbor))
+                    p_offsets.emplace_back(offset);
+            }
+        }
+    }
+}
+
+bool Stencil::fits(const Stencil::Index &index, const Stencil::Index &sizes) const {
+    for (unsigned char i = 0; i < 3; i++) {
+        if (index[i] < p_reach[i] || index[i] + p_reach[i] >= sizes[i])
+            return false;
+    }
+    return true;
+}
+
+const Stencil::Offsets &Stencil::offsets() const {
+    return p_offsets;
+}
+
+const Stencil::Index &Stencil::reach() const {
+    return p_reach;
+}
+
+size_t Stencil::size() const {
+    return p_offsets.size();
+}
+
+} // namespace rbs::coordinate_system
@@ -0,0 +1,81 @@
+//
+//  Stencil.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 01.02.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef STENCIL_H
+#define STENCIL_H
+
+#include "../space/Index.h"
+#include "../space/Point.h"
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/**
+ * The coordinate_system namespace provides the means to work with different coordinate systems.
+ */
+namespace rbs::coordinate_system {
+
+/**
+ * @brief The Stencil holds the relative grid index offsets of the neighbors of a point on a uniform grid.
+ * @details On a uniformly spaced grid, the neighbors of all the points that are far enough from the grid boundary have
+ *          the same index offsets. Thus, the neighborhood function is evaluated once per offset and the neighbors of
+ *          each point are found by only checking which of the offset points exist.
+ * @note The offsets are sorted in the order of their third, second and then first component (i.e., the order of the
+ *          coordinate system linear indices).
+ * @warning The neighborhood function must only depend on the relative position of the neighbor to the centre.
+ */
+class Stencil
+{
+public:
+    using Index = space::Index<3>;
+    using Offset = std::array<std::ptrdiff_t, 3>;
+    using Offsets = std::vector<Offset>;
+    using Point = space::Point<3>;
+    using Vector = space::Vector<3>;
+
+    /**
+     * @brief The constructor.
+     * @note The axes with zero spacing have no neighbor along them (i.e., they hold only one value).
+     * @param spacing The distance between the grid values along each axis.
+     * @param radiusVector The cuboid radius of the neighborhood (i.e., from the centre to one of the neighborhood corner).
+     * @param include A function that receives centre and neighbor and returns a boolean indicating whether to add the point to the neighborhood or not.
+     */
+    Stencil(const Vector& spacing, const Vector& radiusVector, const std::function<bool(const Point&, const Point&)>& include);
+
+    /**
+     * @brief Whether all the offsets of a grid index are inside the grid.
+     * @param index The grid index of the centre.
+     * @param sizes The number of the grid values along each axis.
+     */
+    bool fits(const Index& index, const Index& sizes) const;
+
+    /**
+     * @brief Gives the offsets of the neighbors.
+     */
+    const Offsets& offsets() const;
+
+    /**
+     * @brief Gives the largest offset along each axis.
+     */
+    const Index& reach() const;
+
+    /**
+     * @brief Gives the number of the offsets.
+     */
+    size_t size() const;
+
+private:
+
+    Offsets p_offsets;  // The offsets of the neighbors.
+    Index p_reach;      // The largest offset along each axis.
+};
+
+} // namespace rbs::coordinate_system
+
+#endif // STENCIL_H
@@ -112,7 +112,7 @@ Vector multiply(const double factor, const Vector &vector) {
 }
 
 double projectionLength(const Vector &projectee, const Vector &base) {
-    const auto deltaTheta = abs(projectee[1] - base[1]);                  // the azimuthal angle between the two vector.
+    const auto deltaTheta = std::abs(projectee[1] - base[1]);                  // the azimuthal angle between the two vector.
     const auto u = unit(base);                                            // The unit vector of the base
     return (u[0] * projectee[0] * cos(deltaTheta) + u[2] * projectee[2]); // dot product.
 }
@@ -137,7 +137,7 @@ void CSVFile::eraseAllSubStr(std::string &mainStr, const std::string &toErase)
 
 void CSVFile::filterCellContnet(std::string &string) const {
     string.erase(std::remove_if(string.begin(), string.end(), [](char c){
-        return c == '\n' || c == '\r' || c == '\t'|| c == '\f'|| c == '\v';}));
+        return c == '\n' || c == '\r' || c == '\t'|| c == '\f'|| c == '\v';}), string.end());
     eraseAllSubStr(string, p_seperator);
 }
 
@@ -21,7 +21,7 @@ BaseFile::BaseFile(const std::string &name, const std::string &extension)
         return c == '.' || c == '!' || c == '@'|| c == '#'|| c == '$'
                 || c == '%' || c == '^' || c == '&' || c == '*' || c == '('
                 || c == ')' || c == '`' || c == '~' || c == '+' || c == '='
-                || c == '/' || c == '>' || c == '<' || c == ',';}));
+                || c == '/' || c == '>' || c == '<' || c == ',';}), p_extension.end());
 
     // If the file name is set to empty string change it to "un-named".
     if (p_name.compare("") == 0)
@@ -40,7 +40,7 @@ FileSeries<FileType>::FileSeries(const std::string &basename,
         return c == '.' || c == '!' || c == '@'|| c == '#'|| c == '$'
                 || c == '%' || c == '^' || c == '&' || c == '*' || c == '('
                 || c == ')' || c == '`' || c == '~' || c == '+' || c == '='
-                || c == '/' || c == '>' || c == '<' || c == ',';}));
+                || c == '/' || c == '>' || c == '<' || c == ',';}), p_extension.end());
 
     // If the file name is set to empty string change it to "un-named".
     if (p_basename.compare("") == 0)
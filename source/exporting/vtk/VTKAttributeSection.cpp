@@ -32,7 +32,7 @@ const std::string VTKAttributeSection::filterAttributeName(const std::string &na
         return c == ' ' || c == '.' || c == '!' || c == '@'|| c == '#'|| c == '$'
                 || c == '%' || c == '^' || c == '&' || c == '*' || c == '('
                 || c == ')' || c == '`' || c == '~' || c == '+' || c == '='
-                || c == '/' || c == '>' || c == '<' || c == ',';}));
+                || c == '/' || c == '>' || c == '<' || c == ',';}), ans.end());
 
     // If the file name is set to empty string change it to "un-named".
     if (ans.compare("") == 0)
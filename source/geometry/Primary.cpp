@@ -726,7 +726,7 @@ Primary &Primary::setPositionVector(const Primary::Vector3D &positionVector) {
 Primary &Primary::setThickness(Primary::Thickness thickness) {
     if (thickness < 0 && !space::isZero(thickness))
         throw std::out_of_range("Thickness cannot be negative.");
-    p_thickness = abs(thickness);
+    p_thickness = std::abs(thickness);
     correctShapeType();
     return *this;
 }
@@ -0,0 +1,160 @@
+//
+//  threads.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "threads.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace rbs::parallel {
+
+namespace {
+
+/**
+ * @brief The WorkerPool keeps the worker threads of the loops alive between the loops.
+ * @details The workers wait for a new generation of work; each one runs the task of its thread index, if the loop needs
+ *          it, and the last one done wakes up the calling thread.
+ */
+class WorkerPool
+{
+public:
+    using Task = std::function<void(size_t)>;
+
+    /**
+     * @brief Gives the pool shared by all the loops.
+     */
+    static WorkerPool& shared() {
+        static WorkerPool single;
+        return single;
+    }
+
+    ~WorkerPool() {
+        {
+            std::lock_guard<std::mutex> lock(p_mutex);
+            p_stop = true;
+        }
+        p_start.notify_all();
+        for (auto& worker : p_workers)
+            worker.join();
+    }
+
+    /**
+     * @brief Runs the task on the threads [0, threadsSize), the calling thread running the thread 0.
+     * @return Whether the pool ran the task; false if the pool is already running another task.
+     */
+    bool run(const size_t threadsSize, const Task& task) {
+        if (p_busy.exchange(true))
+            return false;
+
+        {
+            std::lock_guard<std::mutex> lock(p_mutex);
+            while (p_workers.size() + 1 < threadsSize) {
+                const auto thread = p_workers.size() + 1;
+                p_workers.emplace_back([this, thread, generation = p_generation] { work(thread, generation); });
+            }
+            p_task = &task;
+            p_threadsSize = threadsSize;
+            p_pending = threadsSize - 1;
+            p_generation++;
+        }
+        p_start.notify_all();
+
+        task(0);
+
+        {
+            std::unique_lock<std::mutex> lock(p_mutex);
+            p_done.wait(lock, [this] { return p_pending == 0; });
+            p_task = nullptr;
+        }
+        p_busy = false;
+        return true;
+    }
+
+private:
+
+    WorkerPool()
+        : p_busy{false}
+        , p_done{}
+        , p_generation{0}
+        , p_mutex{}
+        , p_pending{0}
+        , p_start{}
+        , p_stop{false}
+        , p_task{nullptr}
+        , p_threadsSize{0}
+        , p_workers{}
+    {
+    }
+
+    /**
+     * @brief The loop of a worker thread.
+     * @param thread The thread index the worker runs.
+     * @param generation The generation before the creation of the worker.
+     */
+    void work(const size_t thread, size_t generation) {
+        std::unique_lock<std::mutex> lock(p_mutex);
+        while (true) {
+            p_start.wait(lock, [&] { return p_stop || p_generation != generation; });
+            if (p_stop)
+                return;
+
+            generation = p_generation;
+            if (thread >= p_threadsSize)
+                continue;
+
+            const auto task = p_task;
+            lock.unlock();
+            (*task)(thread);
+            lock.lock();
+            if (--p_pending == 0)
+                p_done.notify_one();
+        }
+    }
+
+    std::atomic<bool> p_busy;           // Whether a task is running.
+    std::condition_variable p_done;     // Notified when the last worker is done.
+    size_t p_generation;                // The number of the tasks started.
+    std::mutex p_mutex;                 // Guards the state shared with the workers.
+    size_t p_pending;                   // The number of the workers still running the task.
+    std::condition_variable p_start;    // Notified when a task is started or the pool is stopped.
+    bool p_stop;                        // Whether the workers should return.
+    const Task* p_task;                 // The running task.
+    size_t p_threadsSize;               // The number of the threads running the task.
+    std::vector<std::thread> p_workers; // The workers; the worker i runs the thread i + 1.
+};
+
+} // namespace
+
+size_t hardwareThreadsSize() {
+    const auto size = std::thread::hardware_concurrency();
+    return (size) ? size : 1;
+}
+
+size_t threadsSizeFor(const size_t threadsSize, const size_t size) {
+    const auto threads = (threadsSize) ? threadsSize : hardwareThreadsSize();
+    return std::max<size_t>(1, std::min(threads, size));
+}
+
+void runOnThreads(const size_t threadsSize, const std::function<void(size_t)>& task) {
+    if (threadsSize <= 1) {
+        task(0);
+        return;
+    }
+    if (WorkerPool::shared().run(threadsSize, task))
+        return;
+
+    std::vector<std::thread> workers;
+    workers.reserve(threadsSize - 1);
+    for (size_t thread = 1; thread < threadsSize; thread++)
+        workers.emplace_back(task, thread);
+    task(0);
+    for (auto& worker : workers)
+        worker.join();
+}
+
+} // namespace rbs::parallel
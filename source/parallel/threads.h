@@ -0,0 +1,141 @@
+//
+//  threads.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef THREADS_H
+#define THREADS_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <vector>
+
+/**
+ * The parallel namespace provides the means to run the independent parts of a computation on multiple threads.
+ */
+namespace rbs::parallel {
+
+/**
+ * @brief The Scheduling denotes how the items of a loop are shared between the threads.
+ */
+enum class Scheduling {
+    Static,     // Each thread takes one consecutive range of the items (see forEachRange()).
+    Chunked,    // Each thread takes the next chunk of the items whenever it is done with its last one (see forEachChunk()).
+};
+
+/**
+ * @brief Gives the number of the threads that the hardware can run at the same time (at least one).
+ */
+size_t hardwareThreadsSize();
+
+/**
+ * @brief Gives the number of the threads to use for a number of items.
+ * @param threadsSize The requested number of threads; zero means as many as the hardware can run at the same time.
+ * @param size The number of the items.
+ * @return At least one and at most size threads (unless size is zero).
+ */
+size_t threadsSizeFor(const size_t threadsSize, const size_t size);
+
+/**
+ * @brief Runs a task once on each of the threads [0, threadsSize) and waits for all of them.
+ * @details The calling thread runs the thread 0 and the workers of a pool run the others; the workers are created on the
+ *          first use, grown on demand and kept for the whole run; thus, the loops of every step reuse the same threads.
+ *          If the pool is already running (e.g., a loop nested in a loop, or the loop of another thread), new threads are
+ *          created and joined for this call instead.
+ * @note The task must not throw.
+ * @param threadsSize The number of the threads (at least one).
+ * @param task The task receiving the thread index.
+ */
+void runOnThreads(const size_t threadsSize, const std::function<void(size_t)>& task);
+
+/**
+ * @brief Splits [0, size) into consecutive ranges and runs a function on each range on a separate thread.
+ * @details The i-th range is given to the i-th thread and the ranges follow each other in order; thus, the split only
+ *          depends on the size and the number of threads, and merging the per-thread results in the thread order
+ *          reproduces the serial order. The calling thread runs the first range itself and the workers of the pool the
+ *          others (see runOnThreads()).
+ * @note With a single thread the function is called on the calling thread without creating any thread.
+ * @param size The number of the items.
+ * @param threadsSize The requested number of threads (see threadsSizeFor()).
+ * @param function The function receiving the thread index, the begin and the end of its range.
+ * @throws The exception thrown by the function on the lowest thread index, after all the threads are done.
+ */
+template<typename Function>
+void forEachRange(const size_t size, const size_t threadsSize, const Function& function) {
+    const auto threads = threadsSizeFor(threadsSize, size);
+    if (threads <= 1) {
+        function(size_t(0), size_t(0), size);
+        return;
+    }
+
+    const auto chunk = size / threads;
+    const auto remainder = size % threads;
+    const auto beginOf = [chunk, remainder](const size_t thread) {
+        return thread * chunk + std::min(thread, remainder);
+    };
+
+    std::vector<std::exception_ptr> exceptions(threads);
+    runOnThreads(threads, [&](const size_t thread) {
+        try {
+            function(thread, beginOf(thread), beginOf(thread + 1));
+        } catch (...) {
+            exceptions[thread] = std::current_exception();
+        }
+    });
+
+    for (const auto& exception : exceptions) {
+        if (exception)
+            std::rethrow_exception(exception);
+    }
+}
+
+/**
+ * @brief Splits [0, size) into chunks and runs a function on the chunks on multiple threads, each thread taking the next
+ *        chunk whenever it is done with its last one.
+ * @details Unlike forEachRange(), the threads finishing early take over the remaining chunks; thus, it balances the loops
+ *          whose items have different costs. However, which thread runs a chunk depends on the timing.
+ *          The calling thread is one of the threads.
+ * @note With a single thread the function is called on the calling thread, chunk by chunk, without creating any thread.
+ * @param size The number of the items.
+ * @param chunkSize The number of the items of each chunk (at least one).
+ * @param threadsSize The requested number of threads (see threadsSizeFor()); at most one thread per chunk is used.
+ * @param function The function receiving the thread index, the begin and the end of a chunk.
+ * @throws The exception thrown by the function on the lowest thread index, after all the threads are done; the
+ *         thread throwing stops taking chunks.
+ */
+template<typename Function>
+void forEachChunk(const size_t size, const size_t chunkSize, const size_t threadsSize, const Function& function) {
+    const auto chunk = std::max<size_t>(1, chunkSize);
+    const auto chunksSize = (size + chunk - 1) / chunk;
+    std::atomic<size_t> next{0};
+    forEachRange(threadsSizeFor(threadsSize, chunksSize), threadsSizeFor(threadsSize, chunksSize), [&](const size_t thread, const size_t, const size_t) {
+        for (auto index = next++; index < chunksSize; index = next++)
+            function(thread, index * chunk, std::min(size, (index + 1) * chunk));
+    });
+}
+
+/**
+ * @brief Runs a function on the items of [0, size) on multiple threads with a scheduling.
+ * @param size The number of the items.
+ * @param threadsSize The requested number of threads (see threadsSizeFor()).
+ * @param scheduling How the items are shared between the threads (i.e., forEachRange() or forEachChunk()).
+ * @param chunkSize The number of the items of each chunk of the chunked scheduling.
+ * @param function The function receiving the thread index, the begin and the end of a range of items.
+ * @throws The exception thrown by the function (see forEachRange() and forEachChunk()).
+ */
+template<typename Function>
+void forEach(const size_t size, const size_t threadsSize, const Scheduling scheduling, const size_t chunkSize, const Function& function) {
+    if (scheduling == Scheduling::Static)
+        forEachRange(size, threadsSize, function);
+    else
+        forEachChunk(size, chunkSize, threadsSize, function);
+}
+
+} // namespace rbs::parallel
+
+#endif // THREADS_H
@@ -12,8 +12,10 @@
 #include "peridynamic/BondBased.h"
 #include "peridynamic/BoundaryDomain.h"
 #include "peridynamic/Exporter.h"
+#include "peridynamic/FractureEvents.h"
 #include "peridynamic/OrdinaryStateBased.h"
 #include "peridynamic/Property.h"
+#include "peridynamic/ShortRangeContact.h"
 #include "peridynamic/time_integrations/PDVelocityVerletAlgorithm.h"
 #include "peridynamic/time_integrations/PDEuler.h"
 
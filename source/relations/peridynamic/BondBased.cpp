@@ -7,17 +7,28 @@
 //
 
 #include "BondBased.h"
+#include "../../parallel/threads.h"
 
 namespace rbs::relations::peridynamic {
 
 BondBased::BondBased(BondBased::BondForceRelationship bondForceRelationship, BondBased::VolumeCorrection volumeCurrection, BondBased::PDPart &part, const bool override)
     : Base(0, part, [](const SimulationTime&, PDPart&) {} )
+    , p_blocks{}
     , p_bondForceRelationship{ bondForceRelationship }
+    , p_chunkSize{ 256 }
+    , p_damages{}
     , p_dt{ 0 }
+    , p_events{ nullptr }
+    , p_geometry{}
     , p_includeMaximumStretch{ false }
+    , p_kernel{ nullptr }
     , p_lastTime{ 0 }
     , p_maximumStretchIncluded{ false }
+    , p_pairs{}
+    , p_scheduling{ parallel::Scheduling::Static }
+    , p_threadsSize{ 1 }
     , p_time{ Analyse::time() }
+    , p_useHalfBonds{ false }
     , p_volumeCurrention{ volumeCurrection }
 {
     setFeeder( p_time );
@@ -32,7 +43,19 @@ BondBased::BondBased(BondBased::BondForceRelationship bondForceRelationship, Bon
         auto& logger = Logger::centre();
         logger.log(Logger::Broadcast::Process, "Applying bond-based peridynamic to \"" + part.name() + "\" Part.");
 
-        updateForces(part.neighborhoods(), override);
+        if (!part.bonds().matches(part.neighborhoods()))
+            part.updateBonds();
+        updateGeometry(part.bonds(), part.properties(), part.properties());
+        updateBlocks(part.properties(), part.neighborhoods(), part.bonds());
+        if (p_useHalfBonds)
+            updatePairs(part.neighborhoods(), part.bonds());
+        if (p_kernel)
+            updateKernelForces(part.neighborhoods(), part.bonds(), part.properties(), override, p_useHalfBonds, &p_damages);
+        else if (p_useHalfBonds)
+            updatePairForces(part.neighborhoods(), part.bonds(), part.properties(), override);
+        else
+            updateForces(part.neighborhoods(), part.bonds(), part.properties(), override);
+        drainFractureEvents();
         updatePartDamages(part);
         updateMaximumStretch(part);
 
@@ -59,12 +82,22 @@ BondBased::BondBased(BondBased::BondForceRelationship bondForceRelationship, Bon
 
 BondBased::BondBased(BondBased::BondForceRelationship bondForceRelationship, BondBased::VolumeCorrection volumeCurrection, BondBased::PDPart &centrePart, const BondBased::PDPart &neighborPart, const bool override)
     : Base(0, centrePart, [](const SimulationTime&, PDPart&) {} )
+    , p_blocks{}
     , p_bondForceRelationship{ bondForceRelationship }
+    , p_chunkSize{ 256 }
+    , p_damages{}
     , p_dt{ 0 }
+    , p_events{ nullptr }
+    , p_geometry{}
     , p_includeMaximumStretch{ false }
+    , p_kernel{ nullptr }
     , p_lastTime{ 0 }
     , p_maximumStretchIncluded{ false }
+    , p_pairs{}
+    , p_scheduling{ parallel::Scheduling::Static }
+    , p_threadsSize{ 1 }
     , p_time{ Analyse::time() }
+    , p_useHalfBonds{ false }
     , p_volumeCurrention{ volumeCurrection }
 {
     setFeeder( p_time );
@@ -80,7 +113,15 @@ BondBased::BondBased(BondBased::BondForceRelationship bondForceRelationship, Bon
         logger.log(Logger::Broadcast::Process, "Applying bond-based peridynamic to bonds having centre on \"" + centrePart.name() + "\" Part and end on \"" + neighborPart.name() + "\" Part.");
 
         auto& neighborhoods = centrePart.neighborhoods(neighborPart);
-        updateForces(neighborhoods, override);
+        if (!centrePart.bonds(neighborPart).matches(neighborhoods))
+            centrePart.updateBonds();
+        updateGeometry(centrePart.bonds(neighborPart), centrePart.properties(), neighborPart.properties());
+        updateBlocks(centrePart.properties(), neighborhoods, centrePart.bonds(neighborPart));
+        if (p_kernel)
+            updateKernelForces(neighborhoods, centrePart.bonds(neighborPart), neighborPart.properties(), override, false, nullptr);
+        else
+            updateForces(neighborhoods, centrePart.bonds(neighborPart), neighborPart.properties(), override);
+        drainFractureEvents();
         updatePartDamages(centrePart);
         updateMaximumStretch(centrePart);
 
@@ -105,6 +146,18 @@ BondBased::BondBased(BondBased::BondForceRelationship bondForceRelationship, Bon
     });
 }
 
+BondBased::BondBased(std::shared_ptr<BondForceKernel> kernel, BondBased::VolumeCorrection volumeCurrection, BondBased::PDPart &part, const bool override)
+    : BondBased(BondForceRelationship{}, volumeCurrection, part, override)
+{
+    p_kernel = kernel;
+}
+
+BondBased::BondBased(std::shared_ptr<BondForceKernel> kernel, BondBased::VolumeCorrection volumeCurrection, BondBased::PDPart &centrePart, const BondBased::PDPart &neighborPart, const bool override)
+    : BondBased(BondForceRelationship{}, volumeCurrection, centrePart, neighborPart, override)
+{
+    p_kernel = kernel;
+}
+
 BondBased BondBased::BrittleFracture(const double maxStretch, const double materialConstant,
                                      const double gridSpacing, const double horizonRadius,
                                      BondBased::PDPart &part, const bool override)
@@ -149,31 +202,7 @@ BondBased BondBased::BrittleFracture(const double maxPositiveStretch, const doub
     const auto upperBond = horizonRadius + gridSpacing;
     const auto lowerBond = horizonRadius - gridSpacing;
     return BondBased(
-        [materialConstant, maxPositiveStretch, maxNegativeStretch, isInFracturableArea](const SimulationTime, const Vector& initial, const Vector& deformation, const HorizonPtr& centerHorizon, const HorizonPtr& neighborHorizon) -> Vector{
-            if (deformation.isZero() || initial.isZero()) {
-                return space::consts::o3D;
-            }
-
-            bool isElastic = !isInFracturableArea(centerHorizon, neighborHorizon);
-            if (!isElastic && centerHorizon->hasStatus(neighborHorizon, Property::Damage)) {
-                return space::consts::o3D;
-            }
-
-            const auto initialLength = initial.length();
-            const auto currentBondVec = initial + deformation;
-            const auto bondStretch = (currentBondVec.length() - initialLength) / initialLength;
-
-            if (centerHorizon->centre()->has(Property::MaximumStretch)) {
-                if (abs(bondStretch) > abs(centerHorizon->centre()->at(Property::MaximumStretch).value<double>())) {
-                    centerHorizon->centre()->at(Property::MaximumStretch) = bondStretch;
-                }
-            }
-
-            if (isElastic || ( maxNegativeStretch <= bondStretch && bondStretch <= maxPositiveStretch ))
-                return materialConstant * bondStretch * (initial + deformation).unit();
-            centerHorizon->setStatus(neighborHorizon, Property::Damage, int(1));
-            return space::consts::o3D;
-        },
+        std::make_shared<BondBasedKernel<BrittleLaw> >(BrittleLaw{materialConstant, maxPositiveStretch, maxNegativeStretch, isInFracturableArea}),
         [gridSpacing, horizonRadius, upperBond, lowerBond](const SimulationTime, const Vector& initial, const Vector&) -> double {
             const double initialDistance = initial.length();
             if (initialDistance < lowerBond) {
@@ -200,23 +229,7 @@ BondBased BondBased::Elastic(const double materialConstant,
     const auto upperBond = horizonRadius + gridSpacing / 2;
     const auto lowerBond = horizonRadius - gridSpacing / 2;
     return BondBased(
-        [materialConstant](const SimulationTime, const Vector& initial, const Vector& deformation, const HorizonPtr&centerHorizon, const HorizonPtr&) -> Vector{
-            if (deformation.isZero() || initial.isZero()) {
-                return space::consts::o3D;
-            }
-
-            const auto initialLength = initial.length();
-            const auto currentBondVec = initial + deformation;
-            const auto stretch = (currentBondVec.length() - initialLength) / initialLength;
-
-            if (centerHorizon->centre()->has(Property::MaximumStretch)) {
-                if (abs(stretch) > abs(centerHorizon->centre()->at(Property::MaximumStretch).value<double>())) {
-                    centerHorizon->centre()->at(Property::MaximumStretch) = stretch;
-                }
-            }
-
-            return materialConstant * stretch * currentBondVec.unit();
-        },
+        std::make_shared<BondBasedKernel<ElasticLaw> >(ElasticLaw{materialConstant}),
         [gridSpacing, horizonRadius, upperBond, lowerBond](const SimulationTime, const Vector& initial, const Vector&) -> double {
             const double initialDistance = initial.length();
             if (initialDistance < lowerBond) {
@@ -245,23 +258,7 @@ BondBased BondBased::Elastic(const double materialConstant,
     const auto upperBond = partHorizonRadius + neighborPartGridSpacing / 2;
     const auto lowerBond = partHorizonRadius - neighborPartGridSpacing / 2;
     return BondBased(
-        [materialConstant](const SimulationTime, const Vector& initial, const Vector& deformation, const HorizonPtr& centerHorizon, const HorizonPtr&) -> Vector{
-            if (deformation.isZero() || initial.isZero()) {
-                return space::consts::o3D;
-            }
-
-            const auto initialLength = initial.length();
-            const auto currentBondVec = initial + deformation;
-            const auto stretch = (currentBondVec.length() - initialLength) / initialLength;
-
-            if (centerHorizon->centre()->has(Property::MaximumStretch)) {
-                if (abs(stretch) > abs(centerHorizon->centre()->at(Property::MaximumStretch).value<double>())) {
-                    centerHorizon->centre()->at(Property::MaximumStretch) = stretch;
-                }
-            }
-
-            return materialConstant * stretch * currentBondVec.unit();
-        },
+        std::make_shared<BondBasedKernel<ElasticLaw> >(ElasticLaw{materialConstant}),
         [neighborPartGridSpacing, partHorizonRadius, upperBond, lowerBond](const SimulationTime, const Vector& initial, const Vector&) -> double {
             const double initialDistance = initial.length();
             if (initialDistance < lowerBond) {
@@ -282,68 +279,201 @@ void BondBased::includeMaximumStretch(const bool include) {
 
 void BondBased::setBondForceRelationship(const BondBased::BondForceRelationship &relationship) {
     p_bondForceRelationship = relationship;
+    p_kernel = nullptr;
 }
 
-void BondBased::updateCentreForce(const BondBased::HorizonPtr &horizon, const bool override) const {
-    const auto& centre = horizon->centre();
-    const auto centreInitialPosition = centre->initialPosition().value<space::Point<3> >();
-    const auto centreDisp = (centre->has(Property::Displacement)) ? centre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-    auto force = space::consts::o3D;
-    const auto& neighbors = horizon->neighbors();
-    std::for_each(neighbors.begin(), neighbors.end(), [&](const PDPart::NeighborhoodPtr& neighbor) {
-        const auto& neighborCentre = neighbor->centre();
-        const auto neighborDisp = (neighborCentre->has(Property::Displacement)) ? neighborCentre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-        const auto initialBondVector = neighborCentre->initialPosition().value<space::Point<3> >().positionVector() - centreInitialPosition.positionVector();
-        const auto deformation = neighborDisp - centreDisp;
+void BondBased::setFractureEvents(const std::shared_ptr<FractureEvents> &events) {
+    p_events = events;
+}
 
-        if (!neighborCentre->has(Property::Volume))
-            throw std::runtime_error("The bond-based peridynmaic cannot proceed without volume at all of the Nodes.");
+void BondBased::setScheduling(const parallel::Scheduling scheduling, const size_t chunkSize) {
+    p_scheduling = scheduling;
+    p_chunkSize = chunkSize;
+}
 
-        force += 0.5 * neighborCentre->at(Property::Volume).value<double>()
-                * p_volumeCurrention(p_time, initialBondVector, deformation)
-                * p_bondForceRelationship(p_time, initialBondVector, deformation, horizon, neighbor);
-    });
+void BondBased::setThreadsSize(const size_t threadsSize) {
+    p_threadsSize = threadsSize;
+}
+
+void BondBased::useHalfBonds(const bool use) {
+    p_useHalfBonds = use;
+}
 
+void BondBased::setForce(configuration::Node &centre, const BondBased::Vector &force, const bool override) {
     if (override) {
-        if (centre->has(Property::Force)) {
-            centre->at(Property::Force) = force;
+        if (centre.has(Property::Force)) {
+            keys::Force::set(centre, force);
         } else {
             // has no force means the force is zero, thus only override it if the computed force is not zero.
             if (!force.isZero()) {
-                centre->at(Property::Force) = force;
+                keys::Force::set(centre, force);
             }
         }
     } else { // appending the force
         if (!force.isZero()) { // if the computed force is not zero
-            if (centre->has(Property::Force)) {
-                centre->at(Property::Force) = centre->at(Property::Force).value<Vector>() + force;
+            if (centre.has(Property::Force)) {
+                keys::Force::set(centre, keys::Force::get(centre) + force);
             } else {
-                centre->at(Property::Force) = force;
+                keys::Force::set(centre, force);
             }
         } // else the state of node force does not need to be changed.
     }
 }
 
-void BondBased::updateForces(const configuration::Part::NeighborhoodPtrs &horizons, const bool override) const {
-    std::for_each(horizons.begin(), horizons.end(), [this, override](const PDPart::NeighborhoodPtr& neighborhood) {
-        updateCentreForce(neighborhood, override);
+void BondBased::updateCentreForce(const BondBased::HorizonPtr &horizon, const configuration::BondGraph &bonds, const BondGeometry &geometry, const size_t row,
+                                  const configuration::PropertyTable &neighborProperties, const bool override) const {
+    const auto& centre = horizon->centre();
+    const auto& centreDisp = keys::Displacement::getOr(*centre, space::consts::o3D);
+    const auto displacements = neighborProperties.column(Property::Displacement);
+    auto force = space::consts::o3D;
+    const auto& neighbors = horizon->neighbors();
+    const auto begin = bonds.begin(row);
+    for (auto bond = begin; bond < bonds.end(row); bond++) {
+        const auto& neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(bond), space::consts::o3D);
+        const auto initialBondVector = geometry.initial(bond);
+        const auto deformation = neighborDisp - centreDisp;
+
+        force += 0.5 * geometry.neighborVolume(bond)
+                * geometry.volumeCorrection(bond)
+                * p_bondForceRelationship(p_time, initialBondVector, deformation, horizon, neighbors[bond - begin]);
+    }
+
+    setForce(*centre, force, override);
+}
+
+void BondBased::updateKernelForces(const configuration::Part::NeighborhoodPtrs &horizons, const configuration::BondGraph &bonds,
+                                   const configuration::PropertyTable &neighborProperties, const bool override, const bool usePairs,
+                                   DamageCounters *damages) const {
+    BondForceKernel::Forces forces;
+    const auto threadsSize = (usePairs) ? parallel::threadsSizeFor(p_threadsSize, p_pairs.pairs().size()) : p_blocks.threadsSize();
+    if (damages)
+        damages->prepare(threadsSize);
+    if (p_events)
+        p_events->prepare(Analyse::current().iterator(), threadsSize);
+    if (usePairs)
+        p_kernel->updatePairForces(horizons, bonds, p_geometry, p_pairs, neighborProperties, p_threadsSize, damages, p_events.get(), forces);
+    else
+        p_kernel->updateForces(horizons, bonds, p_geometry, p_blocks, neighborProperties, damages, p_events.get(), forces);
+
+    parallel::forEach(horizons.size(), p_threadsSize, p_scheduling, p_chunkSize, [&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++)
+            setForce(*horizons[row]->centre(), forces[row], override);
     });
 }
 
-void BondBased::updatePartDamages(BondBased::PDPart &part) const {
-    const auto& horizons = part.neighborhoods();
-    std::for_each(horizons.begin(), horizons.end(), [](const PDPart::NeighborhoodPtr& neighborhood) {
-        const auto& center = neighborhood->centre();
-        const auto& neighbors = neighborhood->neighbors();
-        int damage = 0;
-        std::for_each(neighbors.begin(), neighbors.end(), [&damage,  &neighborhood](const PDPart::NeighborhoodPtr& neighbor) {
-            damage += (neighborhood->hasStatus(neighbor, Property::Damage))? 1 : 0;
-        });
+void BondBased::updateForces(const configuration::Part::NeighborhoodPtrs &horizons, const configuration::BondGraph &bonds,
+                             const configuration::PropertyTable &neighborProperties, const bool override) const {
+    p_blocks.forEach([&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++)
+            updateCentreForce(horizons[row], bonds, p_geometry, row, neighborProperties, override);
+    });
+}
+
+void BondBased::updatePairForces(const configuration::Part::NeighborhoodPtrs &horizons, const configuration::BondGraph &bonds,
+                                 const configuration::PropertyTable &properties, const bool override) const {
+    if (horizons.empty() || !horizons.front()->bondStatuses())
+        return;
+
+    // The horizons are attached to the bond statuses of the graph.
+    auto& statuses = *horizons.front()->bondStatuses();
+    const auto displacements = properties.column(Property::Displacement);
+    const auto hasMaximumStretch = properties.column(Property::MaximumStretch) != nullptr;
+
+    std::vector<Vector> forces(horizons.size(), space::consts::o3D);
+
+    // Evaluates the relationship of a bond for its centre alone, as updateCentreForce() does.
+    // The neighbor is the horizon of the neighbor row; thus, the threads never lock the shared neighbor table.
+    const auto updateBond = [&](const size_t row, const configuration::BondGraph::BondIndex bond, const size_t neighborRow) {
+        const auto& horizon = horizons[row];
+        const auto& neighbor = horizons[neighborRow];
+        const auto& centreDisp = keys::Displacement::getOr(displacements, bonds.centre(row), space::consts::o3D);
+        const auto& neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(bond), space::consts::o3D);
+        forces[row] += 0.5 * p_geometry.neighborVolume(bond) * p_geometry.volumeCorrection(bond)
+                * p_bondForceRelationship(p_time, p_geometry.initial(bond), neighborDisp - centreDisp, horizon, neighbor);
+    };
+
+    p_pairs.forEach(p_threadsSize, [&](const size_t, const BondPairs::Pair& pair) {
+        // The pairs whose ends differ in the Damage (e.g., a one-sided pre-crack) are evaluated per bond.
+        const auto hasReverse = pair.reverse != BondPairs::noReverse;
+        const auto wasBroken = statuses.has(pair.bond, Property::Damage);
+        if (!hasReverse || wasBroken != statuses.has(pair.reverse, Property::Damage)) {
+            updateBond(pair.centreRow, pair.bond, pair.neighborRow);
+            if (hasReverse)
+                updateBond(pair.neighborRow, pair.reverse, pair.centreRow);
+            return;
+        }
 
-        if (center->has(Property::Damage) || damage != 0) {
-            center->at(Property::Damage) = double(damage) / double(neighbors.size());
+        const auto& horizon = horizons[pair.centreRow];
+        const auto& neighbor = horizons[pair.neighborRow];
+        const auto& centreDisp = keys::Displacement::getOr(displacements, bonds.centre(pair.centreRow), space::consts::o3D);
+        const auto& neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(pair.bond), space::consts::o3D);
+        const auto initialBondVector = p_geometry.initial(pair.bond);
+        const auto deformation = neighborDisp - centreDisp;
+        const auto force = p_geometry.volumeCorrection(pair.bond)
+                * p_bondForceRelationship(p_time, initialBondVector, deformation, horizon, neighbor);
+        forces[pair.centreRow] += 0.5 * p_geometry.neighborVolume(pair.bond) * force;
+        forces[pair.neighborRow] -= 0.5 * p_geometry.neighborVolume(pair.reverse) * force;
+
+        // A bond broken by the relationship is broken at both ends.
+        const auto isBroken = statuses.has(pair.bond, Property::Damage);
+        if (isBroken && !wasBroken)
+            statuses.set(pair.reverse, Property::Damage, statuses.at(pair.bond, Property::Damage));
+
+        // The relationship only updates the maximum stretch of the centre.
+        if (hasMaximumStretch && (!force.isZero() || isBroken != wasBroken)) {
+            auto& neighborCentre = *horizons[pair.neighborRow]->centre();
+            if (const auto maxStretch = keys::MaximumStretch::find(neighborCentre)) {
+                const auto stretch = ((initialBondVector + deformation).length() - p_geometry.length(pair.bond)) * p_geometry.inverseLength(pair.bond);
+                if (std::abs(stretch) > std::abs(*maxStretch))
+                    keys::MaximumStretch::set(neighborCentre, stretch);
+            }
         }
     });
+
+    for (size_t row = 0; row < horizons.size(); row++)
+        setForce(*horizons[row]->centre(), forces[row], override);
+}
+
+void BondBased::updateBlocks(configuration::PropertyTable &centreProperties, const configuration::Part::NeighborhoodPtrs &horizons, const configuration::BondGraph &bonds) {
+    if (!p_blocks.matches(bonds, p_threadsSize, p_scheduling, p_chunkSize))
+        p_blocks.assign(bonds, p_threadsSize, p_scheduling, p_chunkSize);
+    DamageCounters::prepareStatuses(horizons, p_blocks.threadsSize());
+    keys::typeColumns(centreProperties);
+    if (p_blocks.threadsSize() <= 1)
+        return;
+
+    // Activating a property column allocates it; thus, it cannot happen on multiple threads.
+    keys::Force::column(centreProperties);
+}
+
+void BondBased::updatePairs(const configuration::Part::NeighborhoodPtrs &horizons, const configuration::BondGraph &bonds) {
+    if (!p_pairs.matches(bonds))
+        p_pairs.assign(bonds);
+    DamageCounters::prepareStatuses(horizons, parallel::threadsSizeFor(p_threadsSize, p_pairs.size()));
+}
+
+void BondBased::updateGeometry(const configuration::BondGraph &bonds,
+                               const configuration::PropertyTable &centreProperties, const configuration::PropertyTable &neighborProperties) {
+    if (!p_geometry.matches(bonds))
+        p_geometry.assign(bonds, centreProperties, neighborProperties, p_volumeCurrention, p_time);
+}
+
+void BondBased::drainFractureEvents() {
+    if (!p_events)
+        return;
+
+    if (const auto lost = p_events->drain()) {
+        using Logger = report::Logger;
+        Logger::centre().log(Logger::Broadcast::Warning, std::to_string(lost) + " fracture event" + ((lost == 1) ? " was" : "s were")
+                             + " lost; increase the capacity of the FractureEvents.");
+    }
+}
+
+void BondBased::updatePartDamages(BondBased::PDPart &part) {
+    if (!part.bonds().matches(part.neighborhoods()))
+        part.updateBonds();
+
+    p_damages.update(part.neighborhoods(), part.bonds(), part.properties(), p_threadsSize, p_scheduling, p_chunkSize);
 }
 
 void BondBased::updateMaximumStretch(BondBased::PDPart &part) {
@@ -9,7 +9,14 @@
 #ifndef BONDBASED_H
 #define BONDBASED_H
 
+#include "BondBasedKernel.h"
+#include "BondGeometry.h"
+#include "BondPairs.h"
+#include "DamageCounters.h"
+#include "FractureEvents.h"
+#include "HorizonBlocks.h"
 #include "Property.h"
+#include "PropertyKeys.h"
 #include "../Relation.h"
 #include "../../Analyse.h"
 #include "../../configuration/Part.h"
@@ -55,6 +62,8 @@ public:
      * @param 2nd The bond initial vector.
      * @param 3rd The bond current vector.
      * @return The volume currention for the given bond.
+     * @note It is evaluated once per bond (with zero deformation) and cached until the bonds change; thus, it should only
+     *       depend on the bond initial vector.
      */
     using VolumeCorrection = std::function<double(const SimulationTime, const Vector&, const Vector&)>;
 
@@ -213,45 +222,195 @@ public:
      */
     void includeMaximumStretch(const bool include = true);
 
+    /**
+     * @brief Sets a compile-time bond force law (e.g., ElasticLaw) instead of the bond force relationship.
+     * @details The forces are then computed by a BondBasedKernel<Law>, which calls the law inside its loops rather than
+     *          the bond force relationship through a std::function for every bond; the Elastic() and BrittleFracture()
+     *          relations are built with one.
+     * @tparam Law The bond force law (see ElasticLaw for its requirements).
+     */
+    template<typename Law>
+    void setBondForceLaw(const Law& law) {
+        p_kernel = std::make_shared<BondBasedKernel<Law> >(law);
+    }
+
     /**
      * @brief Sets the bonnd force relationship.
+     * @note Replaces the bond force law, if any (see setBondForceLaw()).
      */
     void setBondForceRelationship(const BondForceRelationship& relationship);
 
+    /**
+     * @brief Sets the log of the bonds broken by the bond force law (see FractureEvents).
+     * @details The events are recorded by the force loops and drained to the log file after each time step; a warning
+     *          is logged if a thread has broken more bonds in a time step than its buffer holds.
+     * @note Only the bonds broken by the built-in laws (e.g., BrittleFracture()) are logged, not the ones of a custom
+     *       bond force relationship.
+     * @param events The log; nullptr stops logging.
+     */
+    void setFractureEvents(const std::shared_ptr<FractureEvents>& events);
+
+    /**
+     * @brief Sets how the horizons are shared between the threads (see setThreadsSize()).
+     * @param scheduling The scheduling; the static one gives each thread the same number of bonds, while the chunked
+     *                   one balances the horizons of different costs (e.g., near the cracks) at the cost of more sync.
+     * @param chunkSize The number of the horizons of each chunk of the chunked scheduling.
+     */
+    void setScheduling(const parallel::Scheduling scheduling, const size_t chunkSize = 256);
+
+    /**
+     * @brief Sets the number of the threads computing the forces and the damages.
+     * @details The forces are computed per horizon (see HorizonBlocks), or per pair of bonds if the half bonds are used
+     *          (see useHalfBonds()); each thread only writes to the centres and the bonds it computes.
+     * @warning With more than one thread, the bond force relationship is called from multiple threads at the same time
+     *          (for different horizons or the bonds sharing no node); thus, it must only modify its centre node and the
+     *          Damage of its bond, and it can only set the Damage to int(1) (see DamageCounters::prepareStatuses());
+     *          setting any other value throws.
+     * @param threadsSize The number of the threads; zero means as many as the hardware can run at the same time.
+     */
+    void setThreadsSize(const size_t threadsSize);
+
+    /**
+     * @brief Defines whether to evaluate the bond force relationship once per pair of the inner bonds.
+     * @details The bond-based forces are pairwise antisymmetric; thus, the force of each pair is evaluated once, from the
+     *          node with the smaller id, and applied to both nodes (i.e., +f to the centre and -f to the neighbor, each
+     *          multiplied by the volume of the other end). This halves the calls of the bond force relationship.
+     *          The pairs are grouped so that the pairs processed at the same time share no node (see BondPairs).
+     * @note A pair is evaluated once only if its bonds agree at both ends: the same Damage status and, for the
+     *          material laws, the same result of isInFracturableArea (see BrittleFracture()). The other pairs (e.g., a
+     *          pre-crack or a fracture predicate at one end only) are evaluated per bond, as if half bonds were not used.
+     * @note The bond force relationship must be antisymmetric and only depend on the bond, as the ones of Elastic() and
+     *          BrittleFracture() are; a bond it breaks is broken at both ends, and the maximum stretch of the neighbor is
+     *          updated by the relation.
+     * @note Only applies to the inner bonds; the connections between two Parts are computed per bond.
+     */
+    void useHalfBonds(const bool use = true);
+
 private:
 
+    /**
+     * @brief Constructs a relation that applies the bond-based peridynamic to any PDPart with the kernel of a bond force law.
+     * @see BondBased(BondForceRelationship, VolumeCorrection, PDPart&, const bool) and setBondForceLaw().
+     */
+    explicit BondBased(std::shared_ptr<BondForceKernel> kernel, VolumeCorrection volumeCurrection, PDPart& part, const bool override);
+
+    /**
+     * @brief Constructs a relation that applies the bond-based peridynamic to the connection between two PDPart with the kernel of a bond force law.
+     * @see BondBased(BondForceRelationship, VolumeCorrection, PDPart&, const PDPart&, const bool) and setBondForceLaw().
+     */
+    explicit BondBased(std::shared_ptr<BondForceKernel> kernel, VolumeCorrection volumeCurrection, PDPart& centrePart, const PDPart& neighborPart, const bool override);
+
+    /**
+     * @brief Overrides or appends the force of a Node.
+     * @warning If the force is zero and the Node has no force, nothing will happen.
+     */
+    static void setForce(configuration::Node& centre, const Vector& force, const bool override);
+
     /**
      * @brief Computes bond-based peridynamic force at the centre of the horizon (i.e., neighborhood) and updates it.
      * @warning If the computed bond-based peridynamic force is zero and the centre of the horizon has no force, nothing will happen.
      * @param horizon The neighborhood inside the PDPart.
+     * @param bonds The bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param row The row of the horizon on the bonds.
+     * @param neighborProperties The properties of the neighbor Part nodes.
+     * @param override Whether to override the force or add to it.
+     */
+    void updateCentreForce(const HorizonPtr& horizon, const configuration::BondGraph& bonds, const BondGeometry& geometry, const size_t row,
+                           const configuration::PropertyTable& neighborProperties, const bool override) const;
+
+    /**
+     * @brief Computes bond-based peridynamic force at the given horizon centers with the bond force law and updates them.
+     * @param horizons The neighborhoods.
+     * @param bonds The bonds of the horizons.
+     * @param neighborProperties The properties of the neighbor Part nodes.
      * @param override Whether to override the force or add to it.
+     * @param usePairs Whether to compute the forces per pair of the inner bonds (see useHalfBonds()).
+     * @param damages The counters recording the rows of the broken bonds, or nullptr (e.g., for the connection bonds).
      */
-    void updateCentreForce(const HorizonPtr& horizon, const bool override) const;
+    void updateKernelForces(const PDPart::NeighborhoodPtrs& horizons, const configuration::BondGraph& bonds,
+                            const configuration::PropertyTable& neighborProperties, const bool override, const bool usePairs,
+                            DamageCounters* damages) const;
 
     /**
      * @brief Computes bond-based peridynamic force at the given horizon centers (i.e., neighborhood) and updates it.
      * @warning If the computed bond-based peridynamic force is zero and the centre of the horizon has no force, nothing will happen.
      * @param horizons The neighborhoods inside the PDPart.
+     * @param bonds The bonds of the horizons.
+     * @param neighborProperties The properties of the neighbor Part nodes.
+     * @param override Whether to override the force or add to it.
+     */
+    void updateForces(const PDPart::NeighborhoodPtrs& horizons, const configuration::BondGraph& bonds,
+                      const configuration::PropertyTable& neighborProperties, const bool override) const;
+
+    /**
+     * @brief Computes bond-based peridynamic force of the pairs of the inner bonds and updates the horizon centres.
+     * @param horizons The neighborhoods inside the PDPart.
+     * @param bonds The inner bonds of the horizons.
+     * @param properties The properties of the PDPart nodes.
      * @param override Whether to override the force or add to it.
      */
-    void updateForces(const PDPart::NeighborhoodPtrs& horizons, const bool override) const;
+    void updatePairForces(const PDPart::NeighborhoodPtrs& horizons, const configuration::BondGraph& bonds,
+                          const configuration::PropertyTable& properties, const bool override) const;
+
+    /**
+     * @brief Splits the horizons into blocks for the threads if the bonds or the threading have changed, and prepares the
+     *        properties and the bond statuses the threads write to.
+     * @param centreProperties The properties of the centre Part nodes.
+     * @param horizons The neighborhoods.
+     * @param bonds The bonds of the horizons.
+     */
+    void updateBlocks(configuration::PropertyTable& centreProperties, const PDPart::NeighborhoodPtrs& horizons, const configuration::BondGraph& bonds);
+
+    /**
+     * @brief Computes the pairs of the inner bonds if their topology has changed, and prepares the bond statuses the
+     *        threads write to (see DamageCounters::prepareStatuses()).
+     * @param horizons The neighborhoods inside the PDPart.
+     * @param bonds The inner bonds of the horizons.
+     */
+    void updatePairs(const PDPart::NeighborhoodPtrs& horizons, const configuration::BondGraph& bonds);
+
+    /**
+     * @brief Computes the reference geometry of the bonds if their topology has changed.
+     * @param bonds The bonds.
+     * @param centreProperties The properties of the centre Part nodes.
+     * @param neighborProperties The properties of the neighbor Part nodes.
+     */
+    void updateGeometry(const configuration::BondGraph& bonds,
+                        const configuration::PropertyTable& centreProperties, const configuration::PropertyTable& neighborProperties);
+
+    /**
+     * @brief Writes the recorded broken bonds to the log file, if any (see setFractureEvents()).
+     */
+    void drainFractureEvents();
 
     /**
      * @brief Updates the damage of the Part Nodes by avaraging the horizon broken bonds.
+     * @note Only the Nodes having a newly broken bond are updated when the kernel has recorded all of them (see DamageCounters).
      */
-    void updatePartDamages(PDPart& part) const;
+    void updatePartDamages(PDPart& part);
 
     /**
      * @brief Updates the maximum stretch existance on the nodes.
      */
     void updateMaximumStretch(PDPart& part);
 
+    HorizonBlocks p_blocks;                         // The blocks of the horizons processed by the threads.
     BondForceRelationship p_bondForceRelationship;  // Denotes how to compute the force for each bond.
+    size_t p_chunkSize;                             // The number of the horizons of each chunk of the chunked scheduling.
+    DamageCounters p_damages;                       // The numbers of the broken inner bonds of the horizons.
     SimulationTime p_dt;                            // The time step.
+    std::shared_ptr<FractureEvents> p_events;       // The log of the broken bonds (null if not logged).
+    BondGeometry p_geometry;                        // The reference geometry of the bonds.
     bool p_includeMaximumStretch;                   // Whether to incude the maximum stretch to the nodes or not.
+    std::shared_ptr<BondForceKernel> p_kernel;      // The kernel of the bond force law (null if the relationship is used).
     SimulationTime p_lastTime;                      // The last time.
     bool p_maximumStretchIncluded;                  // Whether the maximum stretch is already included or not.
+    BondPairs p_pairs;                              // The pairs of the inner bonds.
+    parallel::Scheduling p_scheduling;              // How the horizons are shared between the threads.
+    size_t p_threadsSize;                           // The number of the threads computing the forces and the damages.
     const SimulationTime& p_time;                   // The reference to global Analyses::Time.
+    bool p_useHalfBonds;                            // Whether to evaluate the forces once per pair of the inner bonds.
     VolumeCorrection p_volumeCurrention;            // Denotes how to compute the volume currention for each bond.
 };
 
@@ -0,0 +1,134 @@
+//
+//  BondBasedKernel.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDBASEDKERNEL_H
+#define BONDBASEDKERNEL_H
+
+#include "BondBasedLaws.h"
+#include "BondGeometry.h"
+#include "BondLanes.h"
+#include "BondPairs.h"
+#include "DamageCounters.h"
+#include "FractureEvents.h"
+#include "HorizonBlocks.h"
+#include "Property.h"
+#include "PropertyKeys.h"
+#include "../../configuration/Part.h"
+#include "../../parallel/threads.h"
+#include <vector>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The BondForceKernel is the interface of the loops computing the bond-based peridynamic forces (see BondBasedKernel).
+ */
+class BondForceKernel
+{
+public:
+    using Horizons = configuration::Part::NeighborhoodPtrs;
+    using Vector = space::vec3;
+    using Forces = std::vector<Vector>;
+
+    virtual ~BondForceKernel() = default;
+
+    /**
+     * @brief Computes the force of each horizon centre, bond by bond.
+     * @param horizons The horizons (i.e., neighborhoods).
+     * @param bonds The bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param blocks The blocks of the horizons processed by the threads.
+     * @param neighborProperties The properties of the neighbor Part nodes.
+     * @param damages The counters recording the rows of the broken bonds, or nullptr (e.g., for the connection bonds).
+     * @param events The log of the broken bonds, or nullptr.
+     * @note The Damage statuses must be prepared for the threads beforehand (see DamageCounters::prepareStatuses()).
+     * @param[out] forces The force of each horizon centre, in the order of the horizons.
+     */
+    virtual void updateForces(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                              const HorizonBlocks& blocks, const configuration::PropertyTable& neighborProperties,
+                              DamageCounters* damages, FractureEvents* events, Forces& forces) = 0;
+
+    /**
+     * @brief Computes the force of each horizon centre, pair by pair of the inner bonds (see BondBased::useHalfBonds()).
+     * @param horizons The horizons (i.e., neighborhoods) of the Part.
+     * @param bonds The inner bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param pairs The pairs of the bonds.
+     * @param properties The properties of the Part nodes.
+     * @param threadsSize The number of the threads (see parallel::threadsSizeFor()).
+     * @param damages The counters recording the rows of the broken bonds, or nullptr.
+     * @param events The log of the broken bonds, or nullptr.
+     * @note The Damage statuses must be prepared for the threads beforehand (see DamageCounters::prepareStatuses()).
+     * @param[out] forces The force of each horizon centre, in the order of the horizons.
+     */
+    virtual void updatePairForces(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                                  const BondPairs& pairs, const configuration::PropertyTable& properties, const size_t threadsSize,
+                                  DamageCounters* damages, FractureEvents* events, Forces& forces) = 0;
+};
+
+/**
+ * @brief The BondBasedKernel computes the bond-based peridynamic forces with a compile-time law (e.g., ElasticLaw).
+ * @details Unlike the BondBased::BondForceRelationship, which is called through a std::function for every bond, the
+ *          law is a value type called inside the loops of the kernel; thus, it is inlined and the loops only read the
+ *          cached bond geometry (see BondGeometry) and the bond status flags.
+ *          The fracturable area of the law is evaluated once per bond and kept until the topology of the bonds changes.
+ *          updateForces() computes the current vectors, lengths and stretches of the bonds of a horizon in the lanes of
+ *          space::VectorBatch (see BondLanes); only the law, the breakage and the skipped bonds are handled bond by bond.
+ * @tparam Law The bond force law (see ElasticLaw for its requirements).
+ */
+template<typename Law>
+class BondBasedKernel : public BondForceKernel
+{
+public:
+
+    /**
+     * @brief The constructor.
+     * @param law The bond force law.
+     */
+    explicit BondBasedKernel(const Law& law);
+
+    /**
+     * @brief Gives the bond force law.
+     */
+    const Law& law() const;
+
+    void updateForces(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                      const HorizonBlocks& blocks, const configuration::PropertyTable& neighborProperties,
+                      DamageCounters* damages, FractureEvents* events, Forces& forces) override;
+
+    void updatePairForces(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                          const BondPairs& pairs, const configuration::PropertyTable& properties, const size_t threadsSize,
+                          DamageCounters* damages, FractureEvents* events, Forces& forces) override;
+
+private:
+
+    /**
+     * @brief Gives the statuses of the bonds of the horizons.
+     * @throws If the law is fracturable and the horizons are not attached to the statuses of their bonds.
+     */
+    static configuration::BondStatuses* statusesOf(const Horizons& horizons);
+
+    /**
+     * @brief Evaluates the fracturable area of the law for the bonds if their topology has changed.
+     */
+    void updateFracturable(const Horizons& horizons, const configuration::BondGraph& bonds);
+
+    std::vector<bool> p_fracturable;                // Whether each bond is inside the fracturable area.
+    Law p_law;                                      // The bond force law.
+    configuration::BondGraph::Revision p_revision;  // The revision of the bonds the fracturable area is evaluated for.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#ifndef BONDBASEDKERNELIMP_H
+#include "BondBasedKernelImp.h"
+#endif // BONDBASEDKERNELIMP_H
+
+#endif // BONDBASEDKERNEL_H
@@ -0,0 +1,216 @@
+//
+//  BondBasedKernelImp.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDBASEDKERNELIMP_H
+#define BONDBASEDKERNELIMP_H
+
+#ifndef BONDBASEDKERNEL_H
+#   include "BondBasedKernel.h"
+#endif // BONDBASEDKERNEL_H
+
+#include <cmath>
+#include <stdexcept>
+
+namespace rbs::relations::peridynamic {
+
+template<typename Law>
+BondBasedKernel<Law>::BondBasedKernel(const Law &law)
+    : p_fracturable{}
+    , p_law{law}
+    , p_revision{0}
+{
+}
+
+template<typename Law>
+const Law &BondBasedKernel<Law>::law() const {
+    return p_law;
+}
+
+template<typename Law>
+void BondBasedKernel<Law>::updateForces(const Horizons &horizons, const configuration::BondGraph &bonds, const BondGeometry &geometry,
+                                        const HorizonBlocks &blocks, const configuration::PropertyTable &neighborProperties,
+                                        DamageCounters *damages, FractureEvents *events, Forces &forces) {
+    updateFracturable(horizons, bonds);
+    auto* statuses = statusesOf(horizons);
+    const auto displacements = neighborProperties.column(Property::Displacement);
+
+    forces.assign(horizons.size(), space::consts::o3D);
+    const auto displacementOf = [displacements](const size_t id) {
+        return keys::Displacement::getOr(displacements, id, space::consts::o3D);
+    };
+    blocks.forEach([&](const size_t thread, const size_t begin, const size_t end) {
+        auto broken = (statuses) ? statuses->flags(Property::Damage) : nullptr;
+        BondLanes lanes;
+        for (auto row = begin; row < end; row++) {
+            auto& centre = *horizons[row]->centre();
+            const auto centreDisp = keys::Displacement::getOr(centre, space::consts::o3D);
+            const auto maxStretch = keys::MaximumStretch::find(centre);
+            auto rowMaxStretch = (maxStretch) ? *maxStretch : 0.;
+
+            lanes.gather(bonds, geometry, row, centreDisp, displacementOf);
+            const auto bondsBegin = bonds.begin(row);
+            for (auto bond = bondsBegin; bond < bonds.end(row); bond++) {
+                const auto index = bond - bondsBegin;
+                if (lanes.deformation(index).isZero() || geometry.initial(bond).isZero())
+                    continue;
+
+                const auto isFracturable = Law::isFracturable && p_fracturable[bond];
+                if (isFracturable && broken && broken->test(bond))
+                    continue;
+
+                const auto stretch = lanes.stretch(index);
+                if (std::abs(stretch) > std::abs(rowMaxStretch))
+                    rowMaxStretch = stretch;
+
+                if (isFracturable && p_law.breaks(stretch)) {
+                    statuses->set(bond, Property::Damage, int(1));
+                    broken = statuses->flags(Property::Damage);
+                    if (damages)
+                        damages->record(thread, row);
+                    if (events)
+                        events->record(thread, bonds.centre(row), bonds.neighbor(bond), stretch);
+                    continue;
+                }
+                lanes.setForce(index, 0.5 * geometry.neighborVolume(bond) * geometry.volumeCorrection(bond) * p_law.force(stretch));
+            }
+            forces[row] = lanes.force();
+
+            if (maxStretch && rowMaxStretch != *maxStretch)
+                keys::MaximumStretch::set(centre, rowMaxStretch);
+        }
+    });
+}
+
+template<typename Law>
+void BondBasedKernel<Law>::updatePairForces(const Horizons &horizons, const configuration::BondGraph &bonds, const BondGeometry &geometry,
+                                            const BondPairs &pairs, const configuration::PropertyTable &properties, const size_t threadsSize,
+                                            DamageCounters *damages, FractureEvents *events, Forces &forces) {
+    forces.assign(horizons.size(), space::consts::o3D);
+    if (horizons.empty() || !horizons.front()->bondStatuses())
+        return;
+
+    updateFracturable(horizons, bonds);
+    auto& statuses = *statusesOf(horizons);
+    const auto displacements = properties.column(Property::Displacement);
+    const auto hasMaximumStretch = properties.column(Property::MaximumStretch) != nullptr;
+    const auto updateMaximumStretch = [](configuration::Node& node, const double stretch) {
+        if (const auto maxStretch = keys::MaximumStretch::find(node)) {
+            if (std::abs(stretch) > std::abs(*maxStretch))
+                keys::MaximumStretch::set(node, stretch);
+        }
+    };
+
+    // Evaluates a bond for its centre alone, as updateForces() does.
+    const auto updateBond = [&](const size_t thread, const size_t row, const configuration::BondGraph::BondIndex bond) {
+        const auto centreDisp = keys::Displacement::getOr(displacements, bonds.centre(row), space::consts::o3D);
+        const auto neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(bond), space::consts::o3D);
+        const auto initial = geometry.initial(bond);
+        const auto deformation = neighborDisp - centreDisp;
+        if (deformation.isZero() || initial.isZero())
+            return;
+
+        const auto isFracturable = Law::isFracturable && p_fracturable[bond];
+        if (isFracturable && statuses.has(bond, Property::Damage))
+            return;
+
+        const auto current = initial + deformation;
+        const auto length = geometry.length(bond);
+        const auto stretch = (current.length() - length) / length;
+        if (hasMaximumStretch)
+            updateMaximumStretch(*horizons[row]->centre(), stretch);
+
+        if (isFracturable && p_law.breaks(stretch)) {
+            statuses.set(bond, Property::Damage, int(1));
+            if (damages)
+                damages->record(thread, row);
+            if (events)
+                events->record(thread, bonds.centre(row), bonds.neighbor(bond), stretch);
+            return;
+        }
+        forces[row] += 0.5 * geometry.neighborVolume(bond) * geometry.volumeCorrection(bond) * (p_law.force(stretch) * current.unit());
+    };
+
+    pairs.forEach(threadsSize, [&](const size_t thread, const BondPairs::Pair& pair) {
+        // The pairs whose ends differ in the fracturability or the Damage (e.g., a pre-crack or a fracturable area on one
+        // side) are evaluated per bond; thus, the result does not depend on which end has the smaller id.
+        const auto hasReverse = pair.reverse != BondPairs::noReverse;
+        const auto isSymmetric = hasReverse
+                && (!Law::isFracturable || p_fracturable[pair.bond] == p_fracturable[pair.reverse])
+                && statuses.has(pair.bond, Property::Damage) == statuses.has(pair.reverse, Property::Damage);
+        if (!isSymmetric) {
+            updateBond(thread, pair.centreRow, pair.bond);
+            if (hasReverse)
+                updateBond(thread, pair.neighborRow, pair.reverse);
+            return;
+        }
+
+        const auto centreDisp = keys::Displacement::getOr(displacements, bonds.centre(pair.centreRow), space::consts::o3D);
+        const auto neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(pair.bond), space::consts::o3D);
+        const auto initial = geometry.initial(pair.bond);
+        const auto deformation = neighborDisp - centreDisp;
+        if (deformation.isZero() || initial.isZero())
+            return;
+
+        const auto isFracturable = Law::isFracturable && p_fracturable[pair.bond];
+        if (isFracturable && statuses.has(pair.bond, Property::Damage))
+            return;
+
+        const auto current = initial + deformation;
+        const auto length = geometry.length(pair.bond);
+        const auto stretch = (current.length() - length) / length;
+        if (hasMaximumStretch) {
+            updateMaximumStretch(*horizons[pair.centreRow]->centre(), stretch);
+            updateMaximumStretch(*horizons[pair.neighborRow]->centre(), stretch);
+        }
+
+        if (isFracturable && p_law.breaks(stretch)) {
+            statuses.set(pair.bond, Property::Damage, int(1));
+            statuses.set(pair.reverse, Property::Damage, int(1));
+            if (damages) {
+                damages->record(thread, pair.centreRow);
+                damages->record(thread, pair.neighborRow);
+            }
+            if (events) {
+                events->record(thread, bonds.centre(pair.centreRow), bonds.neighbor(pair.bond), stretch);
+                events->record(thread, bonds.centre(pair.neighborRow), bonds.neighbor(pair.reverse), stretch);
+            }
+            return;
+        }
+
+        const auto force = geometry.volumeCorrection(pair.bond) * (p_law.force(stretch) * current.unit());
+        forces[pair.centreRow] += 0.5 * geometry.neighborVolume(pair.bond) * force;
+        forces[pair.neighborRow] -= 0.5 * geometry.neighborVolume(pair.reverse) * force;
+    });
+}
+
+template<typename Law>
+configuration::BondStatuses *BondBasedKernel<Law>::statusesOf(const Horizons &horizons) {
+    auto* statuses = (horizons.empty()) ? nullptr : horizons.front()->bondStatuses().get();
+    if (Law::isFracturable && !statuses && !horizons.empty())
+        throw std::runtime_error("The fracturable bond-based peridynamic kernel requires the horizons attached to their bonds.");
+    return statuses;
+}
+
+template<typename Law>
+void BondBasedKernel<Law>::updateFracturable(const Horizons &horizons, const configuration::BondGraph &bonds) {
+    if (!Law::isFracturable || p_revision == bonds.revision())
+        return;
+
+    p_fracturable.assign(bonds.bondsSize(), false);
+    for (size_t row = 0; row < horizons.size(); row++) {
+        const auto& neighbors = horizons[row]->neighbors();
+        const auto begin = bonds.begin(row);
+        for (auto bond = begin; bond < bonds.end(row); bond++)
+            p_fracturable[bond] = p_law.isInFracturableArea(horizons[row], neighbors[bond - begin]);
+    }
+    p_revision = bonds.revision();
+}
+
+} // namespace rbs::relations::peridynamic
+
+#endif // BONDBASEDKERNELIMP_H
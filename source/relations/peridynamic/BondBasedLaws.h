@@ -0,0 +1,79 @@
+//
+//  BondBasedLaws.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDBASEDLAWS_H
+#define BONDBASEDLAWS_H
+
+#include "../../configuration/Part.h"
+#include <functional>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The ElasticLaw denotes the bond-based peridynamic bonds that never break (see BondBasedKernel).
+ * @details A law is a value type that the BondBasedKernel calls for every bond; thus, its functions are defined in the
+ *          header to be inlined into the force loop. A law provides:
+ *          - isFracturable: whether any of its bonds can break,
+ *          - force(stretch): the magnitude of the bond force along the current bond vector,
+ *          - breaks(stretch): whether a fracturable bond breaks at a stretch,
+ *          - isInFracturableArea(centre, neighbor): whether a bond is fracturable; called once per bond topology.
+ */
+struct ElasticLaw {
+    using HorizonPtr = configuration::Part::NeighborhoodPtr;
+
+    static constexpr bool isFracturable = false;
+
+    double materialConstant;    // The bond-based peridynamic material constant.
+
+    bool breaks(const double) const {
+        return false;
+    }
+
+    double force(const double stretch) const {
+        return materialConstant * stretch;
+    }
+
+    bool isInFracturableArea(const HorizonPtr&, const HorizonPtr&) const {
+        return false;
+    }
+};
+
+/**
+ * @brief The BrittleLaw denotes the bond-based peridynamic bonds that break beyond their maximum stretches.
+ * @note The broken bonds carry no force, and the bonds outside the fracturable area behave as the ElasticLaw ones.
+ */
+struct BrittleLaw {
+    using HorizonPtr = configuration::Part::NeighborhoodPtr;
+    using IsInFracturableArea = std::function<bool(const HorizonPtr&, const HorizonPtr&)>;
+
+    static constexpr bool isFracturable = true;
+
+    double materialConstant;                    // The bond-based peridynamic material constant.
+    double maxPositiveStretch;                  // The maximum positive (tension) stretch a bond can carry.
+    double maxNegativeStretch;                  // The maximum negative (pressure) stretch a bond can carry.
+    IsInFracturableArea fracturableArea;        // Whether a bond is inside the fracturable area.
+
+    bool breaks(const double stretch) const {
+        return !(maxNegativeStretch <= stretch && stretch <= maxPositiveStretch);
+    }
+
+    double force(const double stretch) const {
+        return materialConstant * stretch;
+    }
+
+    bool isInFracturableArea(const HorizonPtr& centre, const HorizonPtr& neighbor) const {
+        return !fracturableArea || fracturableArea(centre, neighbor);
+    }
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // BONDBASEDLAWS_H
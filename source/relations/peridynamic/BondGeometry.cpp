@@ -0,0 +1,79 @@
+//
+//  BondGeometry.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "BondGeometry.h"
+
+namespace rbs::relations::peridynamic {
+
+BondGeometry::BondGeometry()
+    : p_initials{}
+    , p_inverseLengths{}
+    , p_lengths{}
+    , p_neighborVolumes{}
+    , p_revision{0}
+    , p_volumeCorrections{}
+{
+}
+
+const space::VectorBatch &BondGeometry::initials() const {
+    return p_initials;
+}
+
+const BondGeometry::Scalars &BondGeometry::lengths() const {
+    return p_lengths;
+}
+
+bool BondGeometry::matches(const configuration::BondGraph &bonds) const {
+    return p_revision == bonds.revision();
+}
+
+size_t BondGeometry::size() const {
+    return p_initials.size();
+}
+
+void BondGeometry::assign(const configuration::BondGraph &bonds,
+                          const configuration::PropertyTable &centreProperties, const configuration::PropertyTable &neighborProperties,
+                          const BondGeometry::VolumeCorrection &volumeCorrection, const double time) {
+    clear();
+
+    const auto volumes = neighborProperties.column(Property::Volume);
+    p_initials.resize(bonds.bondsSize());
+    p_neighborVolumes.resize(bonds.bondsSize());
+    for (size_t row = 0; row < bonds.size(); row++) {
+        const auto centrePosition = centreProperties.initialPosition(bonds.centre(row)).value<space::Point<3> >().positionVector();
+        for (auto bond = bonds.begin(row); bond < bonds.end(row); bond++) {
+            const auto neighborId = bonds.neighbor(bond);
+            const auto volume = keys::Volume::find(volumes, neighborId);
+            if (!volume)
+                throw std::runtime_error("The peridynamic bonds cannot be computed without volume at all of the Nodes.");
+
+            p_initials.set(bond, neighborProperties.initialPosition(neighborId).value<space::Point<3> >().positionVector() - centrePosition);
+            p_neighborVolumes[bond] = *volume;
+        }
+    }
+
+    space::VectorBatch::length(p_initials, p_lengths);
+    p_inverseLengths.resize(p_lengths.size());
+    p_volumeCorrections.resize(p_lengths.size());
+    for (BondIndex bond = 0; bond < p_lengths.size(); bond++) {
+        p_inverseLengths[bond] = (p_lengths[bond] > 0) ? 1 / p_lengths[bond] : 0;
+        p_volumeCorrections[bond] = volumeCorrection(time, initial(bond), space::consts::o3D);
+    }
+    p_revision = bonds.revision();
+}
+
+void BondGeometry::clear() {
+    p_initials.clear();
+    p_inverseLengths.clear();
+    p_lengths.clear();
+    p_neighborVolumes.clear();
+    p_revision = 0;
+    p_volumeCorrections.clear();
+}
+
+} // namespace rbs::relations::peridynamic
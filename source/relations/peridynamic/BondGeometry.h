@@ -0,0 +1,128 @@
+//
+//  BondGeometry.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDGEOMETRY_H
+#define BONDGEOMETRY_H
+
+#include "PropertyKeys.h"
+#include "../../configuration/BondGraph.h"
+#include "../../configuration/PropertyTable.h"
+#include "../../space/VectorBatch.h"
+#include <functional>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The BondGeometry caches the reference (i.e., initial) configuration of the bonds of a BondGraph.
+ * @details The initial bond vector, its length and inverse length, the volume correction and the neighbor volume do
+ *          not change during the simulation; thus, they are computed once per bond (in the same order as the bonds of
+ *          the graph) and kept until the topology of the graph changes (see BondGraph::revision()).
+ * @note The volume correction is evaluated with zero deformation; thus, it must only depend on the initial bond vector.
+ */
+class BondGeometry
+{
+public:
+    using BondIndex = configuration::BondGraph::BondIndex;
+    using Scalars = space::VectorBatch::Scalars;
+    using Vector = space::vec3;
+    using VolumeCorrection = std::function<double(const double, const Vector&, const Vector&)>;
+
+    /**
+     * @brief The constructor.
+     * @note The geometry will be empty and does not match any graph.
+     */
+    BondGeometry();
+
+    /**
+     * @brief Gives the initial vector of a bond.
+     */
+    Vector initial(const BondIndex bond) const {
+        return Vector{p_initials.x()[bond], p_initials.y()[bond], p_initials.z()[bond]};
+    }
+
+    /**
+     * @brief Gives the initial vectors of all the bonds.
+     */
+    const space::VectorBatch& initials() const;
+
+    /**
+     * @brief Gives the inverse of the initial length of a bond (zero for the bonds with zero length).
+     */
+    double inverseLength(const BondIndex bond) const {
+        return p_inverseLengths[bond];
+    }
+
+    /**
+     * @brief Gives the initial length of a bond.
+     */
+    double length(const BondIndex bond) const {
+        return p_lengths[bond];
+    }
+
+    /**
+     * @brief Gives the initial lengths of all the bonds.
+     */
+    const Scalars& lengths() const;
+
+    /**
+     * @brief Whether the geometry is computed for the current topology of the graph.
+     */
+    bool matches(const configuration::BondGraph& bonds) const;
+
+    /**
+     * @brief Gives the volume of the neighbor of a bond.
+     */
+    double neighborVolume(const BondIndex bond) const {
+        return p_neighborVolumes[bond];
+    }
+
+    /**
+     * @brief Gives the number of bonds.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gives the volume correction of a bond.
+     */
+    double volumeCorrection(const BondIndex bond) const {
+        return p_volumeCorrections[bond];
+    }
+
+    /**
+     * @brief Computes the geometry of the bonds of a graph.
+     * @param bonds The bonds.
+     * @param centreProperties The properties of the Part owning the bond centres.
+     * @param neighborProperties The properties of the Part owning the bond neighbors.
+     * @param volumeCorrection The volume correction of the bonds.
+     * @param time The time the volume correction is evaluated at.
+     * @throws If any of the bond neighbors has no volume.
+     */
+    void assign(const configuration::BondGraph& bonds,
+                const configuration::PropertyTable& centreProperties, const configuration::PropertyTable& neighborProperties,
+                const VolumeCorrection& volumeCorrection, const double time);
+
+    /**
+     * @brief Removes all the bonds.
+     */
+    void clear();
+
+private:
+    space::VectorBatch p_initials;                  // The initial vector of each bond.
+    Scalars p_inverseLengths;                       // The inverse of the initial length of each bond.
+    Scalars p_lengths;                              // The initial length of each bond.
+    Scalars p_neighborVolumes;                      // The volume of the neighbor of each bond.
+    configuration::BondGraph::Revision p_revision;  // The revision of the graph the geometry is computed for.
+    Scalars p_volumeCorrections;                    // The volume correction of each bond.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // BONDGEOMETRY_H
@@ -0,0 +1,35 @@
+//
+//  BondLanes.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "BondLanes.h"
+#include <stdexcept>
+#include <string>
+
+namespace rbs::relations::peridynamic {
+
+BondLanes::Vector BondLanes::force() const {
+    return p_currents.weightedSum(p_factors);
+}
+
+void BondLanes::setForce(const size_t index, const double magnitude) {
+    const auto length = p_currentLengths[index];
+    if (!(length > 0))
+        throw std::runtime_error("Vector of length " + std::to_string(length) + " cannot be normalized.");
+    p_factors[index] = magnitude / length;
+}
+
+void BondLanes::compute(const BondGeometry &geometry, const BondLanes::BondIndex begin, const BondLanes::BondIndex end) {
+    p_initials.assign(geometry.initials(), begin, end);
+    p_lengths.assign(geometry.lengths().begin() + begin, geometry.lengths().begin() + end);
+    space::VectorBatch::add(p_initials, p_deformations, p_currents);
+    space::VectorBatch::length(p_currents, p_currentLengths);
+    space::VectorBatch::stretch(p_lengths, p_currentLengths, p_stretches);
+    p_factors.assign(end - begin, 0.);
+}
+
+} // namespace rbs::relations::peridynamic
@@ -0,0 +1,122 @@
+//
+//  BondLanes.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDLANES_H
+#define BONDLANES_H
+
+#include "BondGeometry.h"
+#include "../../configuration/BondGraph.h"
+#include "../../space/VectorBatch.h"
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The BondLanes holds the bonds of a horizon (i.e., a row of a BondGraph) in the lanes of space::VectorBatch, so
+ *        the force loops compute the current bond vectors, their lengths and the stretches a batch of bonds at a time.
+ * @details A loop gathers the neighbor displacements of a row first (see gather()), then visits the bonds one by one to
+ *          skip the broken and the undeformed ones, to break the bonds and to set the force magnitude of the others (see
+ *          setForce()); the force of the centre is then the weighted sum of the current bond vectors (see force()).
+ *          The skipped bonds keep a zero force.
+ * @note The lanes are reused from row to row; thus, each thread must have its own BondLanes.
+ */
+class BondLanes
+{
+public:
+    using BondIndex = configuration::BondGraph::BondIndex;
+    using Scalars = space::VectorBatch::Scalars;
+    using Vector = space::vec3;
+
+    /**
+     * @brief Gives the current length of a bond of the row.
+     * @param index The position of the bond in the row.
+     */
+    double currentLength(const size_t index) const {
+        return p_currentLengths[index];
+    }
+
+    /**
+     * @brief Gives the deformation (i.e., the neighbor displacement minus the centre displacement) of a bond of the row.
+     * @param index The position of the bond in the row.
+     */
+    Vector deformation(const size_t index) const {
+        return Vector{p_deformations.x()[index], p_deformations.y()[index], p_deformations.z()[index]};
+    }
+
+    /**
+     * @brief Computes the force of the row centre (i.e., the sum of the force of each bond along its current vector).
+     */
+    Vector force() const;
+
+    /**
+     * @brief Gives the stretch of a bond of the row.
+     * @param index The position of the bond in the row.
+     */
+    double stretch(const size_t index) const {
+        return p_stretches[index];
+    }
+
+    /**
+     * @brief Gathers the bonds of a row and computes their current vectors, their current lengths and their stretches.
+     * @note The forces of the bonds are reset to zero.
+     * @param bonds The bonds.
+     * @param geometry The reference geometry of the bonds.
+     * @param row The row.
+     * @param centreDisp The displacement of the row centre.
+     * @param displacementOf The displacement of a bond neighbor, given its id.
+     */
+    template<typename DisplacementOf>
+    void gather(const configuration::BondGraph& bonds, const BondGeometry& geometry, const size_t row,
+                const Vector& centreDisp, const DisplacementOf& displacementOf) {
+        const auto begin = bonds.begin(row);
+        const auto size = bonds.end(row) - begin;
+        p_deformations.resize(size);
+        auto* x = p_deformations.x();
+        auto* y = p_deformations.y();
+        auto* z = p_deformations.z();
+        for (size_t index = 0; index < size; index++) {
+            const auto deformation = displacementOf(bonds.neighbor(begin + index)) - centreDisp;
+            x[index] = deformation[0];
+            y[index] = deformation[1];
+            z[index] = deformation[2];
+        }
+        compute(geometry, begin, begin + size);
+    }
+
+    /**
+     * @brief Sets the force magnitude of a bond of the row along its current bond vector.
+     * @param index The position of the bond in the row.
+     * @param magnitude The force magnitude.
+     * @throws If the current bond vector has zero length.
+     */
+    void setForce(const size_t index, const double magnitude);
+
+private:
+
+    /**
+     * @brief Computes the current vectors, the current lengths and the stretches of the gathered bonds.
+     * @param geometry The reference geometry of the bonds.
+     * @param begin The first bond of the row.
+     * @param end The bond after the last bond of the row.
+     */
+    void compute(const BondGeometry& geometry, const BondIndex begin, const BondIndex end);
+
+    Scalars p_currentLengths;               // The current length of each bond.
+    space::VectorBatch p_currents;          // The current vector of each bond.
+    space::VectorBatch p_deformations;      // The deformation of each bond.
+    Scalars p_factors;                      // The force magnitude over the current length of each bond.
+    space::VectorBatch p_initials;          // The initial vector of each bond.
+    Scalars p_lengths;                      // The initial length of each bond.
+    Scalars p_stretches;                    // The stretch of each bond.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // BONDLANES_H
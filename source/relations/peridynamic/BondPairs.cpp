@@ -0,0 +1,180 @@
+//
+//  BondPairs.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "BondPairs.h"
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+
+namespace rbs::relations::peridynamic {
+
+namespace {
+
+constexpr size_t blockRowsSize = 256;   // The number of rows of each block.
+constexpr auto flagsWordSize = configuration::BondStatuses::Flags::WordSize; // The number of bonds sharing a word of the bond status flags.
+
+/**
+ * @brief The BondKey denotes a bond by the ids of its ends.
+ */
+struct BondKey {
+    configuration::BondGraph::Id centre;        // The id of the bond centre.
+    configuration::BondGraph::Id neighbor;      // The id of the bond neighbor.
+    configuration::BondGraph::BondIndex bond;   // The bond index.
+
+    bool operator <(const BondKey& other) const {
+        return std::tie(centre, neighbor, bond) < std::tie(other.centre, other.neighbor, other.bond);
+    }
+};
+
+} // namespace
+
+BondPairs::BondPairs()
+    : p_blocks{}
+    , p_colors{0}
+    , p_pairs{}
+    , p_revision{0}
+{
+}
+
+const BondPairs::Blocks &BondPairs::blocks() const {
+    return p_blocks;
+}
+
+const BondPairs::Offsets &BondPairs::colors() const {
+    return p_colors;
+}
+
+size_t BondPairs::colorsSize() const {
+    return p_colors.size() - 1;
+}
+
+bool BondPairs::matches(const configuration::BondGraph &bonds) const {
+    return p_revision == bonds.revision();
+}
+
+const BondPairs::Pairs &BondPairs::pairs() const {
+    return p_pairs;
+}
+
+size_t BondPairs::size() const {
+    return p_pairs.size();
+}
+
+void BondPairs::assign(const configuration::BondGraph &bonds) {
+    clear();
+
+    constexpr auto noRow = std::numeric_limits<size_t>::max();
+    const auto& centres = bonds.centres();
+    const auto idsSize = (centres.empty()) ? 0 : *std::max_element(centres.begin(), centres.end()) + 1;
+    std::vector<size_t> rows(idsSize, noRow);
+    for (size_t row = 0; row < bonds.size(); row++)
+        rows[bonds.centre(row)] = row;
+
+    // The bonds sorted by the ids of their ends; thus, the reverse of each bond is found by a binary search.
+    std::vector<BondKey> keys;
+    keys.reserve(bonds.bondsSize());
+    for (size_t row = 0; row < bonds.size(); row++) {
+        for (auto bond = bonds.begin(row); bond < bonds.end(row); bond++)
+            keys.emplace_back(BondKey{bonds.centre(row), bonds.neighbor(bond), bond});
+    }
+    std::sort(keys.begin(), keys.end());
+
+    p_pairs.reserve(bonds.bondsSize() / 2 + 1);
+    Blocks blocks;
+    for (size_t row = 0; row < bonds.size(); row++) {
+        if (row % blockRowsSize == 0)
+            blocks.emplace_back(Block{p_pairs.size(), p_pairs.size()});
+
+        const auto centre = bonds.centre(row);
+        for (auto bond = bonds.begin(row); bond < bonds.end(row); bond++) {
+            const auto neighbor = bonds.neighbor(bond);
+            if (neighbor >= idsSize || rows[neighbor] == noRow)
+                throw std::runtime_error("The bond pairs can only be computed for the bonds between the centres of the same graph.");
+
+            // The first bond of the neighbor row ending on the centre.
+            const auto neighborRow = rows[neighbor];
+            const auto candidate = std::lower_bound(keys.begin(), keys.end(), BondKey{neighbor, centre, bonds.begin(neighborRow)});
+            const auto hasReverse = candidate != keys.end() && candidate->centre == neighbor && candidate->neighbor == centre
+                    && candidate->bond < bonds.end(neighborRow);
+            const auto reverse = (hasReverse) ? candidate->bond : noReverse;
+            if (centre < neighbor || reverse == noReverse)
+                p_pairs.emplace_back(Pair{bond, reverse, row, neighborRow});
+        }
+        blocks.back().end = p_pairs.size();
+    }
+
+    // Greedy coloring; the nodes and the status flag words are the resources that the blocks of a color must not share.
+    const auto wordsSize = bonds.bondsSize() / flagsWordSize + 1;
+    const auto resourcesSize = bonds.size() + wordsSize;
+    size_t stride = 1;                                      // The number of mask words per resource.
+    std::vector<std::uint64_t> masks(resourcesSize * stride, 0);
+    std::vector<size_t> colors(blocks.size(), 0);
+    std::vector<size_t> colorSizes;
+    std::vector<size_t> resources;
+    for (size_t block = 0; block < blocks.size(); block++) {
+        resources.clear();
+        for (auto pair = blocks[block].begin; pair < blocks[block].end; pair++) {
+            const auto& item = p_pairs[pair];
+            resources.emplace_back(item.centreRow);
+            resources.emplace_back(bonds.size() + item.bond / flagsWordSize);
+            if (item.reverse != noReverse) {
+                resources.emplace_back(item.neighborRow);
+                resources.emplace_back(bonds.size() + item.reverse / flagsWordSize);
+            }
+        }
+        std::sort(resources.begin(), resources.end());
+        resources.erase(std::unique(resources.begin(), resources.end()), resources.end());
+
+        size_t color = 0;
+        for (size_t word = 0; ; word++) {
+            if (word == stride) { // all the colors are taken; doubling the number of colors.
+                std::vector<std::uint64_t> grown(resourcesSize * stride * 2, 0);
+                for (size_t resource = 0; resource < resourcesSize; resource++)
+                    std::copy_n(masks.begin() + resource * stride, stride, grown.begin() + resource * stride * 2);
+                masks.swap(grown);
+                stride *= 2;
+            }
+            std::uint64_t taken = 0;
+            for (const auto resource : resources)
+                taken |= masks[resource * stride + word];
+            if (~taken) {
+                size_t bit = 0;
+                while ((taken >> bit) & 1)
+                    bit++;
+                color = word * 64 + bit;
+                break;
+            }
+        }
+
+        for (const auto resource : resources)
+            masks[resource * stride + color / 64] |= std::uint64_t(1) << (color % 64);
+        colors[block] = color;
+        if (color >= colorSizes.size())
+            colorSizes.resize(color + 1, 0);
+        colorSizes[color]++;
+    }
+
+    p_colors.assign(1, 0);
+    for (const auto colorSize : colorSizes)
+        p_colors.emplace_back(p_colors.back() + colorSize);
+    std::vector<size_t> positions(p_colors.begin(), p_colors.end() - 1);
+    p_blocks.resize(blocks.size());
+    for (size_t block = 0; block < blocks.size(); block++)
+        p_blocks[positions[colors[block]]++] = blocks[block];
+    p_revision = bonds.revision();
+}
+
+void BondPairs::clear() {
+    p_blocks.clear();
+    p_colors.assign(1, 0);
+    p_pairs.clear();
+    p_revision = 0;
+}
+
+} // namespace rbs::relations::peridynamic
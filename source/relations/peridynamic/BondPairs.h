@@ -0,0 +1,146 @@
+//
+//  BondPairs.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef BONDPAIRS_H
+#define BONDPAIRS_H
+
+#include "../../configuration/BondGraph.h"
+#include "../../parallel/threads.h"
+#include <limits>
+#include <vector>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The BondPairs stores the inner bonds of a BondGraph once per pair of nodes (i.e., the half bonds).
+ * @details Each pair holds the bond from the node with the smaller id to the other one and its reverse bond; thus, the
+ *          pairwise antisymmetric forces (e.g., of the bond-based peridynamic) can be evaluated once per pair and
+ *          applied to both ends. The bonds without a reverse (i.e., the neighborhoods that are not symmetric) are kept as
+ *          pairs without a reverse.
+ *          The pairs are in the order of their centre rows and split into blocks of consecutive rows. The blocks are
+ *          grouped by colors, where the blocks of a color share neither a node nor a word of the bond status flags (see
+ *          configuration::BondStatuses::Flags); thus, the blocks of a color can be processed on multiple threads
+ *          without a race, while the pairs of each block stay close in memory.
+ * @note The pairs are kept until the topology of the graph changes (see BondGraph::revision()).
+ */
+class BondPairs
+{
+public:
+    using BondIndex = configuration::BondGraph::BondIndex;
+    using Offsets = std::vector<size_t>;
+
+    /**
+     * @brief The Pair denotes the two bonds between two nodes.
+     */
+    struct Pair {
+        BondIndex bond;     // The bond from the centre with the smaller id (or the only bond of the pair).
+        BondIndex reverse;  // The reverse bond or noReverse if there is no reverse bond.
+        size_t centreRow;   // The row of the bond centre.
+        size_t neighborRow; // The row of the bond neighbor.
+    };
+
+    using Pairs = std::vector<Pair>;
+
+    /**
+     * @brief The Block denotes the pairs of a range of consecutive rows.
+     */
+    struct Block {
+        size_t begin;       // The position of the first pair of the block.
+        size_t end;         // The position after the last pair of the block.
+    };
+
+    using Blocks = std::vector<Block>;
+
+    /**
+     * @brief Denotes a pair without a reverse bond.
+     */
+    static constexpr BondIndex noReverse = std::numeric_limits<BondIndex>::max();
+
+    /**
+     * @brief The constructor.
+     * @note The pairs will be empty and do not match any graph.
+     */
+    BondPairs();
+
+    /**
+     * @brief Gives the blocks of the pairs, grouped by their colors.
+     */
+    const Blocks& blocks() const;
+
+    /**
+     * @brief Gives the position of the first block of each color on the blocks (plus the number of blocks at the end).
+     */
+    const Offsets& colors() const;
+
+    /**
+     * @brief Gives the number of colors.
+     */
+    size_t colorsSize() const;
+
+    /**
+     * @brief Runs a function on the pairs, color by color.
+     * @details The blocks of each color are shared between the threads, and the next color starts once all the blocks of
+     *          the color are done.
+     * @param threadsSize The number of the threads (see parallel::threadsSizeFor()).
+     * @param function The function receiving the thread index and a pair; it must be safe to call from multiple threads as
+     *                 long as it only writes to the nodes and the bonds of its pair.
+     * @throws The exception thrown by the function (see parallel::forEachRange()).
+     */
+    template<typename Function>
+    void forEach(const size_t threadsSize, const Function& function) const {
+        for (size_t color = 0; color < colorsSize(); color++) {
+            const auto first = p_colors[color];
+            const auto colorSize = p_colors[color + 1] - first;
+            parallel::forEachRange(colorSize, parallel::threadsSizeFor(threadsSize, colorSize), [&](const size_t thread, const size_t begin, const size_t end) {
+                for (auto block = first + begin; block < first + end; block++) {
+                    for (auto index = p_blocks[block].begin; index < p_blocks[block].end; index++)
+                        function(thread, p_pairs[index]);
+                }
+            });
+        }
+    }
+
+    /**
+     * @brief Whether the pairs are computed for the current topology of the graph.
+     */
+    bool matches(const configuration::BondGraph& bonds) const;
+
+    /**
+     * @brief Gives the pairs, in the order of their centre rows.
+     */
+    const Pairs& pairs() const;
+
+    /**
+     * @brief Gives the number of pairs.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Computes the pairs of the bonds of an inner graph (i.e., the neighbors are the centres of the same graph).
+     * @throws If any of the bond neighbors is not a centre of the graph.
+     */
+    void assign(const configuration::BondGraph& bonds);
+
+    /**
+     * @brief Removes all the pairs.
+     */
+    void clear();
+
+private:
+    Blocks p_blocks;                                // The blocks grouped by their colors.
+    Offsets p_colors;                               // The position of the first block of each color.
+    Pairs p_pairs;                                  // The pairs in the order of their centre rows.
+    configuration::BondGraph::Revision p_revision;  // The revision of the graph the pairs are computed for.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // BONDPAIRS_H
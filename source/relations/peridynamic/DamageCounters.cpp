@@ -0,0 +1,81 @@
+//
+//  DamageCounters.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "DamageCounters.h"
+
+namespace rbs::relations::peridynamic {
+
+DamageCounters::DamageCounters()
+    : p_counts{}
+    , p_flagsRevision{0}
+    , p_records(1)
+    , p_revision{0}
+{
+}
+
+void DamageCounters::prepare(const size_t threadsSize) {
+    p_records.resize(std::max<size_t>(1, threadsSize));
+    for (auto& records : p_records)
+        records.clear();
+}
+
+void DamageCounters::prepareStatuses(const DamageCounters::Horizons &horizons, const size_t threadsSize) {
+    const auto& statuses = (horizons.empty()) ? nullptr : horizons.front()->bondStatuses();
+    if (!statuses || !statuses->size())
+        return;
+
+    const auto concurrent = threadsSize > 1;
+    if (concurrent)
+        statuses->activate(Property::Damage, int(1));
+    statuses->setConcurrent(Property::Damage, concurrent);
+}
+
+void DamageCounters::update(const DamageCounters::Horizons &horizons, const configuration::BondGraph &bonds, configuration::PropertyTable &properties,
+                            const size_t threadsSize, const parallel::Scheduling scheduling, const size_t chunkSize) {
+    const auto brokenBonds = bonds.statuses().flags(Property::Damage);
+    const auto flagsRevision = (brokenBonds) ? brokenBonds->revision() : 0;
+    if (brokenBonds)
+        keys::Damage::column(properties); // activated before the threads write to it.
+
+    auto matches = p_revision == bonds.revision() && p_counts.size() == bonds.size();
+    if (matches) {
+        auto recorded = p_flagsRevision;
+        for (const auto& records : p_records)
+            recorded += records.size();
+        matches = recorded == flagsRevision;
+    }
+
+    if (matches) {
+        for (const auto& records : p_records) {
+            for (const auto row : records)
+                p_counts[row]++;
+        }
+        for (const auto& records : p_records) {
+            for (const auto row : records)
+                setDamage(horizons, bonds, row);
+        }
+    } else {
+        p_counts.assign(bonds.size(), 0);
+        parallel::forEach(bonds.size(), threadsSize, scheduling, chunkSize, [&](const size_t, const size_t begin, const size_t end) {
+            for (auto row = begin; row < end; row++) {
+                p_counts[row] = (brokenBonds) ? brokenBonds->count(bonds.begin(row), bonds.end(row)) : 0;
+                if (keys::Damage::has(*horizons[row]->centre()) || p_counts[row] != 0)
+                    setDamage(horizons, bonds, row);
+            }
+        });
+        p_revision = bonds.revision();
+    }
+    p_flagsRevision = flagsRevision;
+    prepare(p_records.size());
+}
+
+void DamageCounters::setDamage(const DamageCounters::Horizons &horizons, const configuration::BondGraph &bonds, const size_t row) const {
+    keys::Damage::set(*horizons[row]->centre(), double(p_counts[row]) / double(bonds.end(row) - bonds.begin(row)));
+}
+
+} // namespace rbs::relations::peridynamic
@@ -0,0 +1,98 @@
+//
+//  DamageCounters.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef DAMAGECOUNTERS_H
+#define DAMAGECOUNTERS_H
+
+#include "Property.h"
+#include "PropertyKeys.h"
+#include "../../configuration/Part.h"
+#include "../../parallel/threads.h"
+#include <vector>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The DamageCounters keeps the number of the broken bonds of each horizon and updates the Damage of the horizon
+ *        centres incrementally.
+ * @details The force loops record the rows whose bonds they break (see record()); then, update() adds them to the
+ *          counters and only sets the Damage of those centres. Thus, a step without a new broken bond does no work.
+ *          The counters are recounted from the bond statuses, and the Damage of all the centres is set, when the topology
+ *          of the bonds changes or when the broken bond flags changed other than by the recorded bonds (e.g., the bonds
+ *          broken by a custom bond force relationship or by another relation, or repaired), which is detected by the
+ *          revision of the flags (see configuration::BondStatuses::Flags::revision()).
+ * @note Each thread must only record the rows it writes to (see HorizonBlocks and BondPairs).
+ */
+class DamageCounters
+{
+public:
+    using Horizons = configuration::Part::NeighborhoodPtrs;
+
+    /**
+     * @brief The constructor.
+     * @note The counters will be empty and recounted on the first update.
+     */
+    DamageCounters();
+
+    /**
+     * @brief Clears the recorded rows; called before the force loops.
+     * @param threadsSize The number of the threads recording the rows.
+     */
+    void prepare(const size_t threadsSize);
+
+    /**
+     * @brief Prepares the Damage statuses of the bonds of the horizons for the force loops; called before them.
+     * @details With more than one thread, the Damage is activated with int(1), the value the bonds are broken with, and
+     *          made concurrent (see configuration::BondStatuses::setConcurrent()); thus, the threads breaking the bonds
+     *          only write to the bits of their bonds. With a single thread, any value can be set again.
+     * @param horizons The horizons (i.e., neighborhoods), attached to the statuses of their bonds.
+     * @param threadsSize The number of the threads running the force loops.
+     */
+    static void prepareStatuses(const Horizons& horizons, const size_t threadsSize);
+
+    /**
+     * @brief Records a newly broken bond of a row.
+     * @param thread The index of the recording thread.
+     * @param row The row (i.e., the horizon) of the broken bond.
+     */
+    void record(const size_t thread, const size_t row) {
+        p_records[thread].emplace_back(row);
+    }
+
+    /**
+     * @brief Adds the recorded rows to the counters and sets the Damage of their centres, or recounts all of them.
+     * @param horizons The horizons (i.e., neighborhoods) of the Part.
+     * @param bonds The inner bonds of the horizons.
+     * @param properties The properties of the Part nodes.
+     * @param threadsSize The number of the threads recounting the counters (see parallel::threadsSizeFor()).
+     * @param scheduling How the horizons are shared between the threads when recounting.
+     * @param chunkSize The number of the horizons of each chunk of the chunked scheduling.
+     */
+    void update(const Horizons& horizons, const configuration::BondGraph& bonds, configuration::PropertyTable& properties,
+                const size_t threadsSize, const parallel::Scheduling scheduling, const size_t chunkSize);
+
+private:
+    using Records = std::vector<size_t>;
+
+    /**
+     * @brief Sets the Damage of a horizon centre from its counter.
+     */
+    void setDamage(const Horizons& horizons, const configuration::BondGraph& bonds, const size_t row) const;
+
+    std::vector<size_t> p_counts;                   // The number of the broken bonds of each row.
+    size_t p_flagsRevision;                         // The revision of the broken bond flags the counters are computed for.
+    std::vector<Records> p_records;                 // The rows recorded by each thread.
+    configuration::BondGraph::Revision p_revision;  // The revision of the bonds the counters are computed for.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // DAMAGECOUNTERS_H
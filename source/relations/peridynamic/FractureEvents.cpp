@@ -0,0 +1,77 @@
+//
+//  FractureEvents.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "FractureEvents.h"
+#include <algorithm>
+
+namespace rbs::relations::peridynamic {
+
+FractureEvents::FractureEvents(const std::string &path, const std::string &name, const size_t capacity)
+    : p_capacity{capacity}
+    , p_file(path, name, "csv")
+    , p_lostSize{0}
+    , p_rings{}
+    , p_size{0}
+    , p_step{0}
+{
+    if (!p_capacity)
+        throw std::out_of_range("The fracture events cannot be recorded into empty buffers.");
+
+    p_file.maxColumn() = 4;
+    p_file.appendCell("Step", false);
+    p_file.appendCell("Centre", false);
+    p_file.appendCell("Neighbor", false);
+    p_file.appendCell("Stretch", true);
+    prepare(0, 1);
+}
+
+size_t FractureEvents::capacity() const {
+    return p_capacity;
+}
+
+size_t FractureEvents::lostSize() const {
+    return p_lostSize;
+}
+
+size_t FractureEvents::size() const {
+    return p_size;
+}
+
+size_t FractureEvents::drain() {
+    size_t lost = 0;
+    size_t remaining = 0;
+    for (const auto& ring : p_rings)
+        remaining += std::min(ring.written, p_capacity);
+
+    for (auto& ring : p_rings) {
+        const auto first = (ring.written > p_capacity) ? ring.written - p_capacity : 0;
+        for (auto index = first; index < ring.written; index++) {
+            const auto& event = ring.events[index % p_capacity];
+            remaining--;
+            p_file.appendCell(event.step, false, false);
+            p_file.appendCell(event.centre, false, false);
+            p_file.appendCell(event.neighbor, false, false);
+            p_file.appendCell(event.stretch, remaining == 0, true);
+        }
+        p_size += ring.written - first;
+        lost += first;
+        ring.written = 0;
+    }
+    p_lostSize += lost;
+    return lost;
+}
+
+void FractureEvents::prepare(const size_t step, const size_t threadsSize) {
+    p_step = step;
+    if (p_rings.size() < threadsSize)
+        p_rings.resize(threadsSize); // never shrunk, since a ring may hold events not drained yet.
+    for (auto& ring : p_rings)
+        ring.events.resize(p_capacity);
+}
+
+} // namespace rbs::relations::peridynamic
@@ -0,0 +1,121 @@
+//
+//  FractureEvents.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef FRACTUREEVENTS_H
+#define FRACTUREEVENTS_H
+
+#include "../../configuration/BondGraph.h"
+#include "../../exporting/CSVFile.h"
+#include <vector>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The FractureEvents logs the bonds broken by the brittle bond force laws and exports them to a CSV file, a row
+ *        per broken bond: the time step, the centre id, the neighbor id and the stretch the bond broke at.
+ * @details The force loops record the events into a ring buffer per thread (see record()); thus, the threads never
+ *          share a buffer and need no lock. The buffers are drained to the file after each time step (see drain()).
+ *          A bond broken at both of its ends (e.g., the inner bonds) is logged once per end.
+ *          Compared to exporting the Damage of all the nodes every few steps, the log keeps the crack path at the full
+ *          time resolution at a fraction of the size.
+ * @note If a thread breaks more bonds than its buffer holds in a single time step, its oldest events are lost
+ *       (see drain()).
+ * @note The class is not copiable or moveable (see exporting::CSVFile).
+ */
+class FractureEvents
+{
+public:
+    using Id = configuration::BondGraph::Id;
+
+    /**
+     * @brief The Event denotes a broken bond.
+     */
+    struct Event {
+        size_t step;        // The time step the bond broke at.
+        Id centre;          // The id of the centre node of the bond.
+        Id neighbor;        // The id of the neighbor node of the bond (in the neighbor Part, for the connection bonds).
+        double stretch;     // The stretch the bond broke at.
+    };
+
+    /**
+     * @brief The constructor.
+     * @note The content of the file, if any, will be removed and the header row will be written.
+     * @param path The directory path of the file.
+     * @param name The name of the file (without the extension).
+     * @param capacity The number of the events each thread can record in a time step.
+     * @throws If the capacity is zero.
+     */
+    explicit FractureEvents(const std::string& path, const std::string& name, const size_t capacity = 4096);
+
+    /**
+     * @brief Gives the number of the events each thread can record in a time step.
+     */
+    size_t capacity() const;
+
+    /**
+     * @brief Gives the number of the events lost since the construction (see drain()).
+     */
+    size_t lostSize() const;
+
+    /**
+     * @brief Gives the number of the events exported to the file since the construction.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Writes the recorded events to the file and clears the buffers.
+     * @return The number of the events lost since the last drain (i.e., overwritten in the full buffers).
+     */
+    size_t drain();
+
+    /**
+     * @brief Prepares the buffers for a time step; called before the force loops.
+     * @note The events recorded and not drained yet are kept; thus, the buffers only grow with the number of the threads.
+     * @param step The time step of the events to record.
+     * @param threadsSize The number of the threads recording the events.
+     */
+    void prepare(const size_t step, const size_t threadsSize);
+
+    /**
+     * @brief Records a broken bond.
+     * @note When the buffer of the thread is full, the event overwrites the oldest one.
+     * @param thread The index of the recording thread.
+     * @param centre The id of the centre node of the bond.
+     * @param neighbor The id of the neighbor node of the bond.
+     * @param stretch The stretch the bond broke at.
+     */
+    void record(const size_t thread, const Id centre, const Id neighbor, const double stretch) {
+        auto& ring = p_rings[thread];
+        ring.events[ring.written % p_capacity] = Event{p_step, centre, neighbor, stretch};
+        ring.written++;
+    }
+
+private:
+
+    /**
+     * @brief The Ring denotes the buffer of the events recorded by a thread.
+     */
+    struct Ring {
+        std::vector<Event> events;  // The events, holding the capacity events.
+        size_t written;             // The number of the events recorded since the last drain.
+    };
+
+    size_t p_capacity;              // The number of the events each thread can record in a time step.
+    exporting::CSVFile p_file;      // The file of the events.
+    size_t p_lostSize;              // The number of the events lost since the construction.
+    std::vector<Ring> p_rings;      // The buffer of each thread.
+    size_t p_size;                  // The number of the events exported to the file since the construction.
+    size_t p_step;                  // The time step of the events being recorded.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // FRACTUREEVENTS_H
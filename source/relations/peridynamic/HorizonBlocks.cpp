@@ -0,0 +1,83 @@
+//
+//  HorizonBlocks.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "HorizonBlocks.h"
+#include <algorithm>
+
+namespace rbs::relations::peridynamic {
+
+namespace {
+
+constexpr auto flagsWordSize = configuration::BondStatuses::Flags::WordSize; // The number of bonds sharing a word of the bond status flags.
+
+} // namespace
+
+HorizonBlocks::HorizonBlocks()
+    : p_blocks{}
+    , p_chunkSize{0}
+    , p_evenSize{0}
+    , p_requestedThreadsSize{1}
+    , p_revision{0}
+    , p_rowsSize{0}
+    , p_scheduling{Scheduling::Static}
+    , p_threadsSize{1}
+{
+}
+
+const HorizonBlocks::Blocks &HorizonBlocks::blocks() const {
+    return p_blocks;
+}
+
+bool HorizonBlocks::matches(const configuration::BondGraph &bonds, const size_t threadsSize, const HorizonBlocks::Scheduling scheduling, const size_t chunkSize) const {
+    return p_revision == bonds.revision()
+            && p_rowsSize == bonds.size()
+            && p_requestedThreadsSize == threadsSize
+            && p_scheduling == scheduling
+            && p_chunkSize == chunkSize;
+}
+
+size_t HorizonBlocks::threadsSize() const {
+    return p_threadsSize;
+}
+
+void HorizonBlocks::assign(const configuration::BondGraph &bonds, const size_t threadsSize, const HorizonBlocks::Scheduling scheduling, const size_t chunkSize) {
+    p_chunkSize = chunkSize;
+    p_requestedThreadsSize = threadsSize;
+    p_revision = bonds.revision();
+    p_rowsSize = bonds.size();
+    p_scheduling = scheduling;
+    p_threadsSize = parallel::threadsSizeFor(threadsSize, p_rowsSize);
+
+    Blocks blocks;
+    if (p_threadsSize > 1) {
+        const auto blockBondsSize = (scheduling == Scheduling::Static) ? bonds.bondsSize() / (2 * p_threadsSize) : 0;
+        const auto blockRowsSize = (scheduling == Scheduling::Static) ? 1 : std::max<size_t>(1, chunkSize);
+        size_t begin = 0;
+        for (size_t row = 0; row < p_rowsSize; row++) {
+            const auto size = bonds.end(row) - bonds.begin(begin);
+            if (row + 1 - begin >= blockRowsSize && size >= std::max(blockBondsSize, flagsWordSize)) {
+                blocks.emplace_back(Block{begin, row + 1});
+                begin = row + 1;
+            }
+        }
+        if (begin < p_rowsSize)
+            blocks.emplace_back(Block{begin, p_rowsSize});
+    } else {
+        blocks.emplace_back(Block{0, p_rowsSize});
+    }
+
+    p_blocks.clear();
+    p_blocks.reserve(blocks.size());
+    for (size_t block = 0; block < blocks.size(); block += 2)
+        p_blocks.emplace_back(blocks[block]);
+    p_evenSize = p_blocks.size();
+    for (size_t block = 1; block < blocks.size(); block += 2)
+        p_blocks.emplace_back(blocks[block]);
+}
+
+} // namespace rbs::relations::peridynamic
@@ -0,0 +1,123 @@
+//
+//  HorizonBlocks.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef HORIZONBLOCKS_H
+#define HORIZONBLOCKS_H
+
+#include "../../configuration/BondGraph.h"
+#include "../../parallel/threads.h"
+#include <vector>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The HorizonBlocks splits the horizons (i.e., the rows of a BondGraph) into blocks of consecutive rows that can
+ *        be processed on multiple threads.
+ * @details The loops over the horizons only write to their own centres and bonds; however, the bond status flags of
+ *          neighboring rows may share a word (see configuration::BondStatuses::Flags). Thus, every block but the last
+ *          holds at least a word of bonds and the blocks are processed in two phases, first the even blocks and then
+ *          the odd ones; the blocks of a phase share no word of the flags.
+ *          With the static scheduling, there are two blocks per thread holding about the same number of bonds; with the
+ *          chunked scheduling, the blocks hold the chunk size rows (or more to fill a word) and the threads take the
+ *          next block whenever they are done with their last one (see parallel::Scheduling).
+ * @note The blocks are kept until the topology of the graph or the threading changes.
+ */
+class HorizonBlocks
+{
+public:
+    using Scheduling = parallel::Scheduling;
+
+    /**
+     * @brief The Block denotes a range of consecutive rows.
+     */
+    struct Block {
+        size_t begin;       // The first row of the block.
+        size_t end;         // The row after the last row of the block.
+    };
+
+    using Blocks = std::vector<Block>;
+
+    /**
+     * @brief The constructor.
+     * @note The blocks will be empty and do not match any graph.
+     */
+    HorizonBlocks();
+
+    /**
+     * @brief Gives the blocks, the even ones followed by the odd ones.
+     */
+    const Blocks& blocks() const;
+
+    /**
+     * @brief Runs a function on the rows of the graph, block by block.
+     * @note With a single thread the function is called once, on the calling thread, with all the rows.
+     * @param function The function receiving the thread index, the begin and the end of a block of rows; it must be safe
+     *                 to call from multiple threads as long as it only writes to the centres and the bonds of its rows.
+     * @throws The exception thrown by the function (see parallel::forEachRange()).
+     */
+    template<typename Function>
+    void forEach(const Function& function) const {
+        if (p_threadsSize <= 1 || p_blocks.size() <= 1) {
+            function(size_t(0), size_t(0), p_rowsSize);
+            return;
+        }
+
+        for (const auto phase : {Phase{0, p_evenSize}, Phase{p_evenSize, p_blocks.size()}}) {
+            const auto run = [&](const size_t thread, const size_t begin, const size_t end) {
+                for (auto block = phase.begin + begin; block < phase.begin + end; block++)
+                    function(thread, p_blocks[block].begin, p_blocks[block].end);
+            };
+            parallel::forEach(phase.end - phase.begin, p_threadsSize, p_scheduling, 1, run);
+        }
+    }
+
+    /**
+     * @brief Whether the blocks are computed for the current topology of the graph and the given threading.
+     */
+    bool matches(const configuration::BondGraph& bonds, const size_t threadsSize, const Scheduling scheduling, const size_t chunkSize) const;
+
+    /**
+     * @brief Gives the number of the threads processing the blocks.
+     */
+    size_t threadsSize() const;
+
+    /**
+     * @brief Splits the rows of the graph into blocks.
+     * @param bonds The graph.
+     * @param threadsSize The number of the threads (see parallel::threadsSizeFor()).
+     * @param scheduling How the blocks are shared between the threads.
+     * @param chunkSize The number of the rows of each block of the chunked scheduling.
+     */
+    void assign(const configuration::BondGraph& bonds, const size_t threadsSize, const Scheduling scheduling, const size_t chunkSize);
+
+private:
+
+    /**
+     * @brief The Phase denotes the blocks processed at the same time.
+     */
+    struct Phase {
+        size_t begin;       // The position of the first block of the phase.
+        size_t end;         // The position after the last block of the phase.
+    };
+
+    Blocks p_blocks;                                // The even blocks followed by the odd blocks.
+    size_t p_chunkSize;                             // The number of the rows of each block of the chunked scheduling.
+    size_t p_evenSize;                              // The number of the even blocks.
+    size_t p_requestedThreadsSize;                  // The requested number of threads.
+    configuration::BondGraph::Revision p_revision;  // The revision of the graph the blocks are computed for.
+    size_t p_rowsSize;                              // The number of the rows of the graph.
+    Scheduling p_scheduling;                        // How the blocks are shared between the threads.
+    size_t p_threadsSize;                           // The number of the threads processing the blocks.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // HORIZONBLOCKS_H
@@ -7,6 +7,7 @@
 //
 
 #include "OrdinaryStateBased.h"
+#include "../../parallel/threads.h"
 
 namespace rbs::relations::peridynamic {
 
@@ -14,11 +15,19 @@ OrdinaryStateBased::OrdinaryStateBased(OrdinaryStateBased::BondForceRelationship
                                        OrdinaryStateBased::VolumeCorrection volumeCurrection,
                                        OrdinaryStateBased::PDPart &part, const bool override)
     : Base(0, part, [](const SimulationTime&, PDPart&) {} )
+    , p_blocks{}
     , p_bondForceRelationship{ bondForceRelationship }
+    , p_chunkSize{ 256 }
+    , p_damages{}
     , p_dt{ 0 }
+    , p_events{ nullptr }
+    , p_geometry{}
     , p_includeMaximumStretch{ false }
+    , p_kernel{ nullptr }
     , p_lastTime{ 0 }
     , p_maximumStretchIncluded{ false }
+    , p_scheduling{ parallel::Scheduling::Static }
+    , p_threadsSize{ 1 }
     , p_time{ Analyse::time() }
     , p_volumeCurrention{ volumeCurrection }
 {
@@ -33,6 +42,11 @@ OrdinaryStateBased::OrdinaryStateBased(OrdinaryStateBased::BondForceRelationship
         auto& logger = Logger::centre();
         logger.log(Logger::Broadcast::Process, "Applying ordinary state-based peridynamic to \"" + part.name() + "\" Part.");
 
+        if (!part.bonds().matches(part.neighborhoods()))
+            part.updateBonds();
+        updateGeometry(part.bonds(), part.properties(), part.properties());
+        updateBlocks(part);
+
         if (space::isZero(p_dt)) {
             const auto start_t = clock();
 
@@ -66,7 +80,11 @@ OrdinaryStateBased::OrdinaryStateBased(OrdinaryStateBased::BondForceRelationship
         updateDilatation(part);
 
         logger.log(Logger::Broadcast::Process,  "Computing and updating nodal forces.");
-        updateForces(part.neighborhoods(), override);
+        if (p_kernel)
+            updateKernelForces(part, override);
+        else
+            updateForces(part.neighborhoods(), part.bonds(), part.properties(), override);
+        drainFractureEvents();
         updatePartDamages(part);
         updateMaximumStretch(part);
 
@@ -93,6 +111,14 @@ OrdinaryStateBased::OrdinaryStateBased(OrdinaryStateBased::BondForceRelationship
     });
 }
 
+OrdinaryStateBased::OrdinaryStateBased(std::shared_ptr<OrdinaryStateBasedKernel> kernel,
+                                       OrdinaryStateBased::VolumeCorrection volumeCurrection,
+                                       OrdinaryStateBased::PDPart &part, const bool override)
+    : OrdinaryStateBased(BondForceRelationship{}, volumeCurrection, part, override)
+{
+    p_kernel = kernel;
+}
+
 OrdinaryStateBased OrdinaryStateBased::BrittleFracture(const double maxStretch,
                                                        const double bulkModulus, const double shearModulus,
                                                        const double gridSpacing, const double horizonRadius,
@@ -141,40 +167,7 @@ OrdinaryStateBased OrdinaryStateBased::BrittleFracture(const double maxPositiveS
     const auto upperBond = horizonRadius + gridSpacing / 2;
     const auto lowerBond = horizonRadius - gridSpacing / 2;
     return OrdinaryStateBased(
-        [bulkModulus, shearModulus, maxPositiveStretch, maxNegativeStretch, isInFracturableArea](const SimulationTime, const Vector& initial, const Vector& deformation, const HorizonPtr& centerHorizon, const HorizonPtr& neighborHorizon) -> Vector{
-            if (initial.isZero()) {
-                return space::consts::o3D;
-            }
-
-            bool isElastic = !isInFracturableArea(centerHorizon, neighborHorizon);
-            if (!isElastic && centerHorizon->hasStatus(neighborHorizon, Property::Damage)) {
-                return space::consts::o3D;
-            }
-
-            const auto initialLength = initial.length();
-            const auto currentBondVec = initial + deformation;
-            const auto e = currentBondVec.length() - initialLength;
-            const auto stretch = e / initialLength;
-
-            if (centerHorizon->centre()->has(Property::MaximumStretch)) {
-                if (abs(stretch) > abs(centerHorizon->centre()->at(Property::MaximumStretch).value<double>())) {
-                    centerHorizon->centre()->at(Property::MaximumStretch) = stretch;
-                }
-            }
-
-            if (isElastic || ( maxNegativeStretch <= stretch && stretch <= maxPositiveStretch )) {
-                const auto th_c = centerHorizon->centre()->at(Property::Dilatation).value<double>();
-                const auto th_n = neighborHorizon->centre()->at(Property::Dilatation).value<double>();
-                const auto m_c = centerHorizon->centre()->at(Property::WeightedVolume).value<double>();
-                const auto m_n = neighborHorizon->centre()->at(Property::WeightedVolume).value<double>();
-
-                return ((3 * bulkModulus - 5 * shearModulus) * (th_c / m_c + th_n / m_n) * initialLength
-                        + 15 * shearModulus * (1 / m_c + 1 / m_n) * e)
-                       * currentBondVec.unit();
-            }
-            centerHorizon->setStatus(neighborHorizon, Property::Damage, int(1));
-            return space::consts::o3D;
-        },
+        std::make_shared<OrdinaryStateBasedKernel>(bulkModulus, shearModulus, maxPositiveStretch, maxNegativeStretch, isInFracturableArea),
         [gridSpacing, horizonRadius, upperBond, lowerBond](const SimulationTime, const Vector& initial, const Vector&) -> double {
             const double initialDistance = initial.length();
             if (initialDistance < lowerBond) {
@@ -203,31 +196,7 @@ OrdinaryStateBased OrdinaryStateBased::Elastic(const double bulkModulus, const d
     const auto upperBond = horizonRadius + gridSpacing / 2;
     const auto lowerBond = horizonRadius - gridSpacing / 2;
     return OrdinaryStateBased(
-        [bulkModulus, shearModulus](const SimulationTime, const Vector& initial, const Vector& deformation, const HorizonPtr& centerHorizon, const HorizonPtr& neighborHorizon) -> Vector{
-            if (initial.isZero()) {
-                return space::consts::o3D;
-            }
-
-            const auto initialLength = initial.length();
-            const auto currentBondVec = initial + deformation;
-            const auto e = currentBondVec.length() - initialLength;
-            const auto stretch = e / initialLength;
-
-            if (centerHorizon->centre()->has(Property::MaximumStretch)) {
-                if (abs(stretch) > abs(centerHorizon->centre()->at(Property::MaximumStretch).value<double>())) {
-                    centerHorizon->centre()->at(Property::MaximumStretch) = stretch;
-                }
-            }
-
-            const auto th_c = centerHorizon->centre()->at(Property::Dilatation).value<double>();
-            const auto th_n = neighborHorizon->centre()->at(Property::Dilatation).value<double>();
-            const auto m_c = centerHorizon->centre()->at(Property::WeightedVolume).value<double>();
-            const auto m_n = neighborHorizon->centre()->at(Property::WeightedVolume).value<double>();
-
-            return ((3 * bulkModulus - 5 * shearModulus) * (th_c / m_c + th_n / m_n) * initialLength
-                       + 15 * shearModulus * (1 / m_c + 1 / m_n) * e)
-                   * currentBondVec.unit();
-        },
+        std::make_shared<OrdinaryStateBasedKernel>(bulkModulus, shearModulus),
         [gridSpacing, horizonRadius, upperBond, lowerBond](const SimulationTime, const Vector& initial, const Vector&) -> double {
             const double initialDistance = initial.length();
             if (initialDistance < lowerBond) {
@@ -247,118 +216,177 @@ void OrdinaryStateBased::includeMaximumStretch(const bool include) {
 
 void OrdinaryStateBased::setBondForceRelationship(const OrdinaryStateBased::BondForceRelationship &relationship) {
     p_bondForceRelationship = relationship;
+    p_kernel = nullptr;
 }
 
-void OrdinaryStateBased::updateCentreForce(const OrdinaryStateBased::HorizonPtr &horizon, const bool override) const {
-    const auto& centre = horizon->centre();
-    const auto centreInitialPosition = centre->initialPosition().value<space::Point<3> >();
-    const auto centreDisp = (centre->has(Property::Displacement)) ? centre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-    auto force = space::consts::o3D;
-    const auto& neighbors = horizon->neighbors();
-    std::for_each(neighbors.begin(), neighbors.end(), [&](const PDPart::NeighborhoodPtr& neighbor) {
-        const auto& neighborCentre = neighbor->centre();
-        const auto neighborDisp = (neighborCentre->has(Property::Displacement)) ? neighborCentre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-        const auto initialBondVector = neighborCentre->initialPosition().value<space::Point<3> >().positionVector() - centreInitialPosition.positionVector();
-        const auto deformation = neighborDisp - centreDisp;
-
-        if (!neighborCentre->has(Property::Volume))
-            throw std::runtime_error("The ordinary state-based peridynmaic cannot proceed without volume at all of the Nodes.");
-
-        force += 0.5 * neighborCentre->at(Property::Volume).value<double>()
-                * p_volumeCurrention(p_time, initialBondVector, deformation)
-                * p_bondForceRelationship(p_time, initialBondVector, deformation, horizon, neighbor);
-    });
-
+void OrdinaryStateBased::setForce(configuration::Node &centre, const OrdinaryStateBased::Vector &force, const bool override) {
     if (override) {
-        if (centre->has(Property::Force)) {
-            centre->at(Property::Force) = force;
+        if (centre.has(Property::Force)) {
+            keys::Force::set(centre, force);
         } else {
             // has no force means the force is zero, thus only override it if the computed force is not zero.
             if (!force.isZero()) {
-                centre->at(Property::Force) = force;
+                keys::Force::set(centre, force);
             }
         }
     } else { // appending the force
         if (!force.isZero()) { // if the computed force is not zero
-            if (centre->has(Property::Force)) {
-                centre->at(Property::Force) = centre->at(Property::Force).value<Vector>() + force;
+            if (centre.has(Property::Force)) {
+                keys::Force::set(centre, keys::Force::get(centre) + force);
             } else {
-                centre->at(Property::Force) = force;
+                keys::Force::set(centre, force);
             }
         } // else the state of node force does not need to be changed.
     }
 }
 
+void OrdinaryStateBased::setFractureEvents(const std::shared_ptr<FractureEvents> &events) {
+    p_events = events;
+}
+
+void OrdinaryStateBased::setScheduling(const parallel::Scheduling scheduling, const size_t chunkSize) {
+    p_scheduling = scheduling;
+    p_chunkSize = chunkSize;
+}
+
+void OrdinaryStateBased::setThreadsSize(const size_t threadsSize) {
+    p_threadsSize = threadsSize;
+}
+
+void OrdinaryStateBased::updateBlocks(OrdinaryStateBased::PDPart &part) {
+    const auto& bonds = part.bonds();
+    if (!p_blocks.matches(bonds, p_threadsSize, p_scheduling, p_chunkSize))
+        p_blocks.assign(bonds, p_threadsSize, p_scheduling, p_chunkSize);
+    DamageCounters::prepareStatuses(part.neighborhoods(), p_blocks.threadsSize());
+    auto& properties = part.properties();
+    keys::typeColumns(properties);
+    if (p_blocks.threadsSize() <= 1)
+        return;
+
+    // Activating a property column allocates it; thus, it cannot happen on multiple threads.
+    keys::Dilatation::column(properties);
+    keys::Force::column(properties);
+    keys::WeightedVolume::column(properties);
+}
+
+void OrdinaryStateBased::updateCentreForce(const OrdinaryStateBased::HorizonPtr &horizon, const configuration::BondGraph &bonds, const BondGeometry &geometry, const size_t row,
+                                           const configuration::PropertyTable &neighborProperties, const bool override) const {
+    const auto& centre = horizon->centre();
+    const auto& centreDisp = keys::Displacement::getOr(*centre, space::consts::o3D);
+    const auto displacements = neighborProperties.column(Property::Displacement);
+    auto force = space::consts::o3D;
+    const auto& neighbors = horizon->neighbors();
+    const auto begin = bonds.begin(row);
+    for (auto bond = begin; bond < bonds.end(row); bond++) {
+        const auto& neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(bond), space::consts::o3D);
+        const auto initialBondVector = geometry.initial(bond);
+        const auto deformation = neighborDisp - centreDisp;
+
+        force += 0.5 * geometry.neighborVolume(bond)
+                * geometry.volumeCorrection(bond)
+                * p_bondForceRelationship(p_time, initialBondVector, deformation, horizon, neighbors[bond - begin]);
+    }
+
+    setForce(*centre, force, override);
+}
+
 void OrdinaryStateBased::updateDilatation(OrdinaryStateBased::PDPart &part) const {
+    if (p_kernel) {
+        p_kernel->updateDilatations(part.neighborhoods(), part.bonds(), p_geometry, p_blocks, part.properties());
+        return;
+    }
+
     const auto& horizons = part.neighborhoods();
-    std::for_each(horizons.begin(), horizons.end(), [&](const PDPart::NeighborhoodPtr& horizon) {
-        const auto& centre = horizon->centre();
-        const auto centreInitialPosition = centre->initialPosition().value<space::Point<3> >();
-        const auto centreDisp = (centre->has(Property::Displacement)) ? centre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-
-        auto dilatation = 0.;
-        const auto& neighborHorizons = horizon->neighbors();
-        std::for_each(neighborHorizons.begin(), neighborHorizons.end(), [&](const PDPart::NeighborhoodPtr& neighborHorizon) {
-            const auto& neighborCentre = neighborHorizon->centre();
-            const auto neighborDisp = (neighborCentre->has(Property::Displacement)) ? neighborCentre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-            const auto initialBondVector = neighborCentre->initialPosition().value<space::Point<3> >().positionVector() - centreInitialPosition.positionVector();
-            const auto deformation = neighborDisp - centreDisp;
-
-            const auto bondLength = initialBondVector.length();
-            dilatation += bondLength
-                    * (deformation + initialBondVector).length()
-                    * neighborCentre->at(Property::Volume).value<double>()
-                    * p_volumeCurrention(p_time, initialBondVector, deformation);
-        });
+    const auto& bonds = part.bonds();
+    const auto& properties = part.properties();
+    const auto displacements = properties.column(Property::Displacement);
+
+    p_blocks.forEach([&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++) {
+            const auto& centre = horizons[row]->centre();
+            const auto& centreDisp = keys::Displacement::getOr(*centre, space::consts::o3D);
+
+            auto dilatation = 0.;
+            for (auto bond = bonds.begin(row); bond < bonds.end(row); bond++) {
+                const auto& neighborDisp = keys::Displacement::getOr(displacements, bonds.neighbor(bond), space::consts::o3D);
+                const auto deformation = neighborDisp - centreDisp;
+                dilatation += p_geometry.length(bond)
+                        * (p_geometry.initial(bond) + deformation).length()
+                        * p_geometry.neighborVolume(bond)
+                        * p_geometry.volumeCorrection(bond);
+            }
 
-        centre->at(Property::Dilatation) = 3 * dilatation / centre->at(Property::WeightedVolume).value<double>();
+            keys::Dilatation::set(*centre, 3 * dilatation / keys::WeightedVolume::get(*centre));
+        }
     });
 }
 
-void OrdinaryStateBased::updateForces(const configuration::Part::NeighborhoodPtrs &horizons, const bool override) const {
-    std::for_each(horizons.begin(), horizons.end(), [this, override](const PDPart::NeighborhoodPtr& neighborhood) {
-        updateCentreForce(neighborhood, override);
+void OrdinaryStateBased::updateForces(const configuration::Part::NeighborhoodPtrs &horizons, const configuration::BondGraph &bonds,
+                                      const configuration::PropertyTable &neighborProperties, const bool override) const {
+    p_blocks.forEach([&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++)
+            updateCentreForce(horizons[row], bonds, p_geometry, row, neighborProperties, override);
     });
 }
 
-void OrdinaryStateBased::updatePartDamages(OrdinaryStateBased::PDPart &part) const {
+void OrdinaryStateBased::updateKernelForces(OrdinaryStateBased::PDPart &part, const bool override) {
     const auto& horizons = part.neighborhoods();
-    std::for_each(horizons.begin(), horizons.end(), [](const PDPart::NeighborhoodPtr& neighborhood) {
-        const auto& center = neighborhood->centre();
-        const auto& neighbors = neighborhood->neighbors();
-        int damage = 0;
-        std::for_each(neighbors.begin(), neighbors.end(), [&damage,  &neighborhood](const PDPart::NeighborhoodPtr& neighbor) {
-            damage += (neighborhood->hasStatus(neighbor, Property::Damage))? 1 : 0;
-        });
-
-        if (center->has(Property::Damage) || damage != 0) {
-            center->at(Property::Damage) = double(damage) / double(neighbors.size());
-        }
+    OrdinaryStateBasedKernel::Forces forces;
+    p_damages.prepare(p_blocks.threadsSize());
+    if (p_events)
+        p_events->prepare(Analyse::current().iterator(), p_blocks.threadsSize());
+    p_kernel->updateForces(horizons, part.bonds(), p_geometry, p_blocks, &p_damages, p_events.get(), forces);
+
+    parallel::forEach(horizons.size(), p_threadsSize, p_scheduling, p_chunkSize, [&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++)
+            setForce(*horizons[row]->centre(), forces[row], override);
     });
 }
 
+void OrdinaryStateBased::updateGeometry(const configuration::BondGraph &bonds,
+                                        const configuration::PropertyTable &centreProperties, const configuration::PropertyTable &neighborProperties) {
+    if (!p_geometry.matches(bonds))
+        p_geometry.assign(bonds, centreProperties, neighborProperties, p_volumeCurrention, p_time);
+}
+
+void OrdinaryStateBased::drainFractureEvents() {
+    if (!p_events)
+        return;
+
+    if (const auto lost = p_events->drain()) {
+        using Logger = report::Logger;
+        Logger::centre().log(Logger::Broadcast::Warning, std::to_string(lost) + " fracture event" + ((lost == 1) ? " was" : "s were")
+                             + " lost; increase the capacity of the FractureEvents.");
+    }
+}
+
+void OrdinaryStateBased::updatePartDamages(OrdinaryStateBased::PDPart &part) {
+    if (!part.bonds().matches(part.neighborhoods()))
+        part.updateBonds();
+
+    p_damages.update(part.neighborhoods(), part.bonds(), part.properties(), p_threadsSize, p_scheduling, p_chunkSize);
+}
+
 void OrdinaryStateBased::updateWeightedVolumes(OrdinaryStateBased::PDPart &part) const {
+    if (p_kernel) {
+        p_kernel->updateWeightedVolumes(part.neighborhoods(), part.bonds(), p_geometry, p_blocks, part.properties());
+        return;
+    }
+
     const auto& horizons = part.neighborhoods();
-    std::for_each(horizons.begin(), horizons.end(), [&](const PDPart::NeighborhoodPtr& horizon) {
-        const auto& centre = horizon->centre();
-        const auto centreInitialPosition = centre->initialPosition().value<space::Point<3> >();
-        const auto centreDisp = (centre->has(Property::Displacement)) ? centre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-
-        auto weightedVolume = 0.;
-        const auto& neighborHorizons = horizon->neighbors();
-        std::for_each(neighborHorizons.begin(), neighborHorizons.end(), [&](const PDPart::NeighborhoodPtr& neighborHorizon) {
-            const auto& neighborCentre = neighborHorizon->centre();
-            const auto neighborDisp = (neighborCentre->has(Property::Displacement)) ? neighborCentre->at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
-            const auto initialBondVector = neighborCentre->initialPosition().value<space::Point<3> >().positionVector() - centreInitialPosition.positionVector();
-            const auto deformation = neighborDisp - centreDisp;
-
-            const auto bondLengthSquared = initialBondVector.lengthSquared();
-            weightedVolume += bondLengthSquared
-                    * neighborCentre->at(Property::Volume).value<double>()
-                    * p_volumeCurrention(p_time, initialBondVector, deformation);
-        });
+    const auto& bonds = part.bonds();
+
+    p_blocks.forEach([&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++) {
+            auto weightedVolume = 0.;
+            for (auto bond = bonds.begin(row); bond < bonds.end(row); bond++) {
+                weightedVolume += p_geometry.length(bond) * p_geometry.length(bond)
+                        * p_geometry.neighborVolume(bond)
+                        * p_geometry.volumeCorrection(bond);
+            }
 
-        centre->at(Property::WeightedVolume) = weightedVolume;
+            keys::WeightedVolume::set(*horizons[row]->centre(), weightedVolume);
+        }
     });
 }
 
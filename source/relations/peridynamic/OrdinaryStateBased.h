@@ -9,7 +9,13 @@
 #ifndef ORDINARYSTATEBASED_H
 #define ORDINARYSTATEBASED_H
 
+#include "BondGeometry.h"
+#include "DamageCounters.h"
+#include "FractureEvents.h"
+#include "HorizonBlocks.h"
+#include "OrdinaryStateBasedKernel.h"
 #include "Property.h"
+#include "PropertyKeys.h"
 #include "../Relation.h"
 #include "../../Analyse.h"
 #include "../../configuration/Part.h"
@@ -55,6 +61,8 @@ public:
      * @param 2nd The bond initial vector.
      * @param 3rd The bond current vector.
      * @return The volume currention for the given bond.
+     * @note It is evaluated once per bond (with zero deformation) and cached until the bonds change; thus, it should only
+     *       depend on the bond initial vector.
      */
     using VolumeCorrection = std::function<double(const SimulationTime, const Vector&, const Vector&)>;
 
@@ -185,21 +193,77 @@ public:
 
     /**
      * @brief Sets the bonnd force relationship.
+     * @note Replaces the kernel of the Elastic() and BrittleFracture() relations, if any (see OrdinaryStateBasedKernel).
      */
     void setBondForceRelationship(const BondForceRelationship& relationship);
 
+    /**
+     * @brief Sets the log of the bonds broken by the bond force law (see FractureEvents).
+     * @details The events are recorded by the force loops and drained to the log file after each time step; a warning
+     *          is logged if a thread has broken more bonds in a time step than its buffer holds.
+     * @note Only the bonds broken by the built-in laws (e.g., BrittleFracture()) are logged, not the ones of a custom
+     *       bond force relationship.
+     * @param events The log; nullptr stops logging.
+     */
+    void setFractureEvents(const std::shared_ptr<FractureEvents>& events);
+
+    /**
+     * @brief Sets how the horizons are shared between the threads (see setThreadsSize()).
+     * @param scheduling The scheduling; the static one gives each thread the same number of bonds, while the chunked
+     *                   one balances the horizons of different costs (e.g., near the cracks) at the cost of more sync.
+     * @param chunkSize The number of the horizons of each chunk of the chunked scheduling.
+     */
+    void setScheduling(const parallel::Scheduling scheduling, const size_t chunkSize = 256);
+
+    /**
+     * @brief Sets the number of the threads computing the weighted volumes, the dilatations, the forces and the damages.
+     * @details Each phase is computed per horizon (see HorizonBlocks) and finishes on all the threads before the next
+     *          one starts; thus, the forces read the dilatations of the neighbors of the same time step.
+     * @warning With more than one thread, the bond force relationship is called from multiple threads at the same time
+     *          (for different horizons); thus, it must only modify its centre node and the Damage of its bond, and it
+     *          can only set the Damage to int(1) (see DamageCounters::prepareStatuses()); setting any other value throws.
+     * @param threadsSize The number of the threads; zero means as many as the hardware can run at the same time.
+     */
+    void setThreadsSize(const size_t threadsSize);
+
 private:
 
+    /**
+     * @brief Constructs a relation that applies the ordinary state-based peridynamic to any PDPart with a kernel.
+     * @details The kernel computes the dilatations in a pass over the bonds and the forces and the damages in a second
+     *          pass (see OrdinaryStateBasedKernel); the Elastic() and BrittleFracture() relations are built with one.
+     * @see OrdinaryStateBased(BondForceRelationship, VolumeCorrection, PDPart&, const bool).
+     */
+    explicit OrdinaryStateBased(std::shared_ptr<OrdinaryStateBasedKernel> kernel, VolumeCorrection volumeCurrection, PDPart& part, const bool override);
+
+    /**
+     * @brief Overrides or appends the force of a Node.
+     * @warning If the force is zero and the Node has no force, nothing will happen.
+     */
+    static void setForce(configuration::Node& centre, const Vector& force, const bool override);
+
     /**
      * @brief Computes ordinary state-based peridynamic force at the centre of the horizon (i.e., neighborhood) and updates it.
      * @warning If the computed ordinary state-based peridynamic force is zero and the centre of the horizon has no force, nothing will happen.
      * @param horizon The neighborhood inside the PDPart.
+     * @param bonds The bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param row The row of the horizon on the bonds.
+     * @param neighborProperties The properties of the neighbor Part nodes.
      * @param override Whether to override the force or add to it.
      */
-    void updateCentreForce(const HorizonPtr& horizon, const bool override) const;
+    void updateCentreForce(const HorizonPtr& horizon, const configuration::BondGraph& bonds, const BondGeometry& geometry, const size_t row,
+                           const configuration::PropertyTable& neighborProperties, const bool override) const;
+
+    /**
+     * @brief Splits the horizons into blocks for the threads if the bonds or the threading have changed, and prepares the
+     *        properties and the bond statuses the threads write to.
+     */
+    void updateBlocks(PDPart& part);
 
     /**
      * @brief Computes and updates the nodal dilatation of the part.
+     * @note The bond geometry must be up to date (see updateGeometry()).
      */
     void updateDilatation(PDPart& part) const;
 
@@ -207,17 +271,45 @@ private:
      * @brief Computes ordinary state-based peridynamic force at the given horizon centers (i.e., neighborhood) and updates it.
      * @warning If the computed ordinary state-based peridynamic force is zero and the centre of the horizon has no force, nothing will happen.
      * @param horizons The neighborhoods inside the PDPart.
+     * @param bonds The bonds of the horizons.
+     * @param neighborProperties The properties of the neighbor Part nodes.
+     * @param override Whether to override the force or add to it.
+     */
+    void updateForces(const PDPart::NeighborhoodPtrs& horizons, const configuration::BondGraph& bonds,
+                      const configuration::PropertyTable& neighborProperties, const bool override) const;
+
+    /**
+     * @brief Computes the forces of the Part Nodes with the kernel, in a single pass over the bonds, recording the newly
+     *        broken bonds for the damages (see updatePartDamages()).
+     * @note The dilatations must be up to date (see updateDilatation()).
+     * @param part The PD part.
      * @param override Whether to override the force or add to it.
      */
-    void updateForces(const PDPart::NeighborhoodPtrs& horizons, const bool override) const;
+    void updateKernelForces(PDPart& part, const bool override);
+
+    /**
+     * @brief Computes the reference geometry of the bonds if their topology has changed.
+     * @param bonds The bonds.
+     * @param centreProperties The properties of the centre Part nodes.
+     * @param neighborProperties The properties of the neighbor Part nodes.
+     */
+    void updateGeometry(const configuration::BondGraph& bonds,
+                        const configuration::PropertyTable& centreProperties, const configuration::PropertyTable& neighborProperties);
+
+    /**
+     * @brief Writes the recorded broken bonds to the log file, if any (see setFractureEvents()).
+     */
+    void drainFractureEvents();
 
     /**
      * @brief Updates the damage of the Part Nodes by avaraging the horizon broken bonds.
+     * @note Only the Nodes having a newly broken bond are updated when the kernel has recorded all of them (see DamageCounters).
      */
-    void updatePartDamages(PDPart& part) const;
+    void updatePartDamages(PDPart& part);
 
     /**
      * @brief Computes and updates the nodal weighted volumes of the part.
+     * @note The bond geometry must be up to date (see updateGeometry()).
      */
     void updateWeightedVolumes(PDPart& part) const;
 
@@ -226,11 +318,19 @@ private:
      */
     void updateMaximumStretch(PDPart& part);
 
+    HorizonBlocks p_blocks;                         // The blocks of the horizons processed by the threads.
     BondForceRelationship p_bondForceRelationship;  // Denotes how to compute the force for each bond.
+    size_t p_chunkSize;                             // The number of the horizons of each chunk of the chunked scheduling.
+    DamageCounters p_damages;                       // The numbers of the broken bonds of the horizons.
     SimulationTime p_dt;                            // The time step.
+    std::shared_ptr<FractureEvents> p_events;       // The log of the broken bonds (null if not logged).
+    BondGeometry p_geometry;                        // The reference geometry of the bonds.
     bool p_includeMaximumStretch;                   // Whether to incude the maximum stretch to the nodes or not.
+    std::shared_ptr<OrdinaryStateBasedKernel> p_kernel; // The kernel of the linear material (null if the relationship is used).
     SimulationTime p_lastTime;                      // The last time.
     bool p_maximumStretchIncluded;                  // Whether the maximum stretch is already included or not.
+    parallel::Scheduling p_scheduling;              // How the horizons are shared between the threads.
+    size_t p_threadsSize;                           // The number of the threads.
     const SimulationTime& p_time;                   // The reference to global Analyses::Time.
     VolumeCorrection p_volumeCurrention;            // Denotes how to compute the volume currention for each bond.
 };
@@ -0,0 +1,175 @@
+//
+//  OrdinaryStateBasedKernel.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "OrdinaryStateBasedKernel.h"
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+namespace rbs::relations::peridynamic {
+
+OrdinaryStateBasedKernel::OrdinaryStateBasedKernel(const double bulkModulus, const double shearModulus)
+    : OrdinaryStateBasedKernel(bulkModulus, shearModulus, 0, 0, nullptr)
+{
+    p_isFracturable = false;
+}
+
+OrdinaryStateBasedKernel::OrdinaryStateBasedKernel(const double bulkModulus, const double shearModulus,
+                                                   const double maxPositiveStretch, const double maxNegativeStretch,
+                                                   const OrdinaryStateBasedKernel::IsInFracturableArea &isInFracturableArea)
+    : p_bulkModulus{bulkModulus}
+    , p_dilatationRatios{}
+    , p_displacements{}
+    , p_fracturable{}
+    , p_inverseWeightedVolumes{}
+    , p_isFracturable{true}
+    , p_isInFracturableArea{isInFracturableArea}
+    , p_maxNegativeStretch{maxNegativeStretch}
+    , p_maxPositiveStretch{maxPositiveStretch}
+    , p_revision{0}
+    , p_shearModulus{shearModulus}
+    , p_weightedVolumes{}
+    , p_weights{}
+{
+}
+
+void OrdinaryStateBasedKernel::updateDilatations(const OrdinaryStateBasedKernel::Horizons &horizons, const configuration::BondGraph &bonds, const BondGeometry &geometry,
+                                                 const HorizonBlocks &blocks, configuration::PropertyTable &properties) {
+    if (p_revision != bonds.revision() || p_weightedVolumes.size() != properties.size())
+        updateWeightedVolumes(horizons, bonds, geometry, blocks, properties);
+
+    const auto displacements = std::as_const(properties).column(Property::Displacement);
+    p_displacements.resize(properties.size());
+    parallel::forEachRange(properties.size(), blocks.threadsSize(), [&](const size_t, const size_t begin, const size_t end) {
+        for (auto id = begin; id < end; id++)
+            p_displacements[id] = keys::Displacement::getOr(displacements, id, space::consts::o3D);
+    });
+
+    auto& dilatations = keys::Dilatation::column(properties);
+    const auto displacementOf = [this](const size_t id) -> const space::vec3& {
+        return p_displacements[id];
+    };
+    blocks.forEach([&](const size_t, const size_t begin, const size_t end) {
+        BondLanes lanes;
+        for (auto row = begin; row < end; row++) {
+            const auto centre = bonds.centre(row);
+            lanes.gather(bonds, geometry, row, p_displacements[centre], displacementOf);
+
+            auto dilatation = 0.;
+            const auto bondsBegin = bonds.begin(row);
+            for (auto bond = bondsBegin; bond < bonds.end(row); bond++)
+                dilatation += geometry.length(bond) * lanes.currentLength(bond - bondsBegin) * p_weights[bond];
+
+            dilatation = 3 * dilatation / p_weightedVolumes[centre];
+            p_dilatationRatios[centre] = dilatation / p_weightedVolumes[centre];
+            keys::Dilatation::set(dilatations, centre, dilatation);
+        }
+    });
+}
+
+void OrdinaryStateBasedKernel::updateForces(const OrdinaryStateBasedKernel::Horizons &horizons, const configuration::BondGraph &bonds, const BondGeometry &geometry,
+                                            const HorizonBlocks &blocks, DamageCounters *damages, FractureEvents *events,
+                                            OrdinaryStateBasedKernel::Forces &forces) const {
+    auto* statuses = (horizons.empty()) ? nullptr : horizons.front()->bondStatuses().get();
+    if (p_isFracturable && !statuses && !horizons.empty())
+        throw std::runtime_error("The fracturable ordinary state-based peridynamic kernel requires the horizons attached to their bonds.");
+
+    const auto dilatationModulus = 3 * p_bulkModulus - 5 * p_shearModulus;
+    const auto extensionModulus = 15 * p_shearModulus;
+    const auto displacementOf = [this](const size_t id) -> const space::vec3& {
+        return p_displacements[id];
+    };
+    forces.assign(horizons.size(), space::consts::o3D);
+    blocks.forEach([&](const size_t thread, const size_t begin, const size_t end) {
+        auto broken = (statuses) ? statuses->flags(Property::Damage) : nullptr;
+        BondLanes lanes;
+        for (auto row = begin; row < end; row++) {
+            auto& centreNode = *horizons[row]->centre();
+            const auto centre = bonds.centre(row);
+            const auto centreRatio = p_dilatationRatios[centre];
+            const auto centreInverse = p_inverseWeightedVolumes[centre];
+            const auto maxStretch = keys::MaximumStretch::find(centreNode);
+            auto rowMaxStretch = (maxStretch) ? *maxStretch : 0.;
+
+            lanes.gather(bonds, geometry, row, p_displacements[centre], displacementOf);
+            const auto bondsBegin = bonds.begin(row);
+            for (auto bond = bondsBegin; bond < bonds.end(row); bond++) {
+                if (geometry.initial(bond).isZero())
+                    continue;
+
+                const auto isFracturable = p_isFracturable && p_fracturable[bond];
+                if (isFracturable && broken && broken->test(bond))
+                    continue;
+
+                const auto index = bond - bondsBegin;
+                const auto neighbor = bonds.neighbor(bond);
+                const auto length = geometry.length(bond);
+                const auto extension = lanes.currentLength(index) - length;
+                const auto stretch = lanes.stretch(index);
+                if (std::abs(stretch) > std::abs(rowMaxStretch))
+                    rowMaxStretch = stretch;
+
+                if (isFracturable && !(p_maxNegativeStretch <= stretch && stretch <= p_maxPositiveStretch)) {
+                    statuses->set(bond, Property::Damage, int(1));
+                    broken = statuses->flags(Property::Damage);
+                    if (damages)
+                        damages->record(thread, row);
+                    if (events)
+                        events->record(thread, bonds.centre(row), neighbor, stretch);
+                    continue;
+                }
+
+                lanes.setForce(index, 0.5 * p_weights[bond]
+                               * (dilatationModulus * (centreRatio + p_dilatationRatios[neighbor]) * length
+                                  + extensionModulus * (centreInverse + p_inverseWeightedVolumes[neighbor]) * extension));
+            }
+            forces[row] = lanes.force();
+
+            if (maxStretch && rowMaxStretch != *maxStretch)
+                keys::MaximumStretch::set(centreNode, rowMaxStretch);
+        }
+    });
+}
+
+void OrdinaryStateBasedKernel::updateWeightedVolumes(const OrdinaryStateBasedKernel::Horizons &horizons, const configuration::BondGraph &bonds, const BondGeometry &geometry,
+                                                     const HorizonBlocks &blocks, configuration::PropertyTable &properties) {
+    const auto idsSize = properties.size();
+    p_dilatationRatios.assign(idsSize, 0.);
+    p_inverseWeightedVolumes.assign(idsSize, 0.);
+    p_weightedVolumes.assign(idsSize, 0.);
+    p_weights.resize(bonds.bondsSize());
+
+    auto& weightedVolumes = keys::WeightedVolume::column(properties);
+    blocks.forEach([&](const size_t, const size_t begin, const size_t end) {
+        for (auto row = begin; row < end; row++) {
+            auto weightedVolume = 0.;
+            for (auto bond = bonds.begin(row); bond < bonds.end(row); bond++) {
+                p_weights[bond] = geometry.neighborVolume(bond) * geometry.volumeCorrection(bond);
+                weightedVolume += geometry.length(bond) * geometry.length(bond) * p_weights[bond];
+            }
+
+            const auto centre = bonds.centre(row);
+            p_weightedVolumes[centre] = weightedVolume;
+            p_inverseWeightedVolumes[centre] = 1 / weightedVolume;
+            keys::WeightedVolume::set(weightedVolumes, centre, weightedVolume);
+        }
+    });
+
+    if (p_isFracturable) {
+        p_fracturable.assign(bonds.bondsSize(), false);
+        for (size_t row = 0; row < horizons.size(); row++) {
+            const auto& neighbors = horizons[row]->neighbors();
+            const auto begin = bonds.begin(row);
+            for (auto bond = begin; bond < bonds.end(row); bond++)
+                p_fracturable[bond] = !p_isInFracturableArea || p_isInFracturableArea(horizons[row], neighbors[bond - begin]);
+        }
+    }
+    p_revision = bonds.revision();
+}
+
+} // namespace rbs::relations::peridynamic
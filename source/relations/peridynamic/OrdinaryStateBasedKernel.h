@@ -0,0 +1,125 @@
+//
+//  OrdinaryStateBasedKernel.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 24.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef ORDINARYSTATEBASEDKERNEL_H
+#define ORDINARYSTATEBASEDKERNEL_H
+
+#include "BondGeometry.h"
+#include "BondLanes.h"
+#include "DamageCounters.h"
+#include "FractureEvents.h"
+#include "HorizonBlocks.h"
+#include "Property.h"
+#include "PropertyKeys.h"
+#include "../../configuration/Part.h"
+#include <functional>
+#include <vector>
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief The OrdinaryStateBasedKernel computes the linear (elastic or brittle) ordinary state-based peridynamic forces
+ *        in two passes over the bonds: the dilatations, then the forces.
+ * @details The kernel keeps node-contiguous caches, indexed by the node ids, of the displacements, the weighted volumes
+ *          (m), θ/m and 1/m, where θ is the dilatation; thus, the force of a bond reads the state of both of its ends from
+ *          plain arrays instead of the properties of the nodes. The per-bond weights (i.e., the neighbor volume times the
+ *          volume correction) are kept with the weighted volumes until the topology of the bonds changes.
+ *          Both passes compute the current vectors and lengths of the bonds of a horizon in the lanes of
+ *          space::VectorBatch (see BondLanes).
+ *          The weighted volumes and the dilatations are also set on the nodes (i.e., WeightedVolume and Dilatation).
+ * @note The bonds must be inner bonds (i.e., their neighbors are the centres of the same Part).
+ */
+class OrdinaryStateBasedKernel
+{
+public:
+    using Forces = std::vector<space::vec3>;
+    using Horizons = configuration::Part::NeighborhoodPtrs;
+    using HorizonPtr = configuration::Part::NeighborhoodPtr;
+    using IsInFracturableArea = std::function<bool(const HorizonPtr&, const HorizonPtr&)>;
+
+    /**
+     * @brief Constructs an elastic kernel (i.e., the bonds never break).
+     * @param bulkModulus The material bulk modulus.
+     * @param shearModulus The material shear modulus.
+     */
+    explicit OrdinaryStateBasedKernel(const double bulkModulus, const double shearModulus);
+
+    /**
+     * @brief Constructs a brittle kernel (i.e., the bonds inside the fracturable area break beyond the maximum stretches).
+     * @param bulkModulus The material bulk modulus.
+     * @param shearModulus The material shear modulus.
+     * @param maxPositiveStretch The maximum positive (tension) stretch a bond can carry.
+     * @param maxNegativeStretch The maximum negative (pressure) stretch a bond can carry.
+     * @param isInFracturableArea Whether a bond is inside the fracturable area; evaluated once per bond topology.
+     */
+    explicit OrdinaryStateBasedKernel(const double bulkModulus, const double shearModulus,
+                                      const double maxPositiveStretch, const double maxNegativeStretch,
+                                      const IsInFracturableArea& isInFracturableArea);
+
+    /**
+     * @brief Computes the dilatation of each horizon centre (the first pass).
+     * @note Computes the weighted volumes first if the topology of the bonds has changed (see updateWeightedVolumes()).
+     * @param horizons The horizons (i.e., neighborhoods) of the Part.
+     * @param bonds The inner bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param blocks The blocks of the horizons processed by the threads.
+     * @param properties The properties of the Part nodes.
+     */
+    void updateDilatations(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                           const HorizonBlocks& blocks, configuration::PropertyTable& properties);
+
+    /**
+     * @brief Computes the force of each horizon centre and breaks the bonds beyond the maximum stretches (the second pass).
+     * @note The dilatations must be up to date (see updateDilatations()).
+     * @param horizons The horizons (i.e., neighborhoods) of the Part.
+     * @param bonds The inner bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param blocks The blocks of the horizons processed by the threads.
+     * @param damages The counters recording the rows of the broken bonds, or nullptr.
+     * @param events The log of the broken bonds, or nullptr.
+     * @param[out] forces The force of each horizon centre, in the order of the horizons.
+     * @throws If the kernel is brittle and the horizons are not attached to the statuses of their bonds.
+     */
+    void updateForces(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                      const HorizonBlocks& blocks, DamageCounters* damages, FractureEvents* events, Forces& forces) const;
+
+    /**
+     * @brief Computes the per-bond weights and the weighted volume of each horizon centre.
+     * @param horizons The horizons (i.e., neighborhoods) of the Part.
+     * @param bonds The inner bonds of the horizons.
+     * @param geometry The reference geometry of the bonds.
+     * @param blocks The blocks of the horizons processed by the threads.
+     * @param properties The properties of the Part nodes.
+     */
+    void updateWeightedVolumes(const Horizons& horizons, const configuration::BondGraph& bonds, const BondGeometry& geometry,
+                               const HorizonBlocks& blocks, configuration::PropertyTable& properties);
+
+private:
+    using Scalars = std::vector<double>;
+
+    double p_bulkModulus;                           // The material bulk modulus.
+    Scalars p_dilatationRatios;                     // θ/m of each node, by node id.
+    std::vector<space::vec3> p_displacements;       // The displacement of each node, by node id.
+    std::vector<bool> p_fracturable;                // Whether each bond is inside the fracturable area.
+    Scalars p_inverseWeightedVolumes;               // 1/m of each node, by node id.
+    bool p_isFracturable;                           // Whether any of the bonds can break.
+    IsInFracturableArea p_isInFracturableArea;      // Whether a bond is inside the fracturable area.
+    double p_maxNegativeStretch;                    // The maximum negative (pressure) stretch a bond can carry.
+    double p_maxPositiveStretch;                    // The maximum positive (tension) stretch a bond can carry.
+    configuration::BondGraph::Revision p_revision;  // The revision of the bonds the weights are computed for.
+    double p_shearModulus;                          // The material shear modulus.
+    Scalars p_weightedVolumes;                      // m of each node, by node id.
+    Scalars p_weights;                              // The neighbor volume times the volume correction of each bond.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // ORDINARYSTATEBASEDKERNEL_H
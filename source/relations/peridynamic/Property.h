@@ -19,6 +19,7 @@ namespace rbs::relations::peridynamic {
  * @warning If adding a new property to this list, following should be updated.
  *          1: rbs::relations::peridynamic::Exporter::to_string()
  *          2: rbs::relations::peridynamic::Exporter::to_attType()
+ *          3: rbs::relations::peridynamic::keys
  * @note The Neighborhood properties will be stored at the centre Node of the Neighborhood.
  * @note This enum is merely useful to avoid mistakes in writing the properties to the node, and using it is not mandatory.
  */
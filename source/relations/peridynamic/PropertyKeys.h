@@ -0,0 +1,66 @@
+//
+//  PropertyKeys.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef PROPERTYKEYS_H
+#define PROPERTYKEYS_H
+
+#include "Property.h"
+#include "../../configuration/PropertyKey.h"
+#include <utility>
+
+/**
+ * Provides the typed keys of the peridynamic properties.
+ * @note The keys are the single place where the type of each property is defined; use them in the performance critical loops.
+ */
+namespace rbs::relations::peridynamic::keys {
+
+template<typename T, Property PropertyIndex>
+using Key = configuration::PropertyKey<T, PropertyIndex>;
+
+using CurrentPosition   = Key<space::vec3, Property::CurrentPosition>;
+using Displacement      = Key<space::vec3, Property::Displacement>;
+using Velocity          = Key<space::vec3, Property::Velocity>;
+using Acceleration      = Key<space::vec3, Property::Acceleration>;
+using Force             = Key<space::vec3, Property::Force>;
+using BodyForce         = Key<space::vec3, Property::BodyForce>;
+using Density           = Key<double, Property::Density>;
+using Volume            = Key<double, Property::Volume>;
+using Damage            = Key<double, Property::Damage>;
+using MaximumStretch    = Key<double, Property::MaximumStretch>;
+using WeightedVolume    = Key<double, Property::WeightedVolume>;
+using Dilatation        = Key<double, Property::Dilatation>;
+
+/**
+ * @brief Types the columns of the peridynamic properties stored in a property table (see configuration::PropertyKey::column()).
+ * @note The columns that do not exist are not created.
+ * @warning Typing a column allocates it; thus, it cannot happen on multiple threads.
+ * @throws If a column stores a property with a different type than its key.
+ */
+inline void typeColumns(configuration::PropertyTable& properties) {
+    const auto type = [&properties](const auto key) {
+        using Key = decltype(key);
+        if (std::as_const(properties).column(Key::index))
+            Key::column(properties);
+    };
+    type(CurrentPosition{});
+    type(Displacement{});
+    type(Velocity{});
+    type(Acceleration{});
+    type(Force{});
+    type(BodyForce{});
+    type(Density{});
+    type(Volume{});
+    type(Damage{});
+    type(MaximumStretch{});
+    type(WeightedVolume{});
+    type(Dilatation{});
+}
+
+} // namespace rbs::relations::peridynamic::keys
+
+#endif // PROPERTYKEYS_H
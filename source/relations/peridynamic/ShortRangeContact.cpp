@@ -0,0 +1,180 @@
+//
+//  ShortRangeContact.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "ShortRangeContact.h"
+
+namespace rbs::relations::peridynamic {
+
+ShortRangeContact::ShortRangeContact(const double springConstant, const double contactDistance, const double horizonRadius, ShortRangeContact::PDPart &part)
+    : ShortRangeContact(springConstant, contactDistance, horizonRadius, part, part)
+{
+}
+
+ShortRangeContact::ShortRangeContact(const double springConstant, const double contactDistance, const double horizonRadius, ShortRangeContact::PDPart &centrePart, const ShortRangeContact::PDPart &neighborPart)
+    : Base(0, centrePart, [](const SimulationTime&, PDPart&) {} )
+    , p_cells{ (contactDistance > 0) ? contactDistance : 1 }
+    , p_centreInitialPositions{}
+    , p_contactDistance{ contactDistance }
+    , p_contactsSize{ 0 }
+    , p_horizonRadius{ horizonRadius }
+    , p_initialPositions{}
+    , p_rebuildInterval{ 1 }
+    , p_skin{ 0 }
+    , p_sinceRebuild{ 0 }
+    , p_springConstant{ springConstant }
+    , p_time{ Analyse::time() }
+{
+    if (springConstant <= 0)
+        throw std::out_of_range("The spring constant of the short-range contact must be bigger than zero.");
+    if (contactDistance <= 0)
+        throw std::out_of_range("The contact distance of the short-range contact must be bigger than zero.");
+    if (horizonRadius <= 0)
+        throw std::out_of_range("The horizon radius of the short-range contact must be bigger than zero.");
+
+    setFeeder( p_time );
+    setRelationship([&](const SimulationTime&, PDPart& centrePart) {
+        using Logger = report::Logger;
+
+        const auto start_t = clock();
+
+        auto& logger = Logger::centre();
+        if (&centrePart == &neighborPart)
+            logger.log(Logger::Broadcast::Process, "Applying short-range contact to \"" + centrePart.name() + "\" Part.");
+        else
+            logger.log(Logger::Broadcast::Process, "Applying short-range contact to \"" + centrePart.name() + "\" Part nodes close to \"" + neighborPart.name() + "\" Part.");
+
+        p_contactsSize = updateForces(centrePart, neighborPart);
+
+        const size_t problemSize = centrePart.neighborhoods().size();
+        const long dist = clock() - start_t;
+        const auto duration = double(dist) / CLOCKS_PER_SEC;
+        const auto durationText = report::date_time::duration::formated(duration, 3);
+        if (problemSize) {
+            logger.log(Logger::Broadcast::ProcessStart, std::to_string(problemSize) + " Node" + ((problemSize == 1)? " ": "s ") + " updated.");
+            logger.log(Logger::Broadcast::ProcessStart, std::to_string(p_contactsSize) + " contact" + ((p_contactsSize == 1)? " ": "s ") + " found.");
+            logger.log(Logger::Broadcast::ProcessTiming, "Done in " + ((durationText.empty())? " less than a nanosecond" : durationText)  + ".");
+            logger.log(Logger::Broadcast::ProcessTiming, (dist) ? std::to_string( dist / problemSize ) + " CPU clock per Node." : "Less than a CPU clock per Node.");
+            logger.log(Logger::Broadcast::ProcessTiming, report::date_time::duration::formated(duration / problemSize, 3) + " per Node.");
+            logger.log(Logger::Broadcast::ProcessEnd, "");
+            logger.log(Logger::Broadcast::ProcessEnd, "");
+        } else {
+            logger.log(Logger::Broadcast::Warning, "No Node found.");
+            logger.log(Logger::Broadcast::ProcessStart, "");
+            logger.log(Logger::Broadcast::ProcessTiming, "Done in " + durationText + ".");
+            logger.log(Logger::Broadcast::ProcessEnd, "");
+        }
+    });
+}
+
+ShortRangeContact ShortRangeContact::Common(const double materialConstant, const double gridSpacing, const double horizonRadius, ShortRangeContact::PDPart &part) {
+    return Common(materialConstant, gridSpacing, horizonRadius, part, part);
+}
+
+ShortRangeContact ShortRangeContact::Common(const double materialConstant, const double gridSpacing, const double horizonRadius, ShortRangeContact::PDPart &centrePart, const ShortRangeContact::PDPart &neighborPart) {
+    if (materialConstant <= 0)
+        throw std::out_of_range("The material constant of the short-range contact must be bigger than zero.");
+    if (gridSpacing <= 0)
+        throw std::out_of_range("The grid spacing of the short-range contact must be bigger than zero.");
+    return ShortRangeContact(15 * materialConstant, 1.35 * gridSpacing, horizonRadius, centrePart, neighborPart);
+}
+
+const space::CellList &ShortRangeContact::cells() const {
+    return p_cells;
+}
+
+size_t ShortRangeContact::contactsSize() const {
+    return p_contactsSize;
+}
+
+void ShortRangeContact::setRebuildInterval(const size_t interval) {
+    if (!interval)
+        throw std::out_of_range("The cell list rebuild interval must be bigger than zero.");
+    p_rebuildInterval = interval;
+}
+
+void ShortRangeContact::setSkin(const double skin) {
+    if (skin < 0)
+        throw std::out_of_range("The skin of the short-range contact cannot be negative.");
+    p_skin = skin;
+    p_cells = space::CellList(p_contactDistance + p_skin);
+    p_sinceRebuild = 0;
+}
+
+ShortRangeContact::Positions ShortRangeContact::positionsOf(const PDPart &centrePart, const PDPart &part, const bool current) {
+    const auto& properties = part.properties();
+    const auto displacements = properties.column(Property::Displacement);
+    const auto sameFrame = &centrePart.local() == &part.local();
+
+    Positions positions;
+    positions.reserve(properties.size());
+    for (configuration::PropertyTable::Id id = 0; id < properties.size(); id++) {
+        auto position = properties.initialPosition(id).value<space::Point<3> >().positionVector();
+        if (current)
+            position += keys::Displacement::getOr(displacements, id, space::consts::o3D);
+        if (!sameFrame)
+            position = centrePart.local().convert(space::Point<3>(position), part.local()).positionVector();
+        positions.emplace_back(position);
+    }
+    return positions;
+}
+
+size_t ShortRangeContact::updateForces(PDPart &centrePart, const PDPart &neighborPart) {
+    const auto isSelf = &centrePart == &neighborPart;
+    const auto positions = positionsOf(centrePart, neighborPart, true);
+    if (p_initialPositions.size() != positions.size()) { // The first application or the Part is re-meshed.
+        p_initialPositions = positionsOf(centrePart, neighborPart, false);
+        p_centreInitialPositions = (isSelf) ? Positions{} : positionsOf(centrePart, centrePart, false);
+        p_sinceRebuild = 0;
+    }
+    if (p_sinceRebuild == 0 || p_cells.size() != positions.size())
+        p_cells.assign(positions);
+    p_sinceRebuild = (p_sinceRebuild + 1) % p_rebuildInterval;
+
+    const auto centrePositions = (isSelf) ? Positions{} : positionsOf(centrePart, centrePart, true);
+    const auto& currentCentres = (isSelf) ? positions : centrePositions;
+    const auto& initialCentres = (isSelf) ? p_initialPositions : p_centreInitialPositions;
+    const auto volumes = neighborPart.properties().column(Property::Volume);
+    const auto searchRadius = p_contactDistance + p_skin;
+    const auto factor = p_springConstant / p_horizonRadius;
+
+    size_t contactsSize = 0;
+    const auto& neighborhoods = centrePart.neighborhoods();
+    std::for_each(neighborhoods.begin(), neighborhoods.end(), [&](const PDPart::NeighborhoodPtr& neighborhood) {
+        auto& centre = *neighborhood->centre();
+        const auto id = centre.id();
+        const auto& position = currentCentres[id];
+        const auto& initialPosition = initialCentres[id];
+
+        auto force = space::consts::o3D;
+        p_cells.forEachCandidate(position, searchRadius, [&](const space::CellList::Id neighborId) {
+            if (isSelf && neighborId == id)
+                return;
+            const auto bond = positions[neighborId] - position;
+            const auto length = bond.length();
+            const auto distance = std::min(0.9 * (p_initialPositions[neighborId] - initialPosition).length(), p_contactDistance);
+            if (length >= distance || length == 0)
+                return;
+
+            const auto volume = keys::Volume::find(volumes, neighborId);
+            if (!volume)
+                throw std::runtime_error("The short-range contact forces cannot be computed without volume at all of the Nodes.");
+            force += (factor * (length - distance) * *volume / length) * bond;
+            contactsSize++;
+        });
+
+        if (!force.isZero()) {
+            if (centre.has(Property::Force))
+                keys::Force::set(centre, keys::Force::get(centre) + force);
+            else
+                keys::Force::set(centre, force);
+        }
+    });
+    return contactsSize;
+}
+
+} // namespace rbs::relations::peridynamic
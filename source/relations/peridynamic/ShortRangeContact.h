@@ -0,0 +1,153 @@
+//
+//  ShortRangeContact.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 23.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef SHORTRANGECONTACT_H
+#define SHORTRANGECONTACT_H
+
+#include "Property.h"
+#include "PropertyKeys.h"
+#include "../Relation.h"
+#include "../../Analyse.h"
+#include "../../configuration/Part.h"
+#include "../../report/Logger.h"
+#include "../../space/CellList.h"
+
+/**
+ * Provides the specified version of the RBS objects for the Peridynamic simulation.
+ */
+namespace rbs::relations::peridynamic {
+
+/**
+ * @brief Provides the short-range contact forces between the nodes that come close in the current (deformed) configuration.
+ * @details The peridynamic bonds only connect the nodes that are close in the initial configuration; thus, the fragments
+ *          that separate and later collide (or two Parts that hit each other) do not interact through them. This relation
+ *          pushes apart every pair of nodes whose current distance is less than their contact distance,
+ *          d = min(0.9 * |initial distance|, contactDistance), with the force density
+ *          springConstant / horizonRadius * (d - |current distance|) * neighborVolume, in the direction away from the neighbor.
+ *          The nodes close to each other are found by a space::CellList built from the current positions (i.e., the initial
+ *          position plus the Displacement), rebuilt every few applications (see setRebuildInterval()).
+ * @note The forces are added to the existing forces of the Nodes; thus, append it after the relations that override the forces.
+ * @note The connection version only applies the forces to the centre Part; use a second relation for the neighbor Part.
+ */
+class ShortRangeContact : public Relation<double, configuration::Part>
+{
+public:
+    using SimulationTime = double;
+    using PDPart = configuration::Part;
+    using Base = Relation<double, PDPart>;
+
+    using Vector = space::vec3;
+
+    /**
+     * @brief Constructs a relation that applies the short-range contact forces between the nodes of a PDPart.
+     * @note The PDPart denotes a Part that its nodes' property indexes (e.g., Velocity) are compatible with the defined index on rbs::relations::peridynamic::Property.
+     * @param springConstant The short-range force constant (usually 15 times the bond-based material constant).
+     * @param contactDistance The largest distance where two nodes are in contact.
+     * @param horizonRadius The horizon radius.
+     * @param part The PD part.
+     * @throws If one of the springConstant, contactDistance, or horizonRadius is given zero or negative value.
+     */
+    explicit ShortRangeContact(const double springConstant, const double contactDistance, const double horizonRadius, PDPart& part);
+
+    /**
+     * @brief Constructs a relation that applies the short-range contact forces to the nodes of a PDPart in contact with the nodes of another PDPart.
+     * @note The PDPart denotes a Part that its nodes' property indexes (e.g., Velocity) are compatible with the defined index on rbs::relations::peridynamic::Property.
+     * @param springConstant The short-range force constant (usually 15 times the bond-based material constant).
+     * @param contactDistance The largest distance where two nodes are in contact.
+     * @param horizonRadius The horizon radius of the centre Part.
+     * @param centrePart The PDPart receiving the contact forces.
+     * @param neighborPart The PDPart pushing the centre Part nodes.
+     * @throws If one of the springConstant, contactDistance, or horizonRadius is given zero or negative value.
+     */
+    explicit ShortRangeContact(const double springConstant, const double contactDistance, const double horizonRadius, PDPart& centrePart, const PDPart& neighborPart);
+
+    /**
+     * @brief The defualt copy constructor.
+     */
+    ShortRangeContact(const ShortRangeContact&) = default;
+
+    /**
+     * @brief Generates a relation that applies the common short-range contact forces between the nodes of a PDPart.
+     * @note The spring constant is 15 times the material constant and the contact distance is 1.35 times the grid spacing.
+     * @param materialConstant The bond-based peridynamic mateial constant.
+     * @param gridSpacing The distance between Nodes.
+     * @param horizonRadius The horizon radius.
+     * @param part The PD part.
+     * @throws If one of the materialConstant, gridSpacing, or horizonRadius is given zero or negative value.
+     */
+    static ShortRangeContact Common(const double materialConstant, const double gridSpacing, const double horizonRadius, PDPart& part);
+
+    /**
+     * @brief Generates a relation that applies the common short-range contact forces to the nodes of a PDPart in contact with the nodes of another PDPart.
+     * @note The spring constant is 15 times the material constant and the contact distance is 1.35 times the grid spacing.
+     * @param materialConstant The bond-based peridynamic mateial constant.
+     * @param gridSpacing The largest distance between Nodes of the two Parts.
+     * @param horizonRadius The horizon radius of the centre Part.
+     * @param centrePart The PDPart receiving the contact forces.
+     * @param neighborPart The PDPart pushing the centre Part nodes.
+     * @throws If one of the materialConstant, gridSpacing, or horizonRadius is given zero or negative value.
+     */
+    static ShortRangeContact Common(const double materialConstant, const double gridSpacing, const double horizonRadius, PDPart& centrePart, const PDPart& neighborPart);
+
+    /**
+     * @brief Gives the cell list of the neighbor Part nodes (i.e., of the Part nodes if there is only one Part).
+     * @note The cell list is in the centre Part local coordinate system and built at the first application.
+     */
+    const space::CellList& cells() const;
+
+    /**
+     * @brief Gives the number of the node pairs in contact at the last application.
+     */
+    size_t contactsSize() const;
+
+    /**
+     * @brief Sets the number of applications between the cell list rebuilds.
+     * @warning If larger than one, the skin should be larger than twice the largest distance the nodes move during the interval.
+     * @throws If the interval is zero.
+     */
+    void setRebuildInterval(const size_t interval);
+
+    /**
+     * @brief Sets the distance added to the contact distance while searching the stale cell list (see setRebuildInterval()).
+     * @throws If the skin is negative.
+     */
+    void setSkin(const double skin);
+
+private:
+    using Positions = space::CellList::Positions;
+
+    /**
+     * @brief Gives the positions of the Part nodes in the centre Part local coordinate system.
+     * @param centrePart The PDPart receiving the contact forces.
+     * @param part The PDPart of the nodes.
+     * @param current Whether to give the current (true) or the initial (false) positions.
+     */
+    static Positions positionsOf(const PDPart& centrePart, const PDPart& part, const bool current);
+
+    /**
+     * @brief Computes the contact forces and adds them to the centre Part nodes.
+     * @return The number of the node pairs in contact.
+     */
+    size_t updateForces(PDPart& centrePart, const PDPart& neighborPart);
+
+    space::CellList p_cells;                    // The cell list of the neighbor Part nodes.
+    Positions p_centreInitialPositions;         // The initial positions of the centre Part nodes.
+    double p_contactDistance;                   // The largest distance where two nodes are in contact.
+    size_t p_contactsSize;                      // The number of the node pairs in contact at the last application.
+    double p_horizonRadius;                     // The horizon radius.
+    Positions p_initialPositions;               // The initial positions of the neighbor Part nodes.
+    size_t p_rebuildInterval;                   // The number of applications between the cell list rebuilds.
+    double p_skin;                              // The distance added to the contact distance while searching the cell list.
+    size_t p_sinceRebuild;                      // The number of applications since the last cell list rebuild.
+    double p_springConstant;                    // The short-range force constant.
+    const SimulationTime& p_time;               // The reference to global Analyses::Time.
+};
+
+} // namespace rbs::relations::peridynamic
+
+#endif // SHORTRANGECONTACT_H
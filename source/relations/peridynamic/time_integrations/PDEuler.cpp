@@ -43,28 +43,28 @@ Euler::Euler(Euler::PDPart &part)
                 if (!centre.has(Property::Volume))
                     throw std::runtime_error("The time integration cannot proceed without volume at all of the Nodes.");
 
-                v_t = (centre.has(Property::Velocity)) ? centre.at(Property::Velocity).value<space::vec3>() : space::consts::o3D;
-                x_t = (centre.has(Property::Displacement)) ? centre.at(Property::Displacement).value<space::vec3>() : space::consts::o3D;
+                v_t = keys::Velocity::getOr(centre, space::consts::o3D);
+                x_t = keys::Displacement::getOr(centre, space::consts::o3D);
 
-                bodyForce = centre.has(Property::BodyForce) ? centre.at(Property::BodyForce).value<space::vec3>() : space::consts::o3D;
-                force = (centre.has(Property::Force)) ? centre.at(Property::Force).value<space::vec3>() : space::consts::o3D;
+                bodyForce = keys::BodyForce::getOr(centre, space::consts::o3D);
+                force = keys::Force::getOr(centre, space::consts::o3D);
 
-                a = (force + bodyForce) / centre.at(Property::Density).value<double>();
+                a = (force + bodyForce) / keys::Density::get(centre);
                 v = v_t + a * p_dt;
                 x = x_t + v * p_dt;
 
                 if (centre.has(Property::Acceleration) || !a.isZero()) {
-                    centre.at(Property::Acceleration) = a;
+                    keys::Acceleration::set(centre, a);
                     problemSize++;
                 }
 
                 if (centre.has(Property::Velocity) || !v.isZero()) {
-                    centre.at(Property::Velocity) = v;
+                    keys::Velocity::set(centre, v);
                     problemSize++;
                 }
 
                 if (centre.has(Property::Displacement) || !x.isZero()) {
-                    centre.at(Property::Displacement) = x;
+                    keys::Displacement::set(centre, x);
                     problemSize++;
                 }
             });
@@ -93,6 +93,7 @@ Euler::Euler(Euler::PDPart &part)
         const auto start_t = clock();
         const auto& neighborhoods = part.neighborhoods();
 
+        keys::typeColumns(part.properties());
         update(neighborhoods.begin(), neighborhoods.end());
 
         const auto problemSize = neighborhoods.size();
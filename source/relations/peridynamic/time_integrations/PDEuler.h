@@ -12,6 +12,7 @@
 
 
 #include "../Property.h"
+#include "../PropertyKeys.h"
 #include "../../Relation.h"
 
 /**
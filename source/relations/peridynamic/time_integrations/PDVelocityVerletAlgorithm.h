@@ -11,6 +11,7 @@
 #define VelocityVerletAlgorithm_H
 
 #include "../Property.h"
+#include "../PropertyKeys.h"
 #include "../../Relation.h"
 
 /**
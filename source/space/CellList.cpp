@@ -0,0 +1,87 @@
+//
+//  CellList.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "CellList.h"
+#include <stdexcept>
+
+namespace rbs::space {
+
+CellList::CellList(const double cellSize)
+    : p_bucketStarts{}
+    , p_cells{}
+    , p_cellSize{cellSize}
+    , p_ids{}
+    , p_inverseCellSize{0}
+    , p_mask{0}
+    , p_positions{}
+{
+    if (!(cellSize > 0))
+        throw std::out_of_range("The cell size of the cell list must be bigger than zero.");
+    p_inverseCellSize = 1 / cellSize;
+}
+
+double CellList::cellSize() const {
+    return p_cellSize;
+}
+
+void CellList::within(const Vector<3> &position, const double radius, CellList::Ids &ids) const {
+    const auto squareRadius = radius * radius;
+    forEachCandidate(position, radius, [&](const Id id) {
+        if ((p_positions[id] - position).lengthSquared() <= squareRadius)
+            ids.emplace_back(id);
+    });
+}
+
+size_t CellList::size() const {
+    return p_ids.size();
+}
+
+void CellList::assign(const CellList::Positions &positions) {
+    const auto size = positions.size();
+    size_t buckets = 1;
+    while (buckets < 2 * size)
+        buckets <<= 1;
+    p_mask = buckets - 1;
+    p_positions = positions;
+
+    // Counting sort of the points by their bucket.
+    std::vector<Cell> cells(size);
+    std::vector<size_t> pointBuckets(size);
+    p_bucketStarts.assign(buckets + 1, 0);
+    for (size_t id = 0; id < size; id++) {
+        cells[id] = cellOf(positions[id]);
+        pointBuckets[id] = bucketOf(cells[id]);
+        p_bucketStarts[pointBuckets[id] + 1]++;
+    }
+    for (size_t bucket = 0; bucket < buckets; bucket++)
+        p_bucketStarts[bucket + 1] += p_bucketStarts[bucket];
+
+    auto next = p_bucketStarts;
+    p_cells.resize(size);
+    p_ids.resize(size);
+    for (size_t id = 0; id < size; id++) {
+        const auto entry = next[pointBuckets[id]]++;
+        p_cells[entry] = cells[id];
+        p_ids[entry] = static_cast<Id>(id);
+    }
+}
+
+size_t CellList::bucketOf(const CellList::Cell &cell) const {
+    const auto hash = std::uint64_t(cell[0]) * 73856093u
+            ^ std::uint64_t(cell[1]) * 19349663u
+            ^ std::uint64_t(cell[2]) * 83492791u;
+    return static_cast<size_t>(hash) & p_mask;
+}
+
+CellList::Cell CellList::cellOf(const Vector<3> &position) const {
+    return Cell{static_cast<std::int64_t>(std::floor(position[0] * p_inverseCellSize)),
+                static_cast<std::int64_t>(std::floor(position[1] * p_inverseCellSize)),
+                static_cast<std::int64_t>(std::floor(position[2] * p_inverseCellSize))};
+}
+
+} // namespace rbs::space
@@ -0,0 +1,136 @@
+//
+//  CellList.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef CELLLIST_H
+#define CELLLIST_H
+
+#include "Vector.h"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The space namespace provides the means to handle matters related to the mathematical space.
+ */
+namespace rbs::space {
+
+/**
+ * @brief The CellList is a spatial index of a list of points, for finding the points close to a position.
+ * @details The space is divided into cubic cells and the points are sorted by the hash of their cell; thus, building
+ *          the list is linear in the number of points (i.e., cheap enough to rebuild as the points move) and a query
+ *          only visits the points of the cells overlapping its box.
+ * @note The list does not follow the points; after they move, either rebuild it or extend the query radius by the
+ *          largest distance the points have moved since the last build.
+ */
+class CellList
+{
+public:
+    using Id = std::uint32_t;
+    using Ids = std::vector<Id>;
+    using Positions = std::vector<Vector<3> >;
+
+    /**
+     * @brief The constructor.
+     * @param cellSize The edge length of the cells; usually the largest query radius.
+     * @throws If the cell size is not positive.
+     */
+    explicit CellList(const double cellSize);
+
+    /**
+     * @brief Gives the edge length of the cells.
+     */
+    double cellSize() const;
+
+    /**
+     * @brief Calls a function with the id of each point whose cell overlaps the cuboid around a position.
+     * @note The candidates are not filtered by their distance to the position.
+     * @param position The centre of the query.
+     * @param radius The half edge length of the query cuboid.
+     * @param function The function receiving the id of the candidate (i.e., its position on the built points).
+     */
+    template<typename Function>
+    void forEachCandidate(const Vector<3>& position, const double radius, const Function& function) const;
+
+    /**
+     * @brief Gives the ids of the points within a radius of a position, using the positions the list was built with.
+     * @param position The centre of the query.
+     * @param radius The radius of the query.
+     * @param ids The list to append the ids to.
+     */
+    void within(const Vector<3>& position, const double radius, Ids& ids) const;
+
+    /**
+     * @brief Gives the number of the indexed points.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Rebuilds the list for a new list of points.
+     * @param positions The positions of the points; the id of each point is its position on the list.
+     */
+    void assign(const Positions& positions);
+
+private:
+    using Cell = std::array<std::int64_t, 3>;
+
+    /**
+     * @brief Gives the bucket of a cell.
+     */
+    size_t bucketOf(const Cell& cell) const;
+
+    /**
+     * @brief Gives the cell of a position.
+     */
+    Cell cellOf(const Vector<3>& position) const;
+
+    std::vector<size_t> p_bucketStarts; // The begin of each bucket on the entries (plus the end of the last one).
+    std::vector<Cell> p_cells;          // The cell of each entry.
+    double p_cellSize;                  // The edge length of the cells.
+    Ids p_ids;                          // The ids of the points sorted by their bucket.
+    double p_inverseCellSize;           // The inverse of the cell edge length.
+    size_t p_mask;                      // The mask of the bucket hashes.
+    Positions p_positions;              // The positions of the entries.
+};
+
+template<typename Function>
+void CellList::forEachCandidate(const Vector<3> &position, const double radius, const Function &function) const {
+    if (p_ids.empty())
+        return;
+
+    const auto lower = cellOf(position - Vector<3>{radius, radius, radius});
+    const auto upper = cellOf(position + Vector<3>{radius, radius, radius});
+    const auto cellsSize = double(upper[0] - lower[0] + 1) * double(upper[1] - lower[1] + 1) * double(upper[2] - lower[2] + 1);
+    if (cellsSize > p_ids.size()) { // Scanning the entries is cheaper than visiting the cells.
+        for (size_t entry = 0; entry < p_ids.size(); entry++) {
+            const auto& cell = p_cells[entry];
+            if (lower[0] <= cell[0] && cell[0] <= upper[0]
+                    && lower[1] <= cell[1] && cell[1] <= upper[1]
+                    && lower[2] <= cell[2] && cell[2] <= upper[2])
+                function(p_ids[entry]);
+        }
+        return;
+    }
+
+    Cell cell;
+    for (cell[2] = lower[2]; cell[2] <= upper[2]; cell[2]++) {
+        for (cell[1] = lower[1]; cell[1] <= upper[1]; cell[1]++) {
+            for (cell[0] = lower[0]; cell[0] <= upper[0]; cell[0]++) {
+                const auto bucket = bucketOf(cell);
+                for (auto entry = p_bucketStarts[bucket]; entry < p_bucketStarts[bucket + 1]; entry++) {
+                    if (p_cells[entry] == cell) // The other cells of the same bucket are visited on their own turn.
+                        function(p_ids[entry]);
+                }
+            }
+        }
+    }
+}
+
+} // namespace rbs::space
+
+#endif // CELLLIST_H
@@ -29,8 +29,9 @@ public:
 
     /**
      * @brief The constructor.
+     * @note The components are not initialized.
      */
-    Index();
+    Index() = default;
 
     /**
      * @brief The constructor.
@@ -43,30 +44,39 @@ public:
      * @brief The copy constructor.
      * @param other The other Index to copy.
      */
-    Index(const Index & other);
+    Index(const Index & other) = default;
 
     /**
      * @brief The move constructor.
      * @param other The other Index to move.
      */
-    Index(Index && other);
+    Index(Index && other) = default;
 
     /**
-     * @brief Default virtual destructor.
+     * @brief Default destructor.
      */
-    virtual ~Index(){};
+    ~Index() = default;
 
     /**
-     * @brief Move/copy assign operator.
-     * @param other The other Index to move or copy.
+     * @brief Copy assign operator.
+     * @param other The other Index to copy.
      * @return The new Index.
      */
-    Index & operator =(Index other);
+    Index & operator =(const Index & other) = default;
+
+    /**
+     * @brief Move assign operator.
+     * @param other The other Index to move.
+     * @return The new Index.
+     */
+    Index & operator =(Index && other) = default;
 
     /**
      * @brief Gives the name of the class.
      */
-    virtual std::string name() const override;
+    std::string name() const;
+
+    operator std::string() const;
 
     constexpr friend inline bool operator < (const Index &in1, const Index &in2) {
         for(unsigned char i = 0; i < SpaceDimension; ++i) {
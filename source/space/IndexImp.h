@@ -17,23 +17,13 @@
 namespace rbs::space {
 
 template<unsigned char SpaceDimension>
-Index<SpaceDimension>::Index() : Space() {}
-
-template<unsigned char SpaceDimension>
-Index<SpaceDimension>::Index(const Index &other) : Space(other) {}
-
-template<unsigned char SpaceDimension>
-Index<SpaceDimension>::Index(Index &&other) : Space(other) {}
-
-template<unsigned char SpaceDimension>
-Index<SpaceDimension> &Index<SpaceDimension>::operator =(Index other){
-    Space::operator =(other);
-    return *this;
+std::string Index<SpaceDimension>::name() const {
+    return "Index";
 }
 
 template<unsigned char SpaceDimension>
-std::string Index<SpaceDimension>::name() const {
-    return "Index";
+Index<SpaceDimension>::operator std::string() const {
+    return Space::to_string(name());
 }
 
 } // namespace rbs::space
@@ -0,0 +1,108 @@
+//
+//  KDTree.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "KDTree.h"
+#include <algorithm>
+#include <numeric>
+
+namespace rbs::space {
+
+namespace {
+
+constexpr size_t leafSize = 8;  // The largest range that is searched without splitting.
+
+} // namespace
+
+KDTree::KDTree(const KDTree::Positions &positions)
+    : p_axes{}
+    , p_ids{}
+    , p_positions{}
+{
+    assign(positions);
+}
+
+size_t KDTree::size() const {
+    return p_ids.size();
+}
+
+void KDTree::within(const Vector<3> &position, const double radius, KDTree::Ids &ids) const {
+    const auto first = ids.size();
+    search(0, p_ids.size(), position, radius * radius, ids);
+    std::sort(ids.begin() + first, ids.end());
+}
+
+void KDTree::within(const KDTree::Positions &positions, const double radius, std::vector<KDTree::Ids> &ids) const {
+    ids.resize(positions.size());
+    for (size_t query = 0; query < positions.size(); query++) {
+        ids[query].clear();
+        within(positions[query], radius, ids[query]);
+    }
+}
+
+void KDTree::assign(const KDTree::Positions &positions) {
+    p_positions = positions;
+    p_ids.resize(positions.size());
+    std::iota(p_ids.begin(), p_ids.end(), Id(0));
+    p_axes.assign(positions.size(), 0);
+    build(0, positions.size());
+
+    // Storing the positions in the tree order.
+    for (size_t point = 0; point < p_ids.size(); point++)
+        p_positions[point] = positions[p_ids[point]];
+}
+
+void KDTree::build(const size_t begin, const size_t end) {
+    if (end - begin <= leafSize)
+        return;
+
+    // The positions are still in the id order while building.
+    auto lower = p_positions[p_ids[begin]];
+    auto upper = lower;
+    for (auto point = begin + 1; point < end; point++) {
+        const auto& position = p_positions[p_ids[point]];
+        for (unsigned char i = 0; i < 3; i++) {
+            lower[i] = std::min(lower[i], position[i]);
+            upper[i] = std::max(upper[i], position[i]);
+        }
+    }
+    const auto extent = upper - lower;
+    const unsigned char axis = (extent[0] >= extent[1] && extent[0] >= extent[2]) ? 0 : (extent[1] >= extent[2]) ? 1 : 2;
+
+    const auto median = begin + (end - begin) / 2;
+    std::nth_element(p_ids.begin() + begin, p_ids.begin() + median, p_ids.begin() + end, [this, axis](const Id lhs, const Id rhs) {
+        return p_positions[lhs][axis] < p_positions[rhs][axis];
+    });
+
+    p_axes[median] = axis;
+    build(begin, median);
+    build(median + 1, end);
+}
+
+void KDTree::search(const size_t begin, const size_t end, const Vector<3> &position, const double squareRadius, KDTree::Ids &ids) const {
+    if (end - begin <= leafSize) {
+        for (auto point = begin; point < end; point++) {
+            if ((p_positions[point] - position).lengthSquared() <= squareRadius)
+                ids.emplace_back(p_ids[point]);
+        }
+        return;
+    }
+
+    const auto median = begin + (end - begin) / 2;
+    const auto axis = p_axes[median];
+    if ((p_positions[median] - position).lengthSquared() <= squareRadius)
+        ids.emplace_back(p_ids[median]);
+
+    const auto distance = position[axis] - p_positions[median][axis];
+    const auto nearFirst = distance < 0;
+    if (nearFirst || distance * distance <= squareRadius)
+        search(begin, median, position, squareRadius, ids);
+    if (!nearFirst || distance * distance <= squareRadius)
+        search(median + 1, end, position, squareRadius, ids);
+}
+
+} // namespace rbs::space
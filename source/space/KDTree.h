@@ -0,0 +1,87 @@
+//
+//  KDTree.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef KDTREE_H
+#define KDTREE_H
+
+#include "Vector.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * The space namespace provides the means to handle matters related to the mathematical space.
+ */
+namespace rbs::space {
+
+/**
+ * @brief The KDTree is a balanced k-d tree of a list of 3D points, for exact radius queries.
+ * @details The points are split at the median along the axis of their largest extent, recursively, and the tree is
+ *          stored implicitly in the order of the points (i.e., the median of each range is the node of the range).
+ *          Thus, a query only visits the ranges whose splitting plane is closer than the radius, independent of the
+ *          distribution of the points, which makes it suitable for the points of curved or rotated grids.
+ */
+class KDTree
+{
+public:
+    using Id = std::uint32_t;
+    using Ids = std::vector<Id>;
+    using Positions = std::vector<Vector<3> >;
+
+    /**
+     * @brief The constructor.
+     * @param positions The positions of the points; the id of each point is its position on the list.
+     */
+    explicit KDTree(const Positions& positions = {});
+
+    /**
+     * @brief Gives the number of the points.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Gives the ids of the points within a radius of a position.
+     * @param position The centre of the query.
+     * @param radius The radius of the query.
+     * @param ids The list to append the ids to, in ascending order.
+     */
+    void within(const Vector<3>& position, const double radius, Ids& ids) const;
+
+    /**
+     * @brief Gives the ids of the points within a radius of each of a list of positions.
+     * @param positions The centres of the queries.
+     * @param radius The radius of the queries.
+     * @param ids The ids of each query, in ascending order; resized to the number of the queries.
+     */
+    void within(const Positions& positions, const double radius, std::vector<Ids>& ids) const;
+
+    /**
+     * @brief Rebuilds the tree for a new list of points.
+     * @param positions The positions of the points; the id of each point is its position on the list.
+     */
+    void assign(const Positions& positions);
+
+private:
+
+    /**
+     * @brief Sorts the points of a range around its median along the axis of its largest extent and recurses.
+     */
+    void build(const size_t begin, const size_t end);
+
+    /**
+     * @brief Appends the ids of the points of a range within a radius of a position.
+     */
+    void search(const size_t begin, const size_t end, const Vector<3>& position, const double squareRadius, Ids& ids) const;
+
+    std::vector<unsigned char> p_axes;  // The splitting axis of the range having each point as its median.
+    Ids p_ids;                          // The ids of the points in the tree order.
+    Positions p_positions;              // The positions of the points in the tree order.
+};
+
+} // namespace rbs::space
+
+#endif // KDTREE_H
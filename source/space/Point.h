@@ -21,6 +21,7 @@ namespace rbs::space {
  * @note Often the concept of point in space is presented with a vector (i.e., position vector
  *       of the point). The problem with this approach is that it makes it very easy to unintentionally
  *       perform vector arithmetic on points.
+ * @note The Point holds its position vector by value; thus, like the Vector, it is trivially copyable.
  */
 template<unsigned char SpaceDimension>
 class Point
@@ -31,8 +32,9 @@ public:
 
     /**
      * @brief The constructor.
+     * @note The position vector is not initialized.
      */
-    Point();
+    Point() = default;
 
     /**
      * @brief The constructor.
@@ -45,13 +47,13 @@ public:
      * @brief The copy constructor.
      * @param other The other Point to copy.
      */
-    Point(const Point & other);
+    Point(const Point & other) = default;
 
     /**
      * @brief The move constructor.
      * @param other The other Point to move.
      */
-    Point(Point && other);
+    Point(Point && other) = default;
 
     /**
      * @brief The Vector copy constructor.
@@ -66,16 +68,23 @@ public:
     Point(Vector<SpaceDimension> && positionVector);
 
     /**
-     * @brief Default virtual destructor.
+     * @brief Default destructor.
      */
-    virtual ~Point () = default;
+    ~Point () = default;
 
     /**
-     * @brief Move/copy assign operator.
-     * @param other The other Point to move or copy.
-     * @return The new Vector.
+     * @brief Copy assign operator.
+     * @param other The other Point to copy.
+     * @return The new Point.
+     */
+    Point & operator =(const Point & other) = default;
+
+    /**
+     * @brief Move assign operator.
+     * @param other The other Point to move.
+     * @return The new Point.
      */
-    Point & operator =(Point other);
+    Point & operator =(Point && other) = default;
 
     /**
      * @brief Computes the centre of the point list.
@@ -113,7 +122,7 @@ public:
     /**
      * @brief Gives the name of the class.
      */
-    virtual std::string name() const;
+    std::string name() const;
 
     /**
      * @brief Gives read-only access to the point's position vector.
@@ -136,21 +145,19 @@ public:
     Point &operator-=(const Vector<SpaceDimension> &other);
 
     constexpr friend inline bool operator==(const Point &p1, const Point &p2){
-        if (!p1.p_postitionVector && !p1.p_postitionVector)
-            return true;
-        return p1.p_postitionVector && p1.p_postitionVector &&  *p1.p_postitionVector == *p2.p_postitionVector;
+        return p1.p_postitionVector == p2.p_postitionVector;
     }
     constexpr friend inline bool operator!=(const Point &p1, const Point &p2){
         return !operator==(p1, p2);
     }
 
     constexpr friend inline const Point operator+(const Point &point, const Vector<SpaceDimension> &vector) {
-        Vector<SpaceDimension> ans = *point.p_postitionVector;
+        Vector<SpaceDimension> ans = point.p_postitionVector;
         ans += vector;
         return ans;
     }
     constexpr friend inline const Point operator-(const Point &point, const Vector<SpaceDimension> &vector) {
-        Vector<SpaceDimension> ans = *point.p_postitionVector;
+        Vector<SpaceDimension> ans = point.p_postitionVector;
         ans -= vector;
         return ans;
     }
@@ -160,21 +167,16 @@ public:
 protected:
 
     using Location = Vector<SpaceDimension>;
-    using LocationPtr = std::shared_ptr<Location>;
 
 private:
 
-    /**
-     * @brief swaps the content of this object with an other objec of same type.
-     * @param other The other instance.
-     */
-    void swap(Point & other);
-
     static constexpr auto ps_className = "Point";
-    LocationPtr p_postitionVector;
+    Location p_postitionVector;
 
 };
 
+static_assert(std::is_trivially_copyable_v<Point<3> > && sizeof(Point<3>) == 3 * sizeof(double), "The points must stay plain arrays of components.");
+
 } // namespace rbs::space
 
 #ifndef POINTIMP_H
@@ -15,43 +15,21 @@
 
 namespace rbs::space {
 
-template<unsigned char SpaceDimension>
-Point<SpaceDimension>::Point()
-    : p_postitionVector{std::make_shared<Location>()}
-{}
-
 template<unsigned char SpaceDimension>
 Point<SpaceDimension>::Point(std::initializer_list<double> values)
-    : p_postitionVector{std::make_shared<Location>(values)}
+    : p_postitionVector{values}
 {}
 
-template<unsigned char SpaceDimension>
-Point<SpaceDimension>::Point(const Point &other)
-{
-    p_postitionVector = (other.p_postitionVector) ? std::make_shared<Vector<SpaceDimension> >(*other.p_postitionVector) : nullptr;
-}
-
-template<unsigned char SpaceDimension>
-Point<SpaceDimension>::Point(Point &&other) {
-    p_postitionVector = std::move(other.p_postitionVector);
-}
-
 template<unsigned char SpaceDimension>
 Point<SpaceDimension>::Point(const Vector<SpaceDimension> &positionVector)
-    : p_postitionVector{std::make_shared<Location>(positionVector)}
+    : p_postitionVector{positionVector}
 {}
 
 template<unsigned char SpaceDimension>
 Point<SpaceDimension>::Point(Vector<SpaceDimension> &&positionVector)
-    : p_postitionVector{std::make_shared<Location>(positionVector)}
+    : p_postitionVector{positionVector}
 {}
 
-template<unsigned char SpaceDimension>
-Point<SpaceDimension> &Point<SpaceDimension>::operator =(Point other) {
-    swap(other);
-    return *this;
-}
-
 template<unsigned char SpaceDimension>
 constexpr unsigned char Point<SpaceDimension>::dimension() const {
     return SpaceDimension;
@@ -64,15 +42,13 @@ std::string Point<SpaceDimension>::name() const {
 
 template<unsigned char SpaceDimension>
 Point<SpaceDimension>::operator std::string() const {
-    if(p_postitionVector)
-        return std::string(name() + "{position_vector: ") + std::string(*p_postitionVector) + "}";
-    return std::string(name() + "{position_vector: null}");
+    return std::string(name() + "{position_vector: ") + std::string(p_postitionVector) + "}";
 }
 
 template<unsigned char SpaceDimension>
 Point<SpaceDimension> Point<SpaceDimension>::centre(std::vector<Point> points) {
     return std::reduce(points.begin(), points.end(), Point().zero(), [](const auto & acc, const auto & point) {
-        return *acc.p_postitionVector + *point.p_postitionVector;
+        return acc.p_postitionVector + point.p_postitionVector;
     }).positionVector() / points.size();
 }
 
@@ -98,37 +74,32 @@ Vector<SpaceDimension> Point<SpaceDimension>::vector(const Point<SpaceDimension>
 
 template<unsigned char SpaceDimension>
 const Vector<SpaceDimension> &Point<SpaceDimension>::positionVector() const {
-    return *p_postitionVector;
+    return p_postitionVector;
 }
 
 template<unsigned char SpaceDimension>
 Vector<SpaceDimension> &Point<SpaceDimension>::positionVector() {
-    return *p_postitionVector;
+    return p_postitionVector;
 }
 
 template<unsigned char SpaceDimension>
 Point<SpaceDimension> &Point<SpaceDimension>::zero() {
-    p_postitionVector->zero();
+    p_postitionVector.zero();
     return *this;
 }
 
 template<unsigned char SpaceDimension>
 Point<SpaceDimension> &Point<SpaceDimension>::operator+=(const Vector<SpaceDimension> &other) {
-    p_postitionVector->operator += (other);
+    p_postitionVector += other;
     return *this;
 }
 
 template<unsigned char SpaceDimension>
 Point<SpaceDimension> &Point<SpaceDimension>::operator-=(const Vector<SpaceDimension> &other) {
-    p_postitionVector->operator -= (other);
+    p_postitionVector -= other;
     return *this;
 }
 
-template<unsigned char SpaceDimension>
-void Point<SpaceDimension>::swap(Point &other) {
-    std::swap(p_postitionVector, other.p_postitionVector);
-}
-
 template<unsigned char SpaceDimension>
 std::ostream & operator << (std::ostream & out, const Point<SpaceDimension> & point) {
     return out << std::string(point);
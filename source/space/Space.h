@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <string>
+#include <type_traits>
 
 /**
  * The space namespace provides the means to handle matters related to the mathematical space.
@@ -40,6 +41,8 @@ constexpr bool isZero(T value);
  * @details ​Since any simulation will be defined over a space (i.g. 2D), flexibility in the choice
  *          of space of any order is crucial to any simulator. This class does provide the required
  *          flexibility.
+ * @note The Space (and its subclasses) is not polymorphic and is trivially copyable; thus, it holds nothing but its
+ *       components and the arrays of spaces can be copied with memcpy and vectorized by the compiler.
  */
 template<typename T, unsigned char Dimension>
 class Space {
@@ -49,8 +52,9 @@ public:
 
     /**
      * @brief The constructor.
+     * @note The components are not initialized.
      */
-    Space();
+    Space() = default;
 
     /**
      * @brief The constructor.
@@ -63,18 +67,18 @@ public:
      * @brief The copy constructor.
      * @param other The other Space to copy.
      */
-    Space(const Space & other);
+    Space(const Space & other) = default;
 
     /**
      * @brief The move constructor.
      * @param other The other Space to move.
      */
-    Space(Space && other);
+    Space(Space && other) = default;
 
     /**
-     * @brief Default virtual destructor.
+     * @brief Default destructor.
      */
-    virtual ~Space() = default;
+    ~Space() = default;
 
     /**
      * @brief Gives the dimension of the space.
@@ -84,14 +88,21 @@ public:
     /**
      * @brief Gives the name of the class.
      */
-    virtual std::string name() const;
+    std::string name() const;
 
     /**
-     * @brief Move/copy assign operator.
-     * @param other The other Space to move or copy.
+     * @brief Copy assign operator.
+     * @param other The other Space to copy.
+     * @return The new Space.
+     */
+    Space &operator =(const Space & other) = default;
+
+    /**
+     * @brief Move assign operator.
+     * @param other The other Space to move.
      * @return The new Space.
      */
-    Space &operator =(Space other);
+    Space &operator =(Space && other) = default;
 
     T &operator [](Index index);
     const T & operator [](Index index) const;
@@ -120,13 +131,13 @@ protected:
      */
     const T *end() const;
 
-private:
-
     /**
-     * @brief Swaps the content of this object with an other objec of same type.
-     * @param other The other instance.
+     * @brief Converts the space to string using the given class name.
+     * @param name The name of the class.
      */
-    void swap(Space & other);
+    std::string to_string(const std::string& name) const;
+
+private:
 
     T p_components[Dimension];
 
@@ -0,0 +1,77 @@
+//
+//  SpaceFillingCurve.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "SpaceFillingCurve.h"
+#include <algorithm>
+
+namespace rbs::space {
+
+namespace {
+
+/**
+ * @brief Spreads the lower 21 bits of a value so that there are two zero bits between each of them.
+ */
+SpaceFillingCurve::Key spread(const std::uint32_t value) {
+    auto ans = SpaceFillingCurve::Key(value) & 0x1fffff;
+    ans = (ans | ans << 32) & 0x1f00000000ffff;
+    ans = (ans | ans << 16) & 0x1f0000ff0000ff;
+    ans = (ans | ans << 8)  & 0x100f00f00f00f00f;
+    ans = (ans | ans << 4)  & 0x10c30c30c30c30c3;
+    ans = (ans | ans << 2)  & 0x1249249249249249;
+    return ans;
+}
+
+} // namespace
+
+SpaceFillingCurve::Cell SpaceFillingCurve::cell(const Vector<3> &position, const Vector<3> &lower, const Vector<3> &upper) {
+    constexpr auto last = double((1u << bits) - 1);
+    Cell ans;
+    for (size_t axis = 0; axis < 3; axis++) {
+        const auto extent = upper[axis] - lower[axis];
+        const auto ratio = (extent > 0) ? (position[axis] - lower[axis]) / extent : 0.;
+        ans[axis] = static_cast<std::uint32_t>(std::clamp(ratio, 0., 1.) * last);
+    }
+    return ans;
+}
+
+SpaceFillingCurve::Key SpaceFillingCurve::hilbert(const SpaceFillingCurve::Cell &cell) {
+    // Skilling's algorithm: the axes are transformed in place into the transposed Hilbert index.
+    auto x = cell;
+    const std::uint32_t top = 1u << (bits - 1);
+    for (auto q = top; q > 1; q >>= 1) {
+        const auto p = q - 1;
+        for (size_t axis = 0; axis < 3; axis++) {
+            if (x[axis] & q) {
+                x[0] ^= p;
+            } else {
+                const auto t = (x[0] ^ x[axis]) & p;
+                x[0] ^= t;
+                x[axis] ^= t;
+            }
+        }
+    }
+
+    x[1] ^= x[0];
+    x[2] ^= x[1];
+    std::uint32_t t = 0;
+    for (auto q = top; q > 1; q >>= 1) {
+        if (x[2] & q)
+            t ^= q - 1;
+    }
+    for (auto& component : x)
+        component ^= t;
+
+    // The first axis holds the most significant bit of each level.
+    return spread(x[2]) | spread(x[1]) << 1 | spread(x[0]) << 2;
+}
+
+SpaceFillingCurve::Key SpaceFillingCurve::morton(const SpaceFillingCurve::Cell &cell) {
+    return spread(cell[0]) | spread(cell[1]) << 1 | spread(cell[2]) << 2;
+}
+
+} // namespace rbs::space
@@ -0,0 +1,61 @@
+//
+//  SpaceFillingCurve.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef SPACEFILLINGCURVE_H
+#define SPACEFILLINGCURVE_H
+
+#include "Vector.h"
+#include <array>
+#include <cstdint>
+
+/**
+ * The space namespace provides the means to handle matters related to the mathematical space.
+ */
+namespace rbs::space {
+
+/**
+ * @brief The SpaceFillingCurve maps the cells of a 3D grid to their position along a space-filling curve.
+ * @details Sorting points by their curve position places the points that are close in space close to each other in the
+ *          sorted list. The Morton (i.e., Z-order) curve is the cheaper one to compute, while the Hilbert curve never
+ *          jumps between non-adjacent cells and thus gives the better locality.
+ * @note The grid has 2^21 cells along each axis; thus, the positions fit in 63 bits.
+ */
+class SpaceFillingCurve
+{
+public:
+    using Cell = std::array<std::uint32_t, 3>;
+    using Key = std::uint64_t;
+
+    /**
+     * @brief The number of bits of the cell index along each axis.
+     */
+    static constexpr unsigned bits = 21;
+
+    /**
+     * @brief Gives the cell of a position inside a box.
+     * @note The positions outside the box are clamped to the box.
+     * @param position The position.
+     * @param lower The lower corner of the box.
+     * @param upper The upper corner of the box.
+     */
+    static Cell cell(const Vector<3>& position, const Vector<3>& lower, const Vector<3>& upper);
+
+    /**
+     * @brief Gives the position of a cell along the Hilbert curve.
+     */
+    static Key hilbert(const Cell& cell);
+
+    /**
+     * @brief Gives the position of a cell along the Morton (i.e., Z-order) curve.
+     */
+    static Key morton(const Cell& cell);
+};
+
+} // namespace rbs::space
+
+#endif // SPACEFILLINGCURVE_H
@@ -43,9 +43,6 @@ constexpr bool isZero(T value) {
     return value == 0;
 }
 
-template<typename T, unsigned char Dimension>
-Space<T, Dimension>::Space() {}
-
 template<typename T, unsigned char Dimension>
 Space<T, Dimension>::Space(std::initializer_list<T> values) {
     if (values.size() != Dimension)
@@ -54,20 +51,6 @@ Space<T, Dimension>::Space(std::initializer_list<T> values) {
     std::copy(values.begin(), values.end(), std::begin(p_components));
 }
 
-template<typename T, unsigned char Dimension>
-Space<T, Dimension>::Space(const Space &other) {
-    std::copy(std::begin(other.p_components),
-              std::end(other.p_components),
-              std::begin(p_components));
-}
-
-template<typename T, unsigned char Dimension>
-Space<T, Dimension>::Space(Space &&other) {
-    std::move(std::begin(other.p_components),
-              std::end(other.p_components),
-              std::begin(p_components));
-}
-
 template<typename T, unsigned char Dimension>
 constexpr unsigned char Space<T, Dimension>::dimension() const {
     return Dimension;
@@ -78,12 +61,6 @@ std::string Space<T, Dimension>::name() const {
     return "Space";
 }
 
-template<typename T, unsigned char Dimension>
-Space<T, Dimension> &Space<T, Dimension>::operator =(Space other) {
-    swap(other);
-    return *this;
-}
-
 template<typename T, unsigned char Dimension>
 T &Space<T, Dimension>::operator [](Space::Index index) {
     if(index > Dimension)
@@ -100,7 +77,12 @@ const T &Space<T, Dimension>::operator [](Space::Index index) const {
 
 template<typename T, unsigned char Dimension>
 Space<T, Dimension>::operator std::string() const {
-    std::string ans = name() + "{";
+    return to_string(name());
+}
+
+template<typename T, unsigned char Dimension>
+std::string Space<T, Dimension>::to_string(const std::string &name) const {
+    std::string ans = name + "{";
     for(Index itr = 0; itr < Dimension; ++itr)
         if (itr + 1 != Dimension) {
             ans = ans + std::to_string(p_components[itr]) + ", ";
@@ -110,11 +92,6 @@ Space<T, Dimension>::operator std::string() const {
     return ans;
 }
 
-template<typename T, unsigned char Dimension>
-void Space<T, Dimension>::swap(Space &other) {
-    std::swap_ranges(std::begin(p_components), std::end(p_components), std::begin(other.p_components));
-}
-
 template<typename T, unsigned char Dimension>
 const T * Space<T, Dimension>::begin() const {
     return std::begin(p_components);
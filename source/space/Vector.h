@@ -10,6 +10,7 @@
 #define VECTOR_H
 
 #include "Space.h"
+#include <cmath>
 #include <numeric>
 
 /**
@@ -32,8 +33,9 @@ public:
 
     /**
      * @brief The constructor.
+     * @note The components are not initialized.
      */
-    Vector();
+    Vector() = default;
 
     /**
      * @brief The constructor.
@@ -46,25 +48,32 @@ public:
      * @brief The copy constructor.
      * @param other The other Vector to copy.
      */
-    Vector(const Vector & other);
+    Vector(const Vector & other) = default;
 
     /**
      * @brief The move constructor.
      * @param other The other Vector to move.
      */
-    Vector(Vector && other);
+    Vector(Vector && other) = default;
 
     /**
-     * @brief Default virtual destructor.
+     * @brief Default destructor.
      */
-    virtual ~Vector() = default;
+    ~Vector() = default;
 
     /**
-     * @brief Move/copy assign operator.
-     * @param other The other Vector to move or copy.
+     * @brief Copy assign operator.
+     * @param other The other Vector to copy.
+     * @return The new Vector.
+     */
+    Vector & operator =(const Vector & other) = default;
+
+    /**
+     * @brief Move assign operator.
+     * @param other The other Vector to move.
      * @return The new Vector.
      */
-    Vector & operator =(Vector other);
+    Vector & operator =(Vector && other) = default;
 
     /**
      * @brief Computes the angle between two vectors.
@@ -155,7 +164,7 @@ public:
     /**
      * @brief Gives the name of the class.
      */
-    virtual std::string name() const override;
+    std::string name() const;
 
     /**
      * @brief Finds a perpendicular vector to this vector on direction of other vector
@@ -209,6 +218,8 @@ public:
     Vector &operator^=(double power);
     Vector &operator/=(double divisor);
 
+    operator std::string() const;
+
     constexpr friend inline const Vector operator+(const Vector &vector) {
         return vector;
     }
@@ -299,6 +310,8 @@ using vec2 = Vector<2>;
 using vec1 = Vector<1>;
 using scalar = vec1;
 
+static_assert(std::is_trivially_copyable_v<vec3> && sizeof(vec3) == 3 * sizeof(double), "The vectors must stay plain arrays of components.");
+
 namespace consts {
 
     const Vector<1> o1D     = {0};
@@ -0,0 +1,343 @@
+//
+//  VectorBatch.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "VectorBatch.h"
+#include <cmath>
+#include <stdexcept>
+
+#if defined(__AVX__)
+#   include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#   include <emmintrin.h>
+#endif
+
+namespace rbs::space {
+
+namespace {
+
+/**
+ * @brief The scalar lane (i.e., one vector at a time).
+ */
+struct Scalar {
+    using Type = double;
+    static constexpr size_t width = 1;
+    static constexpr auto name = "scalar";
+
+    static Type load(const double* p) { return *p; }
+    static void store(double* p, const Type value) { *p = value; }
+    static Type set(const double value) { return value; }
+    static Type add(const Type a, const Type b) { return a + b; }
+    static Type sub(const Type a, const Type b) { return a - b; }
+    static Type mul(const Type a, const Type b) { return a * b; }
+    static Type div(const Type a, const Type b) { return a / b; }
+    static Type madd(const Type a, const Type b, const Type c) { return a * b + c; }
+    static Type sqrt(const Type a) { return std::sqrt(a); }
+    static double sum(const Type a) { return a; }
+    static double min(const Type a) { return a; }
+};
+
+#if defined(__AVX__)
+
+/**
+ * @brief The AVX lane (i.e., four vectors at a time).
+ */
+struct Simd {
+    using Type = __m256d;
+    static constexpr size_t width = 4;
+    static constexpr auto name = "AVX";
+
+    static Type load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, const Type value) { _mm256_storeu_pd(p, value); }
+    static Type set(const double value) { return _mm256_set1_pd(value); }
+    static Type add(const Type a, const Type b) { return _mm256_add_pd(a, b); }
+    static Type sub(const Type a, const Type b) { return _mm256_sub_pd(a, b); }
+    static Type mul(const Type a, const Type b) { return _mm256_mul_pd(a, b); }
+    static Type div(const Type a, const Type b) { return _mm256_div_pd(a, b); }
+#   if defined(__FMA__)
+    static Type madd(const Type a, const Type b, const Type c) { return _mm256_fmadd_pd(a, b, c); }
+#   else
+    static Type madd(const Type a, const Type b, const Type c) { return _mm256_add_pd(_mm256_mul_pd(a, b), c); }
+#   endif
+    static Type sqrt(const Type a) { return _mm256_sqrt_pd(a); }
+    static double sum(const Type a) {
+        double lanes[width];
+        _mm256_storeu_pd(lanes, a);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+    static double min(const Type a) {
+        double lanes[width];
+        _mm256_storeu_pd(lanes, a);
+        return std::min(std::min(lanes[0], lanes[1]), std::min(lanes[2], lanes[3]));
+    }
+};
+
+#elif defined(__SSE2__) || defined(_M_X64)
+
+/**
+ * @brief The SSE2 lane (i.e., two vectors at a time).
+ */
+struct Simd {
+    using Type = __m128d;
+    static constexpr size_t width = 2;
+    static constexpr auto name = "SSE2";
+
+    static Type load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, const Type value) { _mm_storeu_pd(p, value); }
+    static Type set(const double value) { return _mm_set1_pd(value); }
+    static Type add(const Type a, const Type b) { return _mm_add_pd(a, b); }
+    static Type sub(const Type a, const Type b) { return _mm_sub_pd(a, b); }
+    static Type mul(const Type a, const Type b) { return _mm_mul_pd(a, b); }
+    static Type div(const Type a, const Type b) { return _mm_div_pd(a, b); }
+    static Type madd(const Type a, const Type b, const Type c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static Type sqrt(const Type a) { return _mm_sqrt_pd(a); }
+    static double sum(const Type a) {
+        double lanes[width];
+        _mm_storeu_pd(lanes, a);
+        return lanes[0] + lanes[1];
+    }
+    static double min(const Type a) {
+        double lanes[width];
+        _mm_storeu_pd(lanes, a);
+        return std::min(lanes[0], lanes[1]);
+    }
+};
+
+#else
+
+using Simd = Scalar;
+
+#endif
+
+/**
+ * @brief Applies an operation on [0, size) using the widest lane, and the scalar lane for the remaining vectors.
+ * @param operation The operation taking the lane type and the index of the first vector.
+ */
+template<typename Operation>
+void apply(const size_t size, const Operation& operation) {
+    size_t index = 0;
+    if constexpr (Simd::width > 1) {
+        for (; index + Simd::width <= size; index += Simd::width)
+            operation(Simd{}, index);
+    }
+    for (; index < size; index++)
+        operation(Scalar{}, index);
+}
+
+/**
+ * @brief Checks whether the batches have the same size.
+ * @throws If the batches have different sizes.
+ */
+void checkSizes(const size_t lhs, const size_t rhs) {
+    if (lhs != rhs)
+        throw std::out_of_range("The vector batches have different sizes (" + std::to_string(lhs) + " and " + std::to_string(rhs) + ").");
+}
+
+} // namespace
+
+VectorBatch::VectorBatch(const size_t size)
+    : p_x(size, 0)
+    , p_y(size, 0)
+    , p_z(size, 0)
+{
+}
+
+void VectorBatch::add(const VectorBatch &lhs, const VectorBatch &rhs, VectorBatch &ans) {
+    checkSizes(lhs.size(), rhs.size());
+    ans.resize(lhs.size());
+    apply(lhs.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        L::store(ans.x() + i, L::add(L::load(lhs.x() + i), L::load(rhs.x() + i)));
+        L::store(ans.y() + i, L::add(L::load(lhs.y() + i), L::load(rhs.y() + i)));
+        L::store(ans.z() + i, L::add(L::load(lhs.z() + i), L::load(rhs.z() + i)));
+    });
+}
+
+void VectorBatch::dot(const VectorBatch &lhs, const VectorBatch &rhs, VectorBatch::Scalars &ans) {
+    checkSizes(lhs.size(), rhs.size());
+    ans.resize(lhs.size());
+    apply(lhs.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        auto sum = L::mul(L::load(lhs.x() + i), L::load(rhs.x() + i));
+        sum = L::madd(L::load(lhs.y() + i), L::load(rhs.y() + i), sum);
+        sum = L::madd(L::load(lhs.z() + i), L::load(rhs.z() + i), sum);
+        L::store(ans.data() + i, sum);
+    });
+}
+
+void VectorBatch::fma(const VectorBatch::Scalars &factors, const VectorBatch &lhs, const VectorBatch &rhs, VectorBatch &ans) {
+    checkSizes(lhs.size(), rhs.size());
+    checkSizes(lhs.size(), factors.size());
+    ans.resize(lhs.size());
+    apply(lhs.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        const auto factor = L::load(factors.data() + i);
+        L::store(ans.x() + i, L::madd(factor, L::load(lhs.x() + i), L::load(rhs.x() + i)));
+        L::store(ans.y() + i, L::madd(factor, L::load(lhs.y() + i), L::load(rhs.y() + i)));
+        L::store(ans.z() + i, L::madd(factor, L::load(lhs.z() + i), L::load(rhs.z() + i)));
+    });
+}
+
+const char *VectorBatch::instructionSet() {
+    return Simd::name;
+}
+
+void VectorBatch::length(const VectorBatch &batch, VectorBatch::Scalars &ans) {
+    dot(batch, batch, ans);
+    apply(batch.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        L::store(ans.data() + i, L::sqrt(L::load(ans.data() + i)));
+    });
+}
+
+void VectorBatch::stretch(const VectorBatch &initial, const VectorBatch &deformation, VectorBatch::Scalars &ans) {
+    checkSizes(initial.size(), deformation.size());
+    ans.resize(initial.size());
+    apply(initial.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        const auto x0 = L::load(initial.x() + i);
+        const auto y0 = L::load(initial.y() + i);
+        const auto z0 = L::load(initial.z() + i);
+        const auto x = L::add(x0, L::load(deformation.x() + i));
+        const auto y = L::add(y0, L::load(deformation.y() + i));
+        const auto z = L::add(z0, L::load(deformation.z() + i));
+        const auto initialLength = L::sqrt(L::madd(z0, z0, L::madd(y0, y0, L::mul(x0, x0))));
+        const auto currentLength = L::sqrt(L::madd(z, z, L::madd(y, y, L::mul(x, x))));
+        L::store(ans.data() + i, L::div(L::sub(currentLength, initialLength), initialLength));
+    });
+}
+
+void VectorBatch::stretch(const VectorBatch::Scalars &initialLengths, const VectorBatch::Scalars &currentLengths, VectorBatch::Scalars &ans) {
+    checkSizes(initialLengths.size(), currentLengths.size());
+    ans.resize(initialLengths.size());
+    apply(initialLengths.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        const auto initialLength = L::load(initialLengths.data() + i);
+        L::store(ans.data() + i, L::div(L::sub(L::load(currentLengths.data() + i), initialLength), initialLength));
+    });
+}
+
+void VectorBatch::sub(const VectorBatch &lhs, const VectorBatch &rhs, VectorBatch &ans) {
+    checkSizes(lhs.size(), rhs.size());
+    ans.resize(lhs.size());
+    apply(lhs.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        L::store(ans.x() + i, L::sub(L::load(lhs.x() + i), L::load(rhs.x() + i)));
+        L::store(ans.y() + i, L::sub(L::load(lhs.y() + i), L::load(rhs.y() + i)));
+        L::store(ans.z() + i, L::sub(L::load(lhs.z() + i), L::load(rhs.z() + i)));
+    });
+}
+
+void VectorBatch::unit(const VectorBatch &batch, VectorBatch &ans) {
+    ans.resize(batch.size());
+    auto shortest = batch.size() ? 1. : 0.;
+    apply(batch.size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        const auto x = L::load(batch.x() + i);
+        const auto y = L::load(batch.y() + i);
+        const auto z = L::load(batch.z() + i);
+        const auto length = L::sqrt(L::madd(z, z, L::madd(y, y, L::mul(x, x))));
+        shortest = std::min(shortest, L::min(length));
+        L::store(ans.x() + i, L::div(x, length));
+        L::store(ans.y() + i, L::div(y, length));
+        L::store(ans.z() + i, L::div(z, length));
+    });
+    if (batch.size() && !(shortest > 0))
+        throw std::runtime_error("Vector of length " + std::to_string(shortest) + " cannot be normalized.");
+}
+
+Vector<3> VectorBatch::at(const size_t index) const {
+    return Vector<3>{p_x.at(index), p_y.at(index), p_z.at(index)};
+}
+
+size_t VectorBatch::size() const {
+    return p_x.size();
+}
+
+Vector<3> VectorBatch::weightedSum(const VectorBatch::Scalars &weights) const {
+    checkSizes(size(), weights.size());
+    auto sx = Simd::set(0), sy = Simd::set(0), sz = Simd::set(0);
+    auto tx = 0., ty = 0., tz = 0.;
+    apply(size(), [&](const auto lane, const size_t i) {
+        using L = decltype(lane);
+        const auto weight = L::load(weights.data() + i);
+        if constexpr (L::width > 1) {
+            sx = L::madd(weight, L::load(x() + i), sx);
+            sy = L::madd(weight, L::load(y() + i), sy);
+            sz = L::madd(weight, L::load(z() + i), sz);
+        } else {
+            tx += weight * p_x[i];
+            ty += weight * p_y[i];
+            tz += weight * p_z[i];
+        }
+    });
+    return Vector<3>{Simd::sum(sx) + tx, Simd::sum(sy) + ty, Simd::sum(sz) + tz};
+}
+
+const VectorBatch::Component *VectorBatch::x() const {
+    return p_x.data();
+}
+
+const VectorBatch::Component *VectorBatch::y() const {
+    return p_y.data();
+}
+
+const VectorBatch::Component *VectorBatch::z() const {
+    return p_z.data();
+}
+
+void VectorBatch::append(const Vector<3> &vector) {
+    p_x.emplace_back(vector[0]);
+    p_y.emplace_back(vector[1]);
+    p_z.emplace_back(vector[2]);
+}
+
+void VectorBatch::assign(const VectorBatch &batch, const size_t begin, const size_t end) {
+    if (begin > end || end > batch.size())
+        throw std::out_of_range("The range is not inside the vector batch.");
+    p_x.assign(batch.p_x.begin() + begin, batch.p_x.begin() + end);
+    p_y.assign(batch.p_y.begin() + begin, batch.p_y.begin() + end);
+    p_z.assign(batch.p_z.begin() + begin, batch.p_z.begin() + end);
+}
+
+void VectorBatch::clear() {
+    p_x.clear();
+    p_y.clear();
+    p_z.clear();
+}
+
+void VectorBatch::reserve(const size_t size) {
+    p_x.reserve(size);
+    p_y.reserve(size);
+    p_z.reserve(size);
+}
+
+void VectorBatch::resize(const size_t size) {
+    p_x.resize(size, 0);
+    p_y.resize(size, 0);
+    p_z.resize(size, 0);
+}
+
+void VectorBatch::set(const size_t index, const Vector<3> &vector) {
+    p_x.at(index) = vector[0];
+    p_y.at(index) = vector[1];
+    p_z.at(index) = vector[2];
+}
+
+VectorBatch::Component *VectorBatch::x() {
+    return p_x.data();
+}
+
+VectorBatch::Component *VectorBatch::y() {
+    return p_y.data();
+}
+
+VectorBatch::Component *VectorBatch::z() {
+    return p_z.data();
+}
+
+} // namespace rbs::space
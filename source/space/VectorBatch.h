@@ -0,0 +1,183 @@
+//
+//  VectorBatch.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 21.01.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef VECTORBATCH_H
+#define VECTORBATCH_H
+
+#include "Vector.h"
+#include <vector>
+
+/**
+ * The space namespace provides the means to handle matters related to the mathematical space.
+ */
+namespace rbs::space {
+
+/**
+ * @brief The VectorBatch stores a list of 3D vectors in separate x, y and z lanes (i.e., structure of arrays).
+ * @details The Vector is convenient for one vector at a time; however, the bond loops apply the same operation to
+ *          thousands of vectors. The VectorBatch provides those operations on the whole batch, where the lanes are
+ *          processed with AVX (4 vectors per instruction), SSE2 (2 vectors per instruction) or plain scalar code,
+ *          depending on the instruction sets enabled at compile time (see instructionSet()).
+ * @note The portable builds of x86-64 use SSE2; the AVX lanes need the AVX instruction set enabled (e.g., the
+ *          CONFIG+=native option of the qmake projects).
+ * @note The operations write into the given result, resizing it to the batch size; the result may be one of the inputs.
+ * @note The lanes of all the inputs of an operation must have the same size.
+ */
+class VectorBatch
+{
+public:
+    using Component = double;
+    using Components = std::vector<Component>;
+    using Scalars = std::vector<double>;
+
+    /**
+     * @brief The constructor.
+     * @param size The number of vectors (the components are zero).
+     */
+    explicit VectorBatch(const size_t size = 0);
+
+    /**
+     * @brief Computes the element-wise sum of two batches.
+     */
+    static void add(const VectorBatch& lhs, const VectorBatch& rhs, VectorBatch& ans);
+
+    /**
+     * @brief Computes the element-wise dot product of two batches.
+     */
+    static void dot(const VectorBatch& lhs, const VectorBatch& rhs, Scalars& ans);
+
+    /**
+     * @brief Computes the element-wise fused multiply-add (i.e., ans[i] = factors[i] * lhs[i] + rhs[i]).
+     */
+    static void fma(const Scalars& factors, const VectorBatch& lhs, const VectorBatch& rhs, VectorBatch& ans);
+
+    /**
+     * @brief Gives the name of the instruction set used by the operations (i.e., "AVX", "SSE2" or "scalar").
+     */
+    static const char* instructionSet();
+
+    /**
+     * @brief Computes the length of the vectors of a batch.
+     */
+    static void length(const VectorBatch& batch, Scalars& ans);
+
+    /**
+     * @brief Computes the bond stretches (i.e., (|initial + deformation| - |initial|) / |initial|).
+     * @param initial The initial bond vectors.
+     * @param deformation The deformation of the bonds.
+     * @param ans The stretches.
+     */
+    static void stretch(const VectorBatch& initial, const VectorBatch& deformation, Scalars& ans);
+
+    /**
+     * @brief Computes the bond stretches from the bond lengths (i.e., (current - initial) / initial).
+     * @param initialLengths The initial bond lengths.
+     * @param currentLengths The current bond lengths.
+     * @param ans The stretches.
+     */
+    static void stretch(const Scalars& initialLengths, const Scalars& currentLengths, Scalars& ans);
+
+    /**
+     * @brief Computes the element-wise subtraction of two batches.
+     */
+    static void sub(const VectorBatch& lhs, const VectorBatch& rhs, VectorBatch& ans);
+
+    /**
+     * @brief Computes the unit vectors of a batch.
+     * @throws If any of the vectors has zero length.
+     */
+    static void unit(const VectorBatch& batch, VectorBatch& ans);
+
+    /**
+     * @brief Gives a vector of the batch.
+     */
+    Vector<3> at(const size_t index) const;
+
+    /**
+     * @brief Gives the number of vectors.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Computes the weighted sum of the vectors (i.e., sum of weights[i] * vector[i]).
+     */
+    Vector<3> weightedSum(const Scalars& weights) const;
+
+    /**
+     * @brief Gives the x lane.
+     */
+    const Component* x() const;
+
+    /**
+     * @brief Gives the y lane.
+     */
+    const Component* y() const;
+
+    /**
+     * @brief Gives the z lane.
+     */
+    const Component* z() const;
+
+    /**
+     * @brief Appends a vector to the batch.
+     */
+    void append(const Vector<3>& vector);
+
+    /**
+     * @brief Replaces the vectors with a range of another batch.
+     * @param batch The source batch.
+     * @param begin The index of the first vector of the range.
+     * @param end The index after the last vector of the range.
+     * @throws If the range is not inside the source batch.
+     */
+    void assign(const VectorBatch& batch, const size_t begin, const size_t end);
+
+    /**
+     * @brief Removes all the vectors.
+     */
+    void clear();
+
+    /**
+     * @brief Reserves the memory for a number of vectors.
+     */
+    void reserve(const size_t size);
+
+    /**
+     * @brief Resizes the batch; the new vectors will be zero.
+     */
+    void resize(const size_t size);
+
+    /**
+     * @brief Sets a vector of the batch.
+     */
+    void set(const size_t index, const Vector<3>& vector);
+
+    /**
+     * @brief Gives direct access to the x lane.
+     */
+    Component* x();
+
+    /**
+     * @brief Gives direct access to the y lane.
+     */
+    Component* y();
+
+    /**
+     * @brief Gives direct access to the z lane.
+     */
+    Component* z();
+
+private:
+    Components p_x; // The x components.
+    Components p_y; // The y components.
+    Components p_z; // The z components.
+};
+
+} // namespace rbs::space
+
+#endif // VECTORBATCH_H
@@ -15,21 +15,6 @@
 
 namespace rbs::space {
 
-template<unsigned char SpaceDimension>
-Vector<SpaceDimension>::Vector() : Space() {}
-
-template<unsigned char SpaceDimension>
-Vector<SpaceDimension>::Vector(const Vector &other) : Space(other) {}
-
-template<unsigned char SpaceDimension>
-Vector<SpaceDimension>::Vector(Vector &&other) : Space(other) {}
-
-template<unsigned char SpaceDimension>
-Vector<SpaceDimension> &Vector<SpaceDimension>::operator =(Vector other){
-    Space::operator =(other);
-    return *this;
-}
-
 template<unsigned char SpaceDimension>
 bool Vector<SpaceDimension>::areParallel(const Vector<SpaceDimension> &v1,
                                          const Vector<SpaceDimension> &v2) {
@@ -157,6 +142,11 @@ std::string Vector<SpaceDimension>::name() const {
     return "Vector";
 }
 
+template<unsigned char SpaceDimension>
+Vector<SpaceDimension>::operator std::string() const {
+    return Space::to_string(name());
+}
+
 template<unsigned char SpaceDimension>
 const Vector<SpaceDimension> Vector<SpaceDimension>::perpendicularUnitVectorInDirectionOF(const Vector &other) const{
     return Vector<SpaceDimension>::crossProduct(Vector<SpaceDimension>::crossProduct(*this, other), *this).unit();
@@ -164,7 +154,7 @@ const Vector<SpaceDimension> Vector<SpaceDimension>::perpendicularUnitVectorInDi
 
 template<unsigned char SpaceDimension>
 double Vector<SpaceDimension>::projectionLenghtOn(const Vector &other) const {
-    return abs(projectionValueOn(other));
+    return std::abs(projectionValueOn(other));
 }
 
 template<unsigned char SpaceDimension>
@@ -0,0 +1,83 @@
+//
+//  SimVariant.cpp
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 19.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#include "SimVariant.h"
+
+namespace rbs::variables {
+
+bool SimVariant::hasValue() const {
+    return p_type != Type::None;
+}
+
+bool SimVariant::isEmpty() const {
+    return p_type == Type::None;
+}
+
+SimVariant::Type SimVariant::type() const {
+    return p_type;
+}
+
+void SimVariant::clear() {
+    p_type = Type::None;
+}
+
+bool SimVariant::operator==(const SimVariant &other) const {
+    if( p_type == other.p_type ) {
+        switch (p_type) {
+        case Type::None:        return true;
+        case Type::Bool:        return p_value.boolean  == other.p_value.boolean;
+        case Type::Int:         return p_value.integer  == other.p_value.integer;
+        case Type::Double:      return p_value.real     == other.p_value.real;
+        case Type::Vector3D:    return p_value.vector   == other.p_value.vector;
+        default: throw std::out_of_range("The type of the SimVariant is not recognized.");
+        }
+    }
+    return false;
+}
+
+bool SimVariant::operator!=(const SimVariant &other) const {
+    return !operator==(other);
+}
+
+SimVariant::operator std::string() const {
+    std::string ans =  "SimVariant:{";
+    if(isEmpty()) {
+        ans = ans + "empty";
+    } else {
+        ans = ans + "type: " + type_to_string() + ", value: " + value_to_string();
+    }
+    return ans + "}";
+}
+
+std::string SimVariant::value_to_string() const {
+    switch (p_type) {
+    case Type::None:        return "uninitialized";
+    case Type::Bool:        return std::to_string(p_value.boolean);
+    case Type::Int:         return std::to_string(p_value.integer);
+    case Type::Double:      return std::to_string(p_value.real);
+    case Type::Vector3D:    return std::string(p_value.vector);
+    default: throw std::out_of_range("The type of the SimVariant is not recognized.");
+    }
+}
+
+std::string SimVariant::type_to_string() const {
+    switch (p_type) {
+    case Type::None:        return "none";
+    case Type::Bool:        return "bool";
+    case Type::Int:         return "int";
+    case Type::Double:      return "double";
+    case Type::Vector3D:    return "space::Vector<3>";
+    default: throw std::out_of_range("The type of the SimVariant is not recognized.");
+    }
+}
+
+std::ostream &operator <<(std::ostream &out, const SimVariant &variant) {
+    return out << std::string(variant);
+}
+
+} // namespace rbs::variables
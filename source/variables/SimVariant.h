@@ -0,0 +1,246 @@
+//
+//  SimVariant.h
+//  Relation-Based Simulator (RBS)
+//
+//  Created by Ali Jenabidehkordi on 19.08.18.
+//  Copyright © 2018 Ali Jenabidehkordi. All rights reserved.
+//
+
+#ifndef SIMVARIANT_H
+#define SIMVARIANT_H
+
+#include "../space/Vector.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+/**
+ * The variables namespace introduces a new form of variables specific to RBS.
+ */
+namespace rbs::variables {
+
+/**
+ * @brief The SimVariant is the compact, trivially copyable variant of the simulation values.
+ * @details Unlike the Variant, the SimVariant is limited to the types that the simulation properties and statuses need,
+ *          i.e., bool, integer, double and space::vec3; thus, it is a fixed size value (a type tag and three doubles) that can be
+ *          stored in contiguous arrays and copied without calling any constructor.
+ *          The integral types are stored as std::int64_t and the floating point types as double. An integer is never
+ *          narrowed silently: setting an integer that does not fit std::int64_t, or reading one into a type that cannot
+ *          hold it, throws (or gives std::nullopt in valueIf()).
+ * @note Use the Variant for the metadata (e.g., strings, points or indices).
+ */
+class SimVariant
+{
+public:
+
+    /**
+     * @brief The type of the holding value.
+     */
+    enum class Type : unsigned char {
+        None,
+        Bool,
+        Int,
+        Double,
+        Vector3D
+    };
+
+    /**
+     * @brief The default constructor.
+     * @note The SimVariant will be empty.
+     */
+    SimVariant() = default;
+
+    /**
+     * @brief The constructor.
+     * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+     * @param value The value.
+     */
+    template<typename T>
+    SimVariant(const T& value) {
+        setValue(value);
+    }
+
+    /**
+     * @brief Sets a new value.
+     * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+     */
+    template<typename T>
+    SimVariant &operator =(const T& value) {
+        setValue(value);
+        return *this;
+    }
+
+    /**
+     * @brief Gives the type the value of type T will be stored as.
+     */
+    template<typename T>
+    static constexpr Type typeOf() {
+        if constexpr (std::is_same_v<T, bool>)
+            return Type::Bool;
+        else if constexpr (std::is_integral_v<T>)
+            return Type::Int;
+        else if constexpr (std::is_floating_point_v<T>)
+            return Type::Double;
+        else {
+            static_assert(std::is_same_v<T, space::vec3>, "The SimVariant only holds bool, integral, floating point and space::vec3 values, use Variant instead.");
+            return Type::Vector3D;
+        }
+    }
+
+    /**
+     * @brief Whether the SimVariant has a value.
+     */
+    bool hasValue() const;
+
+    /**
+     * @brief Whether the SimVariant holds a value of type T.
+     */
+    template<typename T>
+    bool is() const noexcept {
+        return p_type == typeOf<T>();
+    }
+
+    /**
+     * @brief Whether the SimVariant is empty.
+     */
+    bool isEmpty() const;
+
+    /**
+     * @brief Gives the type of the holding value.
+     */
+    Type type() const;
+
+    /**
+     * @brief Gives the value.
+     * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+     * @throws If the SimVariant is empty, the value has a different type or the integer does not fit T.
+     */
+    template<typename T>
+    T value() const {
+        if (isEmpty())
+            throw std::runtime_error("The SimVariant has no value.");
+        if (!is<T>())
+            throw std::runtime_error("The set value has a different type.");
+        if (!fits<T>())
+            throw std::out_of_range("The set integer does not fit the requested type.");
+        return get<T>();
+    }
+
+    /**
+     * @brief Gives the value if it is set with the requested type.
+     * @note Unlike value(), this does not throw; thus, it is suitable for the performance critical loops.
+     * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+     * @return The value or std::nullopt if the SimVariant is empty, has a different type or the integer does not fit T.
+     */
+    template<typename T>
+    std::optional<T> valueIf() const noexcept {
+        if (is<T>() && fits<T>())
+            return get<T>();
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Clears the value (i.e., makes the SimVariant empty).
+     */
+    void clear();
+
+    /**
+     * @brief Sets a new value.
+     * @tparam T The value type (i.e., bool, any integral, any floating point or space::vec3).
+     * @throws If the value is an integer that does not fit std::int64_t.
+     */
+    template<typename T>
+    void setValue(const T& value) {
+        if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && !std::is_same_v<T, bool>
+                      && std::numeric_limits<T>::digits > std::numeric_limits<Integer>::digits) {
+            if (value > static_cast<T>(std::numeric_limits<Integer>::max()))
+                throw std::out_of_range("The integer does not fit the SimVariant.");
+        }
+        p_type = typeOf<T>();
+        if constexpr (std::is_same_v<T, bool>)
+            p_value.boolean = value;
+        else if constexpr (std::is_integral_v<T>)
+            p_value.integer = static_cast<Integer>(value);
+        else if constexpr (std::is_floating_point_v<T>)
+            p_value.real = static_cast<double>(value);
+        else
+            p_value.vector = value;
+    }
+
+    bool operator==(const SimVariant &other) const;
+    bool operator!=(const SimVariant &other) const;
+
+    /**
+     * @brief Converts the SimVariant to a string.
+     */
+    operator std::string() const;
+
+private:
+
+    /**
+     * @brief The type the integral values are stored as.
+     */
+    using Integer = std::int64_t;
+
+    /**
+     * @brief The storage of the holding value.
+     */
+    union Value {
+        bool boolean;
+        Integer integer;
+        double real;
+        space::vec3 vector;
+    };
+
+    /**
+     * @brief Gives the value without checking its type.
+     */
+    template<typename T>
+    T get() const noexcept {
+        if constexpr (std::is_same_v<T, bool>)
+            return p_value.boolean;
+        else if constexpr (std::is_integral_v<T>)
+            return static_cast<T>(p_value.integer);
+        else if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(p_value.real);
+        else
+            return p_value.vector;
+    }
+
+    /**
+     * @brief Whether the holding value can be given as T without narrowing it.
+     * @note Only the integers may not fit; the holding value must have the type of T.
+     */
+    template<typename T>
+    bool fits() const noexcept {
+        if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+            if constexpr (std::is_unsigned_v<T>) {
+                if (p_value.integer < 0)
+                    return false;
+                return static_cast<std::uint64_t>(p_value.integer) <= std::numeric_limits<T>::max();
+            } else {
+                return std::numeric_limits<T>::min() <= p_value.integer && p_value.integer <= std::numeric_limits<T>::max();
+            }
+        }
+        return true;
+    }
+
+    std::string value_to_string() const;
+
+    std::string type_to_string() const;
+
+    Type p_type = Type::None;   // The type of the value.
+    Value p_value = {false};    // The holding value.
+
+};
+
+static_assert(std::is_trivially_copyable_v<SimVariant>, "The SimVariant must stay trivially copyable.");
+
+std::ostream & operator << (std::ostream & out, const SimVariant & variant);
+
+} // namespace rbs::variables
+
+#endif // SIMVARIANT_H